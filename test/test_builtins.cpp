@@ -2136,3 +2136,50 @@ count;
   ASSERT_TRUE(comp.GetValue()->IsInt());
   EXPECT_EQ(3, comp.GetValue()->GetInt());
 }
+
+TEST(Builtin, LazyMethod) {
+  Parser parser(uR"(
+var count = 0;
+
+// The same function is returned on every read
+count += Math.max === Math.max;
+count += Math.max(1, 3, 2) == 3;
+
+// Attributes are those of a builtin method
+var desc = Object.getOwnPropertyDescriptor(Array.prototype, 'push');
+count += typeof desc.value == 'function';
+count += desc.writable && !Array.prototype.propertyIsEnumerable('push');
+count += desc.value === Array.prototype.push;
+
+// Lazy methods are listed but not enumerated
+var keys = 0;
+for (var k in Math) {
+  keys += 1;
+}
+count += keys == 0;
+var names = Object.getOwnPropertyNames(Boolean.prototype);
+var found = 0;
+for (var i = 0; i < names.length; ++i) {
+  found += names[i] == 'toString' || names[i] == 'valueOf';
+}
+count += names.length == 3 && found == 2;
+
+// A method never read can be overwritten and deleted
+Math.min = 42;
+count += Math.min == 42;
+count += delete Math.abs;
+count += Math.abs === undefined;
+
+count;
+)");
+
+  Interpreter interpreter;
+
+  auto prog = parser.ParseProgram();
+  ASSERT_TRUE(prog->IsProgram());
+
+  auto comp = interpreter.Execute(prog);
+  EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+  ASSERT_TRUE(comp.GetValue()->IsInt());
+  EXPECT_EQ(10, comp.GetValue()->GetInt());
+}
@@ -1,3 +1,5 @@
+#include <unordered_set>
+
 #include "gtest/gtest.h"
 #include "voidjs/interpreter/interpreter.h"
 #include "voidjs/types/heap_object.h"
@@ -7,6 +9,8 @@
 #include "voidjs/types/internal_types/property_map.h"
 #include "voidjs/types/internal_types/hash_map.h"
 #include "voidjs/types/lang_types/string.h"
+#include "voidjs/types/lang_types/string_builder.h"
+#include "voidjs/gc/js_handle_scope.h"
 
 using namespace voidjs;
 
@@ -88,7 +92,7 @@ TEST(InternalTypes, HashMap) {
     EXPECT_EQ(100, val->GetInt());
   }
 
-  hashmap->Erase(vm, key2);
+  hashmap = types::HashMap::Erase(vm, hashmap, key2);
   
   {
     auto val = hashmap->Find(vm, key2);
@@ -102,6 +106,52 @@ TEST(InternalTypes, HashMap) {
   }
 }
 
+TEST(InternalTypes, HashMapChurn) {
+  Interpreter interpreter;
+  auto vm = interpreter.GetVM();
+  auto factory = vm->GetObjectFactory();
+
+  auto hashmap = factory->NewHashMap(types::HashMap::MIN_CAPACITY);
+
+  std::vector<JSHandle<types::String>> keys;
+  for (std::int32_t idx = 0; idx < 1000; ++idx) {
+    keys.push_back(factory->NewString(u"key" + utils::U8StrToU16Str(std::to_string(idx))));
+  }
+
+  // Insert and erase in a sliding window, so that deleted entries keep piling up
+  for (std::int32_t idx = 0; idx < 1000; ++idx) {
+    hashmap = types::HashMap::Insert(vm, hashmap, keys[idx], JSHandle<JSValue>{vm, JSValue{idx}});
+    if (idx >= 20) {
+      hashmap = types::HashMap::Erase(vm, hashmap, keys[idx - 20]);
+    }
+  }
+
+  EXPECT_EQ(20, hashmap->GetBucketSize());
+  EXPECT_LE(hashmap->GetBucketCapacity(), 64);
+  EXPECT_EQ(20, hashmap->GetAllOwnKeys(vm).size());
+
+  for (std::int32_t idx = 0; idx < 1000; ++idx) {
+    auto val = hashmap->Find(vm, keys[idx]);
+    if (idx < 980) {
+      EXPECT_TRUE(val.IsEmpty());
+    } else {
+      ASSERT_FALSE(val.IsEmpty());
+      EXPECT_EQ(idx, val->GetInt());
+    }
+  }
+
+  // Erasing most of the entries shrinks the hashmap
+  for (std::int32_t idx = 0; idx < 500; ++idx) {
+    hashmap = types::HashMap::Insert(vm, hashmap, keys[idx], JSHandle<JSValue>{vm, JSValue{idx}});
+  }
+  auto capacity = hashmap->GetBucketCapacity();
+  for (std::int32_t idx = 0; idx < 500; ++idx) {
+    hashmap = types::HashMap::Erase(vm, hashmap, keys[idx]);
+  }
+  EXPECT_LT(hashmap->GetBucketCapacity(), capacity);
+  EXPECT_EQ(20, hashmap->GetBucketSize());
+}
+
 TEST(InternalTypes, PropertyMap) {
   Interpreter interpreter;
   auto vm = interpreter.GetVM();
@@ -126,12 +176,147 @@ TEST(InternalTypes, PropertyMap) {
   map = types::PropertyMap::SetProperty(vm, map, key3, val3);
   map = types::PropertyMap::SetProperty(vm, map, key4, val4);
 
-  auto val = map->GetProperty(vm, key4);
-  ASSERT_TRUE(val->IsHeapObject() && val->GetHeapObject()->IsDataPropertyDescriptor());
-  EXPECT_EQ(val4.GetValue()->GetInt(), val->GetHeapObject()->AsDataPropertyDescriptor()->GetValue().GetInt());
+  auto entry = map->FindProperty(key4);
+  ASSERT_NE(types::PropertyMap::NOT_FOUND, entry);
+  EXPECT_EQ(val4.GetValue()->GetInt(), map->GetPropertyValue(vm, entry).GetInt());
+  EXPECT_FALSE(types::PropertyMap::IsAccessor(map->GetPropertyAttributes(entry)));
+
+  map = types::PropertyMap::DeleteProperty(vm, map, key1);
+
+  EXPECT_EQ(types::PropertyMap::NOT_FOUND, map->FindProperty(key1));
+  EXPECT_FALSE(map->HasProperty(vm, key1));
+}
+
+TEST(InternalTypes, PropertyMapAttributes) {
+  Interpreter interpreter;
+  auto vm = interpreter.GetVM();
+  auto factory = vm->GetObjectFactory();
+  
+  auto map = factory->NewPropertyMap();
+
+  auto key1 = factory->NewString(u"data");
+  auto val1 = types::PropertyDescriptor{vm, JSHandle<JSValue>{vm, JSValue{42}}, false, true, false};
+
+  auto key2 = factory->NewString(u"accessor");
+  auto getter = factory->NewInternalFunction(nullptr).As<JSValue>();
+  auto val2 = types::PropertyDescriptor{vm, getter, JSHandle<JSValue>{vm, JSValue::Undefined()}, false, true};
+
+  map = types::PropertyMap::SetProperty(vm, map, key1, val1);
+  map = types::PropertyMap::SetProperty(vm, map, key2, val2);
+
+  {
+    auto entry = map->FindProperty(key1);
+    ASSERT_NE(types::PropertyMap::NOT_FOUND, entry);
+    auto attributes = map->GetPropertyAttributes(entry);
+    EXPECT_EQ(42, map->GetPropertyValue(vm, entry).GetInt());
+    EXPECT_FALSE(types::PropertyMap::IsAccessor(attributes));
+    EXPECT_FALSE(types::PropertyMap::IsWritable(attributes));
+    EXPECT_TRUE(types::PropertyMap::IsEnumerable(attributes));
+    EXPECT_FALSE(types::PropertyMap::IsConfigurable(attributes));
+  }
+
+  {
+    auto entry = map->FindProperty(key2);
+    ASSERT_NE(types::PropertyMap::NOT_FOUND, entry);
+    auto attributes = map->GetPropertyAttributes(entry);
+    ASSERT_TRUE(types::PropertyMap::IsAccessor(attributes));
+    EXPECT_FALSE(types::PropertyMap::IsEnumerable(attributes));
+    EXPECT_TRUE(types::PropertyMap::IsConfigurable(attributes));
+    auto accessor = map->GetPropertyValue(vm, entry).GetHeapObject()->AsAccessorPropertyDescriptor();
+    EXPECT_EQ(getter.GetJSValue(), accessor->GetGetter());
+    EXPECT_TRUE(accessor->GetSetter().IsUndefined());
+  }
+
+  auto keys = map->GetAllOwnEnumerableKeys(vm);
+  ASSERT_EQ(1, keys.size());
+  EXPECT_TRUE(keys[0].As<types::String>()->Equal(key1));
+}
+
+TEST(InternalTypes, StringBuilder) {
+  Interpreter interpreter;
+  auto vm = interpreter.GetVM();
+  auto factory = vm->GetObjectFactory();
+
+  {
+    types::StringBuilder builder{vm};
+    EXPECT_TRUE(builder.Build()->IsEmptyString());
+  }
+
+  {
+    auto str = factory->NewString(u"abc");
+    types::StringBuilder builder{vm, 7};
+    builder.Append(str);
+    builder.Append(u'-');
+    builder.Append(str);
+    EXPECT_EQ(7, builder.GetLength());
+    EXPECT_EQ(u"abc-abc", builder.Build()->GetString());
+  }
+
+  {
+    std::u16string expect;
+    types::StringBuilder builder{vm};
+    for (std::int32_t idx = 0; idx < 1000; ++idx) {
+      auto str = factory->NewStringFromInt(idx);
+      builder.Append(str);
+      expect += str->GetString();
+    }
+    EXPECT_EQ(expect.size(), builder.GetLength());
+    EXPECT_EQ(expect, builder.Build()->GetString());
+  }
+
+  // Growing the buffer collects the normal space, which moves the appended string
+  {
+    JSHandleScope handle_scope{vm};
+    std::u16string expect(100, u'x');
+    auto str = factory->NewString(expect);
+    types::StringBuilder builder{vm};
 
-  map->DeleteProperty(vm, key1);
+    const auto& space = factory->GetHeap()->GetNormalSpace();
+    {
+      JSHandleScope filler_scope{vm};
+      std::size_t free = space.GetStart() + Heap::NORMAL_SPACE_SIZE / 2 - space.GetTop();
+      factory->NewRawString((free - types::String::DATA_OFFSET - 64) / sizeof(char16_t));
+    }
+
+    auto epoch = space.GetEpoch();
+    auto addr = str.GetJSValue().GetRawData();
+    builder.Append(str);
+    EXPECT_NE(epoch, space.GetEpoch());
+    EXPECT_NE(addr, str.GetJSValue().GetRawData());
+    EXPECT_EQ(expect, builder.Build()->GetString());
+  }
+}
+
+TEST(InternalTypes, HandleScopeBlocks) {
+  Interpreter interpreter;
+  auto vm = interpreter.GetVM();
+  JSHandleScope handle_scope{vm};
 
-  auto emp_val = map->GetProperty(vm, key1);
-  EXPECT_TRUE(emp_val.IsEmpty());
+  // Enough handles to fill several blocks of the handle scope
+  constexpr std::int32_t num = 25 * 1024;
+  std::vector<JSHandle<JSValue>> handles;
+  for (std::int32_t idx = 0; idx < num; ++idx) {
+    handles.emplace_back(vm, JSValue{idx});
+  }
+
+  // Blocks left by a closed scope are used again by the next one
+  for (std::int32_t round = 0; round < 2; ++round) {
+    JSHandleScope inner_scope{vm};
+    for (std::int32_t idx = 0; idx < num; ++idx) {
+      JSHandle<JSValue>{vm, JSValue{-idx}};
+    }
+  }
+
+  for (std::int32_t idx = 0; idx < num; ++idx) {
+    EXPECT_EQ(idx, handles[idx].GetJSValue().GetInt());
+  }
+
+  // Every live handle is a root, including those in the current block
+  std::unordered_set<std::uintptr_t> roots;
+  for (auto root : vm->GetRoots()) {
+    roots.insert(root.GetAddress());
+  }
+  for (auto handle : handles) {
+    EXPECT_TRUE(roots.count(handle.GetAddress()));
+  }
 }
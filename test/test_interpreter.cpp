@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
 
 #include "voidjs/parser/parser.h"
 #include "voidjs/types/heap_object.h"
@@ -12,7 +14,10 @@
 #include "voidjs/types/internal_types/property_map.h"
 #include "voidjs/builtins/js_object.h"
 #include "voidjs/builtins/js_array.h"
+#include "voidjs/gc/js_handle_scope.h"
 #include "voidjs/interpreter/interpreter.h"
+#include "voidjs/interpreter/snapshot.h"
+#include "voidjs/parser/streaming_parser.h"
 #include "voidjs/utils/helper.h"
 
 using namespace voidjs;
@@ -577,6 +582,38 @@ try {
   }
 }
 
+TEST(Interpreter, EvalLazyFunction) {
+  Parser parser(uR"(
+function add(a, b) {
+  function twice(x) { return x + x; }
+  return twice(a) + b;
+}
+
+function broken() {
+  var = 1;
+}
+
+var result = add(1, 2) + add(3, 4);
+try {
+  broken();
+} catch (e) {
+  result += e.message.length > 0 ? 100 : 0;
+}
+result;
+)", true);
+
+  Interpreter interpreter;
+
+  auto prog = parser.ParseProgram();
+  ASSERT_TRUE(prog->IsProgram());
+
+  // broken is only rejected once it is called
+  auto comp = interpreter.Execute(prog);
+  EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+  ASSERT_TRUE(comp.GetValue()->IsInt());
+  EXPECT_EQ(114, comp.GetValue()->GetInt());
+}
+
 TEST(Interpreter, EvalDebuggerStatement) {
    Parser parser(uR"(
 debugger ;
@@ -628,6 +665,75 @@ obj[1] + obj['value'] + obj.name;
   EXPECT_EQ(83, comp.GetValue()->GetInt());
 }
 
+TEST(Interpreter, PutInheritedProperty) {
+  {
+    Parser parser(uR"(
+var proto = {};
+Object.defineProperty(proto, 'value', {
+  value: 42,
+  writable: false,
+});
+var obj = Object.create(proto);
+obj.value = 43;
+obj.value + (obj.hasOwnProperty('value') ? 100 : 0);
+)");
+
+    Interpreter interpreter;
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(42, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+var stored = 0;
+var proto = {};
+Object.defineProperty(proto, 'value', {
+  get: function () { return stored; },
+  set: function (v) { stored = v * 2; },
+});
+var obj = Object.create(proto);
+obj.value = 21;
+obj.value + (obj.hasOwnProperty('value') ? 100 : 0);
+)");
+
+    Interpreter interpreter;
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(42, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+var arr = [1, 2, 3];
+arr[1] = 5;
+arr[5] = 6;
+arr.length = 2;
+arr.length * 10 + arr[1];
+)");
+
+    Interpreter interpreter;
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(25, comp.GetValue()->GetInt());
+  }
+}
+
 TEST(Interpreter, EvalNewExpression) {
   {
     Parser parser(uR"(
@@ -1287,3 +1393,2016 @@ TEST(Interpreter, EvalArrayLiteral) {
     }
   }
 }
+
+TEST(Interpreter, Snapshot) {
+  Parser parser(uR"(
+var arr = [3, 1, 2];
+arr.sort();
+var caught = 0;
+try {
+  null.x;
+} catch (e) {
+  caught = e.message.length > 0 ? 1 : 0;
+}
+arr.join('-') + ':' + Math.max(4, 9) + ':' + new Error('bad').message + ':' + caught + ':' + String(true).length;
+)");
+
+  auto prog = parser.ParseProgram();
+  ASSERT_TRUE(prog->IsProgram());
+
+  auto snapshot = Snapshot::Create();
+
+  // Each Interpreter restored from the same snapshot gets its own copy of the builtins
+  for (int i = 0; i < 2; ++i) {
+    Interpreter interpreter{snapshot};
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"1-2-3:9:bad:1:4", comp.GetValue()->GetString());
+  }
+
+  auto path = (std::filesystem::temp_directory_path() / "voidjs_test_snapshot").string();
+  std::filesystem::remove(path);
+  EXPECT_EQ(nullptr, Snapshot::Load(path));
+  if (!snapshot.Store(path)) {
+    GTEST_SKIP() << "Snapshots are only stored for binaries with a build id";
+  }
+
+  auto loaded = Snapshot::Load(path);
+  ASSERT_TRUE(loaded);
+  EXPECT_EQ(snapshot.GetData(), loaded->GetData());
+  {
+    Interpreter interpreter{*loaded};
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto comp = interpreter.Execute(prog);
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"1-2-3:9:bad:1:4", comp.GetValue()->GetString());
+  }
+
+  // A corrupted snapshot is rejected
+  {
+    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(snapshot.GetData().size() / 2);
+    file.put(~snapshot.GetData()[snapshot.GetData().size() / 2]);
+  }
+  EXPECT_EQ(nullptr, Snapshot::Load(path));
+
+  std::filesystem::remove(path);
+}
+
+TEST(Interpreter, ExecuteStreaming) {
+  StreamingParser parser(uR"(
+var log = typeof later + ':' + typeof v + ':' + f(2);
+var a = 1
+var b = function () { return a + 1; }, c = 3
+log += ':' + b() + ':' + c;
+for (var i = 0; i < 3; ++i) { var inner = i; }
+log += ':' + inner + ':' + g();
+function f(x) { return x * 10; }
+var later = 5;
+function g() { return h(); }
+function h() { return 'h'; }
+'\x3A' + log;
+)", 1);
+
+  ASSERT_TRUE(parser.ScanDeclarations());
+
+  Interpreter interpreter;
+  JSHandleScope handle_scope{interpreter.GetVM()};
+
+  // Functions created by a released chunk still run,
+  // and a literal read ahead of a chunk survives the release of the previous chunk
+  auto comp = interpreter.ExecuteStreaming(&parser);
+  EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+  ASSERT_TRUE(comp.GetValue()->IsString());
+  EXPECT_EQ(u":undefined:undefined:20:2:3:2:h", comp.GetValue()->GetString());
+}
+
+TEST(Interpreter, ExecutionContextStack) {
+  {
+    Parser parser(uR"(
+function f(n) {
+  outer: for (var i = 0; i < 2; ++i) {
+    if (n === 0) {
+      var objs = [];
+      for (var j = 0; j < 2000; ++j) {
+        objs.push({ j: j });
+      }
+      break outer;
+    }
+    return f(n - 1) + 1;
+  }
+  return 0;
+}
+f(600);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    // The contexts span several blocks of the frame stack and are all exited
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(600, comp.GetValue()->GetInt());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+
+  {
+    Parser parser(uR"(
+function g(n) {
+  if (n === 0) {
+    throw new Error('deep');
+  }
+  return g(n - 1);
+}
+try {
+  g(300);
+} catch (e) {
+  e.message;
+}
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    // The contexts left by an exception are exited as well
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"deep", comp.GetValue()->GetString());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+}
+
+TEST(Interpreter, FrameSlots) {
+  {
+    Parser parser(uR"(
+function dup(a, a) { return a; }
+dup(1, 2);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(2, comp.GetValue()->GetInt());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+
+  {
+    Parser parser(uR"(
+function dup(a, a) { return a; }
+dup(1);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    EXPECT_TRUE(comp.GetValue()->IsUndefined());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+
+  {
+    Parser parser(uR"(
+function caught(e) { try { throw new Error(e + 1); } catch (e) { var x = e.message; } return e + ':' + x; }
+caught(1);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"1:2", comp.GetValue()->GetString());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+
+  {
+    Parser parser(uR"(
+function keys(o) { var s = ''; for (var k in o) { s += k; } return s; }
+keys({ p: 1, q: 2 });
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"pq", comp.GetValue()->GetString());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+
+  {
+    Parser parser(uR"(
+function ops(a) { 'use strict'; a += 1; a++; return typeof a + ':' + typeof b + ':' + a; }
+ops(1);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"number:undefined:3", comp.GetValue()->GetString());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+
+  {
+    Parser parser(uR"(
+function undeletable(a) { return delete a; }
+undeletable(1);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(false, comp.GetValue()->GetBoolean());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+
+  {
+    Parser parser(uR"(
+function self(f) { return f(); }
+self(function () { return this === undefined ? 'strict' : typeof this; });
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"object", comp.GetValue()->GetString());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+
+  {
+    Parser parser(uR"(
+function count(n) { var s = 0; for (var i = 0; i < n; ++i) { var o = { v: [i] }; s += o.v[0]; } return s; }
+count(2000);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(1999000, comp.GetValue()->GetInt());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+
+  {
+    Parser parser(uR"(
+function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+fib(15);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(610, comp.GetValue()->GetInt());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+
+  {
+    Parser parser(uR"(
+var g = 'global';
+function global() { var l = 'local'; return g; }
+global();
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"global", comp.GetValue()->GetString());
+    EXPECT_EQ(0, interpreter.GetVM()->GetExecutionContextNum());
+  }
+}
+
+TEST(Interpreter, ArgumentsObject) {
+  {
+    Parser parser(uR"(
+function mapped(a, b) { arguments[0] = 10; b = 20; return a + ':' + arguments[1] + ':' + arguments.length; }
+mapped(1, 2, 3);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"10:20:3", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function unmapped(a) { 'use strict'; arguments[0] = 10; return a + ':' + arguments[0]; }
+unmapped(1);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"1:10", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function unused(a, b) { return a + b; }
+unused(1, 2);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(3, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function shadowed(arguments) { return arguments; }
+shadowed(4);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(4, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function declared(a) { var arguments; return typeof arguments + ':' + arguments[0]; }
+declared(5);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"object:5", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function inner(a) { return (function () { return arguments.length; })(); }
+inner(6);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(0, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function deleted(a) { delete arguments[0]; arguments[0] = 8; return a + ':' + arguments[0]; }
+deleted(7);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"7:8", comp.GetValue()->GetString());
+  }
+}
+
+TEST(Interpreter, CallKind) {
+  {
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+    auto vm = interpreter.GetVM();
+
+    EXPECT_EQ(CallKind::OBJECT_CONSTRUCTOR, vm->GetObjectConstructor()->GetCallKind());
+    EXPECT_EQ(CallKind::ERROR_CONSTRUCTOR, vm->GetErrorConstructor()->GetCallKind());
+    EXPECT_EQ(CallKind::NONE, vm->GetObjectPrototype()->GetCallKind());
+  }
+
+  {
+    Parser parser(uR"(
+Object(1) instanceof Number;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+typeof new Object();
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"object", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+String(12) + Number('3');
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"123", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+new String('ab').length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(2, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+Array(3).length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(3, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+new Array(1, 2).length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(2, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+Boolean(0);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(false, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+typeof new Boolean(0);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"object", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+new Error('e').message;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"e", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+Function('return 4')();
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(4, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+new Function('a', 'return a')(5);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(5, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function F(x) { this.x = x; }
+new F(1).x;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(1, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function F(x) { this.x = x; }
+new F(1) instanceof F;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+function G() { return [1]; }
+new G()[0];
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(1, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+Math.max(1, 6);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(6, comp.GetValue()->GetInt());
+  }
+}
+
+TEST(Interpreter, InternalMethodDispatch) {
+  {
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+    auto vm = interpreter.GetVM();
+
+    EXPECT_TRUE(vm->GetObjectPrototype()->IsOrdinary());
+    EXPECT_FALSE(vm->GetArrayConstructor()->IsOrdinary());
+    EXPECT_FALSE(vm->GetArrayPrototype()->IsOrdinary());
+  }
+
+  {
+    Parser parser(uR"(
+function mapped(a) { arguments[0] = 2; var d = delete arguments[0]; arguments[0] = 3; return a + ':' + d; }
+mapped(1);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"2:true", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function unmapped(a) { 'use strict'; arguments[0] = 2; return a + ':' + arguments.length; }
+unmapped(1);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"1:1", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+new String('xy')[1];
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"y", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+new String('xy').length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(2, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+var arr = [1, 2, 3];
+arr.length = 1;
+arr[4] = 5;
+arr.length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(5, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+var o = { length: 1 };
+o[3] = 1;
+o.length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(1, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+typeof Object.prototype;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"object", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function f() {}
+'prototype' in f;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+}
+
+TEST(Interpreter, CallSiteCache) {
+  {
+    Parser parser(uR"(
+function add(a, b) { return a + b; }
+var s = 0;
+for (var i = 0; i < 100; ++i) { s = add(s, i); }
+s;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(4950, comp.GetValue()->GetInt());
+
+    const auto& stats = interpreter.GetCallSiteStats();
+    EXPECT_LE(99u, stats.hits);
+    EXPECT_EQ(0u, stats.megamorphic_sites);
+  }
+
+  {
+    Parser parser(uR"(
+var fs = [];
+for (var k = 0; k < 8; ++k) { fs[k] = new Function('return ' + k); }
+var t = 0;
+for (var k = 0; k < 8; ++k) { t += fs[k](); }
+t;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(28, comp.GetValue()->GetInt());
+
+    const auto& stats = interpreter.GetCallSiteStats();
+    EXPECT_EQ(1u, stats.megamorphic_sites);
+  }
+
+  {
+    Parser parser(uR"(
+function mk() { return function (x) { return x * 2; }; }
+var u = 0;
+for (var k = 0; k < 10; ++k) { u += mk()(k); }
+u;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(90, comp.GetValue()->GetInt());
+
+    const auto& stats = interpreter.GetCallSiteStats();
+    EXPECT_LE(9u, stats.hits);
+    EXPECT_EQ(0u, stats.megamorphic_sites);
+  }
+
+  {
+    Parser parser(uR"(
+function st() { 'use strict'; return this; }
+function ns() { return typeof this; }
+var r;
+for (var k = 0; k < 2; ++k) { r = typeof st() + ':' + ns(); }
+r;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"undefined:object", comp.GetValue()->GetString());
+
+    const auto& stats = interpreter.GetCallSiteStats();
+    EXPECT_LE(2u, stats.hits);
+    EXPECT_EQ(0u, stats.megamorphic_sites);
+  }
+}
+
+TEST(Interpreter, BindingPlan) {
+  {
+    Parser parser(uR"(
+function dup(a, a) { return function () { return a; }; }
+dup(1)();
+dup(1)();
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    EXPECT_TRUE(comp.GetValue()->IsUndefined());
+  }
+
+  {
+    Parser parser(uR"(
+function dup(a, a) { return function () { return a; }; }
+dup(1, 2)();
+dup(1, 2)();
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(2, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function shadow(a, b) { var a, c = typeof b; function b() {} return function () { return a + ':' + c; }; }
+shadow(1, 2)();
+shadow(1, 2)();
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"1:function", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function args(a) { a = 2; return function () { return arguments; }() + arguments[0]; }
+args(1);
+args(1);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"[object Arguments]2", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function strict(a) { 'use strict'; a = 3; return function () { return a; }() + arguments[0]; }
+strict(1);
+strict(1);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(4, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function own(x) { var arguments = x; return function () { return x; }() + arguments; }
+own(5);
+own(5);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(10, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function many(a, b, c, d, e, f, g, h, i, j) { var k = a + j; return function () { return k; }(); }
+many(1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+many(1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(11, comp.GetValue()->GetInt());
+  }
+}
+
+TEST(Interpreter, LazyPrototype) {
+  {
+    Parser parser(uR"(
+function F() { this.x = 1; }
+Object.getOwnPropertyNames(F).join(' ');
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"length prototype", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function F() { this.x = 1; }
+Object.getOwnPropertyDescriptor(F, 'prototype').writable;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+function F() { this.x = 1; }
+Object.getOwnPropertyDescriptor(F, 'prototype').enumerable;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(false, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+function F() { this.x = 1; }
+Object.getOwnPropertyDescriptor(F, 'prototype').configurable;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(false, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+function F() { this.x = 1; }
+var n = 0;
+for (var k in F) ++n;
+n;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(0, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function F() { this.x = 1; }
+Object.getPrototypeOf(new F()) === F.prototype;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+function F() { this.x = 1; }
+F.prototype.constructor === F;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+function F() { this.x = 1; }
+Object.getOwnPropertyDescriptor(F.prototype, 'constructor').enumerable;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(false, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+function F() { this.x = 1; }
+Object.keys(F.prototype).length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(0, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function G() {}
+G.prototype = { y: 2 };
+new G().y;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(2, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function H() {}
+new H() instanceof H;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+function I() {}
+delete I.prototype;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(false, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+var fs = [];
+for (var i = 0; i < 3; ++i) fs.push(function () {});
+fs[0].prototype !== fs[1].prototype;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+}
+
+TEST(Interpreter, PreparedCall) {
+  {
+    Parser parser(uR"(
+var a = [1, 2, 3, 4, 5];
+var self = { k: 10 };
+a.map(function (x, i, o) { return x * this.k + i + (o === a ? 0 : 100); }, self).join(' ');
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"10 21 32 43 54", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+var a = [1, 2, 3, 4, 5];
+a.filter(function (x) { return x % 2; }).join(' ');
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"1 3 5", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+var a = [1, 2, 3, 4, 5];
+var sum = 0;
+a.forEach(function (x) { sum += x; });
+sum;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(15, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+['1', '2', '3'].map(Number).join(' ');
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"1 2 3", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+var a = [1, 2, 3, 4, 5];
+var calls = 0;
+try {
+  a.forEach(function (x) { ++calls; if (x === 3) throw new Error('stop'); });
+} catch (e) {
+}
+calls;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(3, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+var a = [1, 2, 3, 4, 5];
+try {
+  a.forEach(function (x) { if (x === 3) throw new Error('stop'); });
+} catch (e) {
+  e.message;
+}
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"stop", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+[3, 1, 5, 2, 4].sort(function (x, y) { return y - x; }).join(' ');
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"5 4 3 2 1", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+var big = [];
+for (var i = 0; i < 10000; ++i) big.push(i);
+big.map(function (x) { var t = x + 1; return t; })[9999];
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(10000, comp.GetValue()->GetInt());
+  }
+}
+
+TEST(Interpreter, FunctionApplyCallBind) {
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+add.bind(o, 1)(2, 3);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(106, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+add.bind(o, 1).bind({ base: 0 }, 2)(3);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(106, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+add.bind(o, 1).call({ base: -1 }, 0, 0);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(101, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+typeof add.bind(o, 1).bind(null, 2);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"function", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+add.length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(3, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+add.bind(o, 1).length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(2, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+add.bind(o, 1).bind(null, 2).length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(1, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+add.bind(o, 1, 2, 3, 4).length;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(0, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function P(x, y) { this.x = x; this.y = y; }
+var BP = P.bind(null, 7);
+var p = new BP(8);
+p.x + ':' + p.y;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"7:8", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function P(x, y) { this.x = x; this.y = y; }
+var BP = P.bind(null, 7);
+var p = new BP(8);
+p instanceof BP;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+function P(x, y) { this.x = x; this.y = y; }
+var BP = P.bind(null, 7);
+var p = new BP(8);
+p instanceof P;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+function P(x, y) { this.x = x; this.y = y; }
+var BP = P.bind(null, 7);
+var p = new BP(8);
+Object.getPrototypeOf(p) === P.prototype;
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsBoolean());
+    EXPECT_EQ(true, comp.GetValue()->GetBoolean());
+  }
+
+  {
+    Parser parser(uR"(
+try {
+  new (Math.max.bind(null))();
+} catch (e) {
+  e.name;
+}
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"TypeError", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+try {
+  Function.prototype.bind.call({});
+} catch (e) {
+  e.name;
+}
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"TypeError", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+Math.max.bind(null, 5)(1, 9);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(9, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+add.apply(o, [1, 2, 3]);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(106, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+function viaArgs() { return add.apply(o, arguments); }
+viaArgs(4, 5, 6);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(115, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+add.apply(o, { length: 3, 0: 1, 1: 1, 2: 1 });
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(103, comp.GetValue()->GetInt());
+  }
+
+  {
+    Parser parser(uR"(
+function count() { return arguments.length + ':' + arguments[1]; }
+count.apply(null, [1, , 3]);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"3:undefined", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function count() { return arguments.length + ':' + arguments[1]; }
+count.apply(null);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"0:undefined", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function count() { return arguments.length + ':' + arguments[1] + ':' + arguments[arguments.length - 1]; }
+Array.prototype[1] = 'p';
+count.apply(null, [1, , 3]);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"3:p:3", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function count() { return arguments.length + ':' + arguments[1] + ':' + arguments[arguments.length - 1]; }
+var a = [];
+a.length = 100000;
+a[99999] = 7;
+count.apply(null, a);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"100000:undefined:7", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function count() { return arguments.length + ':' + arguments[1] + ':' + arguments[arguments.length - 1]; }
+var a = [1, 2];
+Object.defineProperty(a, '1', { get: function () { return 'g'; } });
+count.apply(null, a);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"2:g:g", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+try {
+  Math.max.apply(null, { length: 4294967295 });
+} catch (e) {
+  e.name;
+}
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsString());
+    EXPECT_EQ(u"RangeError", comp.GetValue()->GetString());
+  }
+
+  {
+    Parser parser(uR"(
+function add(a, b, c) { return this.base + a + b + c; }
+var o = { base: 100 };
+add.call(o, 1, 1, 1);
+)");
+
+    Interpreter interpreter;
+    JSHandleScope handle_scope{interpreter.GetVM()};
+
+    auto prog = parser.ParseProgram();
+    ASSERT_TRUE(prog->IsProgram());
+
+    auto comp = interpreter.Execute(prog);
+    EXPECT_EQ(types::CompletionType::NORMAL, comp.GetType());
+    ASSERT_TRUE(comp.GetValue()->IsInt());
+    EXPECT_EQ(103, comp.GetValue()->GetInt());
+  }
+}
@@ -208,6 +208,39 @@ TEST(JSValue, ToString) {
 
     EXPECT_EQ(u"-4200", str->GetString());
   }
+
+  {
+    auto val = JSHandle<JSValue>{vm, JSValue(1023.0)};
+    JSHandle<types::String> str = JSValue::ToString(vm, val);
+
+    EXPECT_EQ(u"1023", str->GetString());
+    EXPECT_EQ(vm->GetGlobalConstants()->SmallIntegerString(1023), str.GetObject());
+  }
+
+  {
+    auto val = JSHandle<JSValue>{vm, JSValue(1024)};
+    JSHandle<types::String> str = JSValue::ToString(vm, val);
+
+    EXPECT_EQ(u"1024", str->GetString());
+  }
+}
+
+TEST(JSValue, StringCache) {
+  Interpreter interpreter;
+  VM* vm = interpreter.GetVM();
+  auto factory = vm->GetObjectFactory();
+
+  EXPECT_EQ(u"7", factory->NewStringFromInt(7)->GetString());
+  EXPECT_EQ(factory->NewStringFromInt(7).GetObject(), factory->NewStringFromInt(7).GetObject());
+  EXPECT_EQ(u"-7", factory->NewStringFromInt(-7)->GetString());
+  
+  EXPECT_EQ(u"a", factory->NewStringFromChar(u'a')->GetString());
+  EXPECT_EQ(factory->NewStringFromChar(u'a').GetObject(), factory->NewStringFromChar(u'a').GetObject());
+  EXPECT_EQ(u"\u00ff", factory->NewStringFromChar(u'\u00ff')->GetString());
+  EXPECT_EQ(u"\u4e2d", factory->NewStringFromChar(u'\u4e2d')->GetString());
+
+  auto str = factory->NewString(u"abc");
+  EXPECT_EQ(factory->NewStringFromChar(u'b').GetObject(), types::String::CharAt(vm, str, 1).GetObject());
 }
 
 TEST(JSValue, ToObject) {
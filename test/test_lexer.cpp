@@ -177,7 +177,7 @@ TEST(Lexer, StringLiteral) {
     {TokenType::STRING, uR"()"},
     {TokenType::STRING, u"\n"},
     {TokenType::STRING, uR"(😊)"},
-    {TokenType::STRING, std::u16string(1, 4660)},
+    {TokenType::STRING, u"\u1234"},
     {TokenType::STRING, u"输出：你的名字叫什么？"},
   };
   
@@ -247,3 +247,62 @@ function fnSupportsStrict() {
     }
   }
 }
+
+TEST(Lexer, TokenRefersToSource) {
+  std::u16string source = u"name 'plain' \"esc\\u0061ped\"";
+
+  Lexer lexer(source);
+  auto in_source = [&](std::u16string_view str) {
+    return source.data() <= str.data() && str.data() + str.size() <= source.data() + source.size();
+  };
+
+  lexer.NextToken();
+  EXPECT_EQ(u"name", lexer.GetToken().GetString());
+  EXPECT_TRUE(in_source(lexer.GetToken().GetString()));
+
+  lexer.NextToken();
+  EXPECT_EQ(u"plain", lexer.GetToken().GetString());
+  EXPECT_TRUE(in_source(lexer.GetToken().GetString()));
+
+  lexer.NextToken();
+  EXPECT_EQ(u"escaped", lexer.GetToken().GetString());
+  EXPECT_FALSE(in_source(lexer.GetToken().GetString()));
+}
+
+TEST(Lexer, LongRuns) {
+  std::u16string source =
+    u"            \t\t  abcdefghijklmnopqrstuvwxyz_$0123456789ABCDEFGHIJétail "
+    u"/* a long comment with * and ** inside, spanning more than one block */ "
+    u"// a long single line comment that ends at the line terminator\u2028"
+    u"'a long string literal with \"quotes\" and an \\u0041 escape in it' x";
+
+  Lexer lexer(source);
+
+  lexer.NextToken();
+  EXPECT_EQ(TokenType::IDENTIFIER, lexer.GetToken().GetType());
+  EXPECT_EQ(u"abcdefghijklmnopqrstuvwxyz_$0123456789ABCDEFGHIJétail", lexer.GetToken().GetString());
+
+  lexer.NextToken();
+  EXPECT_EQ(TokenType::STRING, lexer.GetToken().GetType());
+  EXPECT_EQ(u"a long string literal with \"quotes\" and an A escape in it", lexer.GetToken().GetString());
+  EXPECT_TRUE(lexer.HasLineTerminator());
+
+  lexer.NextToken();
+  EXPECT_EQ(TokenType::IDENTIFIER, lexer.GetToken().GetType());
+  EXPECT_EQ(u"x", lexer.GetToken().GetString());
+
+  lexer.NextToken();
+  EXPECT_EQ(TokenType::EOS, lexer.GetToken().GetType());
+}
+
+TEST(Lexer, LookupReservedWord) {
+  EXPECT_EQ(TokenType::KEYWORD_INSTANCEOF, Token::LookupReservedWord(u"instanceof"));
+  EXPECT_EQ(TokenType::KEYWORD_IF, Token::LookupReservedWord(u"if"));
+  EXPECT_EQ(TokenType::NULL_LITERAL, Token::LookupReservedWord(u"null"));
+  EXPECT_EQ(TokenType::FALSE, Token::LookupReservedWord(u"false"));
+  EXPECT_EQ(TokenType::FUTURE_RESERVED_WORD, Token::LookupReservedWord(u"enum"));
+  EXPECT_EQ(TokenType::IDENTIFIER, Token::LookupReservedWord(u"i"));
+  EXPECT_EQ(TokenType::IDENTIFIER, Token::LookupReservedWord(u"iff"));
+  EXPECT_EQ(TokenType::IDENTIFIER, Token::LookupReservedWord(u"private"));
+  EXPECT_EQ(TokenType::IDENTIFIER, Token::LookupReservedWord(u"instanceofs"));
+}
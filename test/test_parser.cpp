@@ -2,6 +2,8 @@
 #include <vector>
 #include <any>
 #include <string>
+#include <memory>
+#include <filesystem>
 
 #include "gtest/gtest.h"
 #include "voidjs/lexer/token.h"
@@ -10,8 +12,14 @@
 #include "voidjs/ir/expression.h"
 #include "voidjs/ir/statement.h"
 #include "voidjs/ir/literal.h"
+#include "voidjs/ir/binding_plan.h"
 #include "voidjs/lexer/token_type.h"
 #include "voidjs/parser/parser.h"
+#include "voidjs/parser/code_cache.h"
+#include "voidjs/parser/streaming_parser.h"
+#include "voidjs/ir/dumper.h"
+#include "voidjs/ir/serializer.h"
+#include "voidjs/utils/helper.h"
 
 using namespace voidjs;
 
@@ -1171,3 +1179,355 @@ arr.bubbleSort();
     ASSERT_TRUE(func_expr->GetStatements().size() == 2);
   }
 }
+
+TEST(parser, ProgramOwnsArena) {
+  std::unique_ptr<ast::Program> program;
+  {
+    Parser parser(u"var name = 'value'; function f(a, b) { return a + b; }");
+    program.reset(parser.ParseProgram());
+  }
+  ASSERT_TRUE(program);
+  ASSERT_NE(nullptr, program->GetArena());
+  EXPECT_LT(0, program->GetArena()->GetAllocatedSize());
+
+  // Nodes and the characters of identifiers and literals outlive the Parser
+  const auto& stmts = program->GetStatements();
+  ASSERT_EQ(2, stmts.size());
+  auto decl = stmts[0]->AsVariableStatement()->GetVariableDeclarations()[0];
+  EXPECT_EQ(u"name", decl->GetIdentifier()->AsIdentifier()->GetName());
+  EXPECT_EQ(u"value", decl->GetInitializer()->AsStringLiteral()->GetString());
+  ASSERT_EQ(1, program->GetFunctionDeclarations().size());
+  EXPECT_EQ(2, program->GetFunctionDeclarations()[0]->GetParameters().size());
+}
+
+TEST(parser, ParseLazyFunction) {
+  Parser parser(uR"(
+function outer(a) {
+  "use strict";
+  var o = { get x() { return [a, (a)]; } };
+  function inner() { return o.x; }
+  return inner();
+}
+var f = function () {};
+)", true);
+
+  std::unique_ptr<ast::Program> program {parser.ParseProgram()};
+  ASSERT_TRUE(program);
+
+  // Bodies are only pre-parsed, the declaration itself is still recorded
+  ASSERT_EQ(1, program->GetFunctionDeclarations().size());
+  auto outer = program->GetFunctionDeclarations()[0];
+  ASSERT_TRUE(outer->IsLazy());
+  EXPECT_TRUE(outer->IsStrict());
+  EXPECT_EQ(1, outer->GetParameters().size());
+  EXPECT_TRUE(outer->GetStatements().empty());
+  EXPECT_EQ(u'{', outer->GetLazyBody().front());
+  EXPECT_EQ(u'}', outer->GetLazyBody().back());
+
+  Parser::ParseLazyFunction(outer);
+  EXPECT_FALSE(outer->IsLazy());
+  EXPECT_TRUE(outer->IsStrict());
+  EXPECT_EQ(3, outer->GetStatements().size());
+  EXPECT_EQ(1, outer->GetVariableDeclarations().size());
+  ASSERT_EQ(1, outer->GetFunctionDeclarations().size());
+
+  // Nested functions stay lazy until they are parsed themselves
+  auto inner = outer->GetFunctionDeclarations()[0];
+  EXPECT_TRUE(inner->IsLazy());
+  Parser::ParseLazyFunction(inner);
+  EXPECT_FALSE(inner->IsLazy());
+  EXPECT_EQ(1, inner->GetStatements().size());
+
+  // An empty body has nothing left to parse
+  auto decl = program->GetStatements()[1]->AsVariableStatement()->GetVariableDeclarations()[0];
+  auto func = decl->GetInitializer()->AsFunctionExpression();
+  EXPECT_TRUE(func->IsLazy());
+  Parser::ParseLazyFunction(func);
+  EXPECT_FALSE(func->IsLazy());
+  EXPECT_TRUE(func->GetStatements().empty());
+}
+
+TEST(parser, ParseLazyFunctionError) {
+  {
+    // Unbalanced brackets are caught by the pre-parser
+    Parser parser(u"function f() { return (1; }", true);
+    std::unique_ptr<ast::Program> program {parser.ParseProgram()};
+    EXPECT_FALSE(program);
+  }
+
+  {
+    // Other errors show up when the body is fully parsed
+    Parser parser(u"function f() { var = 1; }", true);
+    std::unique_ptr<ast::Program> program {parser.ParseProgram()};
+    ASSERT_TRUE(program);
+    auto func = program->GetFunctionDeclarations()[0];
+    EXPECT_THROW(Parser::ParseLazyFunction(func), utils::Error);
+  }
+}
+
+TEST(parser, UsesArguments) {
+  Parser parser(uR"(
+function none(a) { var o = { arguments: a }; return o.arguments; }
+function direct() { return arguments.length; }
+function nested() { return function () { return arguments[0]; }; }
+function evals(s) { return eval(s); }
+)", true);
+
+  std::unique_ptr<ast::Program> program {parser.ParseProgram()};
+  ASSERT_TRUE(program);
+  ASSERT_EQ(4, program->GetFunctionDeclarations().size());
+  for (auto func : program->GetFunctionDeclarations()) {
+    Parser::ParseLazyFunction(func);
+  }
+
+  // Property names are not references, and a nested function has arguments of its own
+  const auto& funcs = program->GetFunctionDeclarations();
+  EXPECT_FALSE(funcs[0]->UsesArguments());
+  EXPECT_TRUE(funcs[1]->UsesArguments());
+  EXPECT_FALSE(funcs[2]->UsesArguments());
+  EXPECT_TRUE(funcs[3]->UsesArguments());
+
+  auto inner = funcs[2]->GetStatements()[0]->AsReturnStatement()->GetExpression()->AsFunctionExpression();
+  Parser::ParseLazyFunction(inner);
+  EXPECT_TRUE(inner->UsesArguments());
+}
+
+TEST(parser, FrameSlots) {
+  Parser parser(uR"(
+function leaf(a, b, a) { var c = a + b + g; try { c(); } catch (b) { var d = b; } return b + c + d; }
+function outer(a) { return function () { return a; }; }
+function scoped(o) { with (o) { return x; } }
+)");
+
+  std::unique_ptr<ast::Program> program {parser.ParseProgram()};
+  ASSERT_TRUE(program);
+  const auto& funcs = program->GetFunctionDeclarations();
+  ASSERT_EQ(3, funcs.size());
+
+  // a, b, c, d and the catch parameter b, the duplicate parameter shares the slot of a
+  auto leaf = funcs[0];
+  ASSERT_TRUE(leaf->KeepsLocalsInFrame());
+  EXPECT_EQ(5, leaf->GetFrameSlotNum());
+  const auto& params = leaf->GetParameters();
+  EXPECT_EQ(0, params[0]->AsIdentifier()->GetSlot());
+  EXPECT_EQ(1, params[1]->AsIdentifier()->GetSlot());
+  EXPECT_EQ(0, params[2]->AsIdentifier()->GetSlot());
+
+  const auto& stmts = leaf->GetStatements();
+  auto init = stmts[0]->AsVariableStatement()->GetVariableDeclarations()[0]->GetInitializer()->AsBinaryExpression();
+  EXPECT_EQ(0, init->GetLeft()->AsBinaryExpression()->GetLeft()->AsIdentifier()->GetSlot());
+  EXPECT_FALSE(init->GetRight()->AsIdentifier()->HasSlot());
+
+  auto try_stmt = stmts[1]->AsTryStatement();
+  EXPECT_EQ(4, try_stmt->GetCatchName()->AsIdentifier()->GetSlot());
+  auto catch_init = try_stmt->GetCatchBlock()->AsBlockStatement()->GetStatements()[0]
+    ->AsVariableStatement()->GetVariableDeclarations()[0];
+  EXPECT_EQ(3, catch_init->GetIdentifier()->AsIdentifier()->GetSlot());
+  EXPECT_EQ(4, catch_init->GetInitializer()->AsIdentifier()->GetSlot());
+
+  auto ret = stmts[2]->AsReturnStatement()->GetExpression()->AsBinaryExpression();
+  EXPECT_EQ(3, ret->GetRight()->AsIdentifier()->GetSlot());
+
+  // Captured by an inner function, or shadowed by with
+  EXPECT_FALSE(funcs[1]->KeepsLocalsInFrame());
+  EXPECT_FALSE(funcs[2]->KeepsLocalsInFrame());
+}
+
+TEST(parser, BindingPlan) {
+  Parser parser(uR"(
+function f(a, b, a) { var b, c, d; function d() {} function a() {} return function () { return arguments; }; }
+function g(x) { var arguments; return function () { return x; }(arguments); }
+function h(arguments) { return function () { return arguments; }; }
+function leaf(x) { return x; }
+)");
+
+  std::unique_ptr<ast::Program> program {parser.ParseProgram()};
+  ASSERT_TRUE(program);
+  const auto& funcs = program->GetFunctionDeclarations();
+  ASSERT_EQ(4, funcs.size());
+
+  // a, b and the FunctionDeclaration d are bound first, c is the only var left to bind
+  auto f = funcs[0]->GetBindingPlan();
+  ASSERT_NE(nullptr, f);
+  EXPECT_EQ((std::vector<std::u16string_view>{u"a", u"b", u"d", u"c"}),
+            (std::vector<std::u16string_view>{f->names.begin(), f->names.end()}));
+  EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 0}), (std::vector<std::uint32_t>{f->parameters.begin(), f->parameters.end()}));
+  EXPECT_EQ((std::vector<std::uint32_t>{2, 0}), (std::vector<std::uint32_t>{f->functions.begin(), f->functions.end()}));
+  EXPECT_FALSE(f->creates_arguments);
+
+  // var arguments is already declared by the arguments object
+  auto g = funcs[1]->GetBindingPlan();
+  ASSERT_NE(nullptr, g);
+  EXPECT_EQ(1, g->names.size());
+  EXPECT_TRUE(g->creates_arguments);
+  EXPECT_EQ(2, g->GetBindingNum());
+
+  // The parameter named arguments shadows the arguments object
+  auto h = funcs[2]->GetBindingPlan();
+  ASSERT_NE(nullptr, h);
+  EXPECT_FALSE(h->creates_arguments);
+
+  // Locals kept in the frame are not bound in an environment
+  EXPECT_EQ(nullptr, funcs[3]->GetBindingPlan());
+}
+
+TEST(parser, SerializeProgram) {
+  auto source = uR"(
+var o = { get x() { return this.v; }, v: [1, 'two'] };
+function f(a, b) {
+  "use strict";
+  for (var i in o) { if (!a) continue; else break; }
+  switch (a) { case 1: return new F(a, b); case 2: return a ? -b : b++ }
+}
+outer: do { try { throw f(1, 2); } catch (e) { break outer; } finally { null; } } while (false);
+)";
+
+  Parser parser(source);
+  std::unique_ptr<ast::Program> program {parser.ParseProgram()};
+  ASSERT_TRUE(program);
+
+  auto data = ast::Serializer{program.get()}.GetData();
+  ast::Deserializer deserializer{reinterpret_cast<const std::uint8_t*>(data.data()), data.size()};
+  std::unique_ptr<ast::Program> copy {deserializer.Deserialize()};
+  ASSERT_TRUE(copy);
+
+  EXPECT_EQ(ast::Dumper{program.get()}.GetString(), ast::Dumper{copy.get()}.GetString());
+
+  // Declarations are shared between the statements and their scope, as the Parser builds them
+  ASSERT_EQ(1, copy->GetFunctionDeclarations().size());
+  EXPECT_EQ(copy->GetStatements()[1], copy->GetFunctionDeclarations()[0]);
+  EXPECT_TRUE(copy->GetFunctionDeclarations()[0]->IsStrict());
+  EXPECT_FALSE(copy->GetFunctionDeclarations()[0]->UsesArguments());
+  ASSERT_EQ(1, copy->GetVariableDeclarations().size());
+  EXPECT_EQ(copy->GetStatements()[0]->AsVariableStatement()->GetVariableDeclarations()[0],
+            copy->GetVariableDeclarations()[0]);
+
+  // Truncated data is rejected
+  ast::Deserializer truncated{reinterpret_cast<const std::uint8_t*>(data.data()), data.size() - 1};
+  EXPECT_EQ(nullptr, truncated.Deserialize());
+}
+
+TEST(parser, CodeCache) {
+  auto dir = std::filesystem::temp_directory_path() / "voidjs_test_code_cache";
+  std::filesystem::remove_all(dir);
+
+  CodeCache code_cache{dir.string()};
+  std::string source = "function f(x) { return x * 2; } f(21);";
+  EXPECT_EQ(nullptr, code_cache.Load(source));
+
+  Parser parser(utils::U8StrToU16Str(source));
+  std::unique_ptr<ast::Program> program {parser.ParseProgram()};
+  ASSERT_TRUE(program);
+  ASSERT_TRUE(code_cache.Store(source, program.get()));
+
+  std::unique_ptr<ast::Program> cached {code_cache.Load(source)};
+  ASSERT_TRUE(cached);
+  EXPECT_EQ(ast::Dumper{program.get()}.GetString(), ast::Dumper{cached.get()}.GetString());
+
+  // Entries are keyed by the source, a changed source misses
+  EXPECT_EQ(nullptr, code_cache.Load(source + " "));
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(parser, StreamingParser) {
+  StreamingParser parser(uR"(
+"use strict";
+f();
+var a = 1, b = function () { var hidden; }, c = { d: [1, 2] }
+  , m = a
+  + 1
+var e
+for (var i = 0, n; i < 1; ++i) { var j; }
+for (var k in {}) {}
+function f() { var hidden; }
+var g = function h() {};
+)", 1);
+
+  ASSERT_TRUE(parser.ScanDeclarations());
+  auto decls = parser.GetDeclarations();
+  EXPECT_TRUE(decls->IsStrict());
+  EXPECT_TRUE(decls->GetStatements().empty());
+
+  // Names of hoisted vars, in source order, and nothing from function bodies
+  std::vector<std::u16string_view> names;
+  for (auto var_decl : decls->GetVariableDeclarations()) {
+    names.push_back(var_decl->GetIdentifier()->AsIdentifier()->GetName());
+  }
+  std::vector<std::u16string_view> expected {u"a", u"b", u"c", u"m", u"e", u"i", u"n", u"j", u"k", u"g"};
+  EXPECT_EQ(expected, names);
+  ASSERT_EQ(1, decls->GetFunctionDeclarations().size());
+  auto func = decls->GetFunctionDeclarations()[0];
+  EXPECT_EQ(u"f", func->GetName()->AsIdentifier()->GetName());
+  EXPECT_TRUE(func->IsLazy());
+
+  // With the smallest chunk size, each chunk holds one SourceElement,
+  // and declares nothing since everything has been hoisted.
+  std::size_t count = 0;
+  while (auto chunk = parser.ParseChunk()) {
+    ++count;
+    EXPECT_EQ(1, chunk->GetStatements().size());
+    EXPECT_TRUE(chunk->IsStrict());
+    EXPECT_TRUE(chunk->GetVariableDeclarations().empty());
+    EXPECT_TRUE(chunk->GetFunctionDeclarations().empty());
+  }
+  EXPECT_EQ(7, count);
+  EXPECT_FALSE(parser.HasError());
+}
+
+TEST(parser, StreamingParserError) {
+  {
+    // Unbalanced brackets fail the scan
+    StreamingParser parser(u"var a = (1;");
+    EXPECT_FALSE(parser.ScanDeclarations());
+  }
+
+  {
+    // Other errors show up in the chunk holding them
+    StreamingParser parser(u"var a = 1; var = 2;", 1);
+    ASSERT_TRUE(parser.ScanDeclarations());
+    EXPECT_TRUE(parser.ParseChunk());
+    EXPECT_FALSE(parser.ParseChunk());
+    EXPECT_TRUE(parser.HasError());
+    EXPECT_FALSE(parser.ParseChunk());
+  }
+}
+
+TEST(parser, ParseLazyFunctions) {
+  std::u16string source;
+  for (int i = 0; i < 64; ++i) {
+    auto idx = utils::U8StrToU16Str(std::to_string(i));
+    source += u"function f" + idx + u"(a) { function inner() { return a; } return inner() + " + idx + u"; }\n";
+    source += u"var o" + idx + u" = { get x() { return function () { return 'ab\\x63'; }; } };\n";
+  }
+  source += u"function bad() { var = 1; }\n";
+
+  Parser parser(source, true);
+  std::unique_ptr<ast::Program> program {parser.ParseProgram()};
+  ASSERT_TRUE(program);
+  parser.ParseLazyFunctions(program.get(), 4);
+
+  // Nested functions are parsed along with the function holding them
+  const auto& func_decls = program->GetFunctionDeclarations();
+  ASSERT_EQ(65, func_decls.size());
+  for (std::size_t idx = 0; idx < 64; ++idx) {
+    auto func = func_decls[idx];
+    EXPECT_FALSE(func->IsLazy());
+    EXPECT_EQ(2, func->GetStatements().size());
+    ASSERT_EQ(1, func->GetFunctionDeclarations().size());
+    EXPECT_FALSE(func->GetFunctionDeclarations()[0]->IsLazy());
+
+    auto decl = program->GetStatements()[2 * idx + 1]->AsVariableStatement()->GetVariableDeclarations()[0];
+    auto getter = decl->GetInitializer()->AsObjectLiteral()->GetProperties()[0]->GetValue()->AsFunctionExpression();
+    EXPECT_FALSE(getter->IsLazy());
+    auto ret = getter->GetStatements()[0]->AsReturnStatement()->GetExpression()->AsFunctionExpression();
+    EXPECT_FALSE(ret->IsLazy());
+    auto str = ret->GetStatements()[0]->AsReturnStatement()->GetExpression()->AsStringLiteral();
+    EXPECT_EQ(u"abc", str->GetString());
+  }
+
+  // A body with an error is left for ParseLazyFunction to report
+  auto bad = func_decls[64];
+  EXPECT_TRUE(bad->IsLazy());
+  EXPECT_THROW(Parser::ParseLazyFunction(bad), utils::Error);
+}
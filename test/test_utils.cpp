@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+
+#include <string>
+
+#include "voidjs/utils/helper.h"
+#include "voidjs/utils/unicode.h"
+
+using namespace voidjs;
+
+TEST(Utils, Utf8ToUtf16) {
+  EXPECT_EQ(u"", utils::U8StrToU16Str(""));
+  EXPECT_EQ(u"abc", utils::U8StrToU16Str("abc"));
+
+  // Long enough to go through the vector path, with a tail and non-ASCII in the middle
+  std::string ascii(37, 'x');
+  EXPECT_EQ(std::u16string(37, u'x'), utils::U8StrToU16Str(ascii));
+  EXPECT_EQ(std::u16string(20, u'x') + u"h\u00E9\u4E16\U0001F600" + std::u16string(20, u'y'),
+            utils::U8StrToU16Str(std::string(20, 'x') + "h\xC3\xA9\xE4\xB8\x96\xF0\x9F\x98\x80" + std::string(20, 'y')));
+
+  // Ill-formed subparts are replaced one by one
+  EXPECT_EQ(u"a\uFFFDb", utils::U8StrToU16Str("a\x80" "b"));
+  EXPECT_EQ(u"\uFFFD\uFFFD", utils::U8StrToU16Str("\xC0\xAF"));  // overlong
+  EXPECT_EQ(u"\uFFFD\uFFFD\uFFFD", utils::U8StrToU16Str("\xED\xA0\x80"));  // surrogate
+  EXPECT_EQ(u"\uFFFDa", utils::U8StrToU16Str("\xE4\xB8" "a"));  // truncated
+  EXPECT_EQ(u"\uFFFD\uFFFD\uFFFD\uFFFD", utils::U8StrToU16Str("\xF4\x90\x80\x80"));  // above U+10FFFF
+}
+
+TEST(Utils, Utf16ToUtf8) {
+  EXPECT_EQ("", utils::U16StrToU8Str(u""));
+  EXPECT_EQ("abc", utils::U16StrToU8Str(u"abc"));
+  EXPECT_EQ(std::string(37, 'x'), utils::U16StrToU8Str(std::u16string(37, u'x')));
+  EXPECT_EQ(std::string(10, 'x') + "h\xC3\xA9\xE4\xB8\x96\xF0\x9F\x98\x80" + std::string(10, 'y'),
+            utils::U16StrToU8Str(std::u16string(10, u'x') + u"h\u00E9\u4E16\U0001F600" + std::u16string(10, u'y')));
+
+  // Lone surrogates are replaced
+  EXPECT_EQ("\xEF\xBF\xBD" "a", utils::U16StrToU8Str(std::u16string{u'\xD800', u'a'}));
+  EXPECT_EQ("a\xEF\xBF\xBD", utils::U16StrToU8Str(std::u16string{u'a', u'\xDC00'}));
+}
@@ -0,0 +1,152 @@
+#include "voidjs/builtins/arguments.h"
+
+#include "voidjs/types/heap_object.h"
+#include "voidjs/types/js_value.h"
+#include "voidjs/types/object_factory.h"
+#include "voidjs/types/lang_types/object.h"
+#include "voidjs/types/lang_types/string.h"
+#include "voidjs/types/spec_types/environment_record.h"
+#include "voidjs/types/spec_types/property_descriptor.h"
+#include "voidjs/interpreter/vm.h"
+#include "voidjs/utils/macros.h"
+
+namespace voidjs {
+namespace builtins {
+
+// [[GetOwnProperty]]
+// Defined in ECMAScript 5.1 Chapter 10.6
+types::PropertyDescriptor Arguments::GetOwnProperty(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P) {
+  // 1. Let desc be the result of calling the default [[GetOwnProperty]] internal method (8.12.1) on the arguments object passing P as the argument.
+  auto desc = types::Object::GetOwnPropertyDefault(vm, obj, P);
+
+  // 2. If desc is undefined then return desc.
+  if (desc.IsEmpty()) {
+    return desc;
+  }
+
+  // 3. Let map be the value of the [[ParameterMap]] internal property of the arguments object.
+  // 4. Let isMapped be the result of calling the [[GetOwnProperty]] internal method of map passing P as the argument.
+  auto name = GetMappedName(vm, obj, P);
+
+  // 5. If the value of isMapped is not undefined, then
+  if (!name.IsEmpty()) {
+    // a. Set desc.[[Value]] to the result of calling the [[Get]] internal method of map passing P as the argument.
+    auto env = JSHandle<types::EnvironmentRecord>{vm, obj->GetEnvironment()};
+    desc.SetValue(types::EnvironmentRecord::GetBindingValue(vm, env, name, true));
+  }
+
+  // 6. Return desc.
+  return desc;
+}
+
+// [[Get]]
+// Defined in ECMAScript 5.1 Chapter 10.6
+JSHandle<JSValue> Arguments::Get(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P) {
+  // 1. Let map be the value of the [[ParameterMap]] internal property of the arguments object.
+  // 2. Let isMapped be the result of calling the [[GetOwnProperty]] internal method of map passing P as the argument.
+  auto name = GetMappedName(vm, obj, P);
+
+  // 3. If the value of isMapped is undefined, then
+  if (name.IsEmpty()) {
+    // a. Let v be the result of calling the default [[Get]] internal method (8.12.3) on the arguments object passing P as the argument.
+    // b. If P is "caller" and v is a strict mode Function object, throw a TypeError exception.
+    // c. Return v.
+    return types::Object::GetDefault(vm, obj, P);
+  }
+  // 4. Else, map contains a formal parameter mapping for P so,
+  else {
+    // a. Return the result of calling the [[Get]] internal method of map passing P as the argument.
+    auto env = JSHandle<types::EnvironmentRecord>{vm, obj->GetEnvironment()};
+    return types::EnvironmentRecord::GetBindingValue(vm, env, name, true);
+  }
+}
+
+// [[DefineOwnProperty]]
+// Defined in ECMAScript 5.1 Chapter 10.6
+bool Arguments::DefineOwnProperty(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P, const types::PropertyDescriptor& Desc, bool Throw) {
+  // 1. Let map be the value of the [[ParameterMap]] internal property of the arguments object.
+  // 2. Let isMapped be the result of calling the [[GetOwnProperty]] internal method of map passing P as the argument.
+  auto name = GetMappedName(vm, obj, P);
+
+  // 3. Let allowed be the result of calling the default [[DefineOwnProperty]] internal method (8.12.9)
+  //    on the arguments object passing P, Desc, and false as the arguments.
+  bool allowed = types::Object::DefineOwnPropertyDefault(vm, obj, P, Desc, false);
+
+  // 4. If allowed is false, then
+  if (!allowed) {
+    // a. If Throw is true then throw a TypeError exception, otherwise return false.
+    if (Throw) {
+      THROW_TYPE_ERROR_AND_RETURN_VALUE(
+        vm, u"Arguments.DefineOwnProperty cannot define property.", false);
+    } else {
+      return false;
+    }
+  }
+
+  // 5. If the value of isMapped is not undefined, then
+  if (!name.IsEmpty()) {
+    // a. If IsAccessorDescriptor(Desc) is true, then
+    if (Desc.IsAccessorDescriptor()) {
+      // i. Call the [[Delete]] internal method of map passing P, and false as the arguments.
+      Unmap(vm, obj, P);
+    }
+    // b. Else
+    else {
+      // i. If Desc.[[Value]] is present, then
+      if (Desc.HasValue()) {
+        // 1. Call the [[Put]] internal method of map passing P, Desc.[[Value]], and Throw as the arguments.
+        auto env = JSHandle<types::EnvironmentRecord>{vm, obj->GetEnvironment()};
+        types::EnvironmentRecord::SetMutableBinding(vm, env, name, Desc.GetValue(), true);
+        RETURN_VALUE_IF_HAS_EXCEPTION(vm, false);
+      }
+
+      // ii. If Desc.[[Writable]] is present and its value is false, then
+      if (Desc.HasWritable() && !Desc.GetWritable()) {
+        // 1. Call the [[Delete]] internal method of map passing P and false as arguments.
+        Unmap(vm, obj, P);
+      }
+    }
+  }
+
+  // 6. Return true.
+  return true;
+}
+
+// [[Delete]]
+// Defined in ECMAScript 5.1 Chapter 10.6
+bool Arguments::Delete(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P, bool Throw) {
+  // 1. Let map be the value of the [[ParameterMap]] internal property of the arguments object.
+  // 2. Let isMapped be the result of calling the [[GetOwnProperty]] internal method of map passing P as the argument.
+  auto name = GetMappedName(vm, obj, P);
+
+  // 3. Let result be the result of calling the default [[Delete]] internal method (8.12.7)
+  //    on the arguments object passing P and Throw as the arguments.
+  bool result = types::Object::DeleteDefault(vm, obj, P, Throw);
+  RETURN_VALUE_IF_HAS_EXCEPTION(vm, false);
+
+  // 4. If result is true and the value of isMapped is not undefined, then
+  if (result && !name.IsEmpty()) {
+    // a. Call the [[Delete]] internal method of map passing P, and false as the arguments.
+    Unmap(vm, obj, P);
+  }
+
+  // 5. Return result.
+  return result;
+}
+
+JSHandle<types::String> Arguments::GetMappedName(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P) {
+  auto map = JSHandle<types::Object>{vm, obj->GetParameterMap()};
+  auto is_mapped = types::Object::GetOwnPropertyDefault(vm, map, P);
+  if (is_mapped.IsEmpty()) {
+    return {};
+  }
+  return is_mapped.GetValue().As<types::String>();
+}
+
+void Arguments::Unmap(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P) {
+  auto map = JSHandle<types::Object>{vm, obj->GetParameterMap()};
+  types::Object::DeleteDefault(vm, map, P, false);
+}
+
+}  // namespace builtins
+}  // namespace voidjs
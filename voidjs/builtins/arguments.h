@@ -2,10 +2,16 @@
 #define VOIDJS_BUILTINS_ARGUMENTS
 
 #include "voidjs/types/lang_types/object.h"
+#include "voidjs/types/spec_types/property_descriptor.h"
 
 namespace voidjs {
 namespace builtins {
 
+// The [[ParameterMap]] of an arguments object for non-strict code maps ToString(indx)
+// to the name of the formal parameter it is joined with. Instead of the accessors
+// made by MakeArgGetter and MakeArgSetter, the binding of that name is read and written
+// in the environment record of the function directly, which is the same as calling them.
+// Without mapped names the [[ParameterMap]] is undefined and the object is an ordinary one.
 class Arguments : public types::Object {
  public:
   // Object*
@@ -13,9 +19,29 @@ class Arguments : public types::Object {
   JSValue GetParameterMap() const { return *utils::BitGet<JSValue*>(this, PARAMETER_MAP_OFFSET); }
   void SetParameterMap(JSValue value) { *utils::BitGet<JSValue*>(this, PARAMETER_MAP_OFFSET) = value; }
   void SetParameterMap(JSHandle<JSValue> handle) { *utils::BitGet<JSValue*>(this, PARAMETER_MAP_OFFSET) = handle.GetJSValue(); }
+
+  // EnvironmentRecord*
+  static constexpr std::size_t ENVIRONMENT_OFFSET = PARAMETER_MAP_OFFSET + sizeof(JSValue);
+  JSValue GetEnvironment() const { return *utils::BitGet<JSValue*>(this, ENVIRONMENT_OFFSET); }
+  void SetEnvironment(JSValue value) { *utils::BitGet<JSValue*>(this, ENVIRONMENT_OFFSET) = value; }
+  void SetEnvironment(JSHandle<JSValue> handle) { *utils::BitGet<JSValue*>(this, ENVIRONMENT_OFFSET) = handle.GetJSValue(); }
+
+  bool IsMapped() const { return !GetParameterMap().IsUndefined(); }
   
-  static constexpr std::size_t SIZE = sizeof(JSValue);
+  static constexpr std::size_t SIZE = sizeof(JSValue) + sizeof(JSValue);
   static constexpr std::size_t END_OFFSET = types::Object::END_OFFSET + SIZE;
+
+  // Internal methods of an arguments object with a [[ParameterMap]]
+  // Defined in ECMAScript 5.1 Chapter 10.6
+  static types::PropertyDescriptor GetOwnProperty(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P);
+  static JSHandle<JSValue> Get(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P);
+  static bool DefineOwnProperty(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P, const types::PropertyDescriptor& Desc, bool Throw);
+  static bool Delete(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P, bool Throw);
+
+ private:
+  // Returns the name of the parameter P is mapped to, or an empty handle
+  static JSHandle<types::String> GetMappedName(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P);
+  static void Unmap(VM* vm, JSHandle<Arguments> obj, JSHandle<types::String> P);
 };
 
 }  // namespace builtins
@@ -0,0 +1,86 @@
+#include "voidjs/builtins/bound_function.h"
+
+#include "voidjs/types/heap_object.h"
+#include "voidjs/types/js_value.h"
+#include "voidjs/types/object_factory.h"
+#include "voidjs/types/lang_types/object.h"
+#include "voidjs/types/internal_types/array.h"
+#include "voidjs/builtins/js_function.h"
+#include "voidjs/interpreter/vm.h"
+#include "voidjs/interpreter/global_constants.h"
+#include "voidjs/utils/macros.h"
+
+namespace voidjs {
+namespace builtins {
+
+// [[Call]]
+// Defined in ECMAScript 5.1 Chapter 15.3.4.5.1
+JSHandle<JSValue> BoundFunction::Call(VM* vm, JSHandle<BoundFunction> F, const std::vector<JSHandle<JSValue>>& extra_args) {
+  // 1. Let boundArgs be the value of F's [[BoundArgs]] internal property.
+  // 2. Let boundThis be the value of F's [[BoundThis]] internal property.
+  // 3. Let target be the value of F's [[TargetFunction]] internal property.
+  JSHandle<types::Object> target{vm, F->GetTargetFunction()};
+  JSHandle<JSValue> bound_this{vm, F->GetBoundThis()};
+
+  // 4. Let args be a new list containing the same values as the list boundArgs in the same order
+  //    followed by the same values as the list ExtraArgs in the same order.
+  auto args = GetArgs(vm, F, extra_args);
+
+  // 5. Return the result of calling the [[Call]] internal method of target providing boundThis as the this value and providing args as the arguments.
+  return types::Object::Call(vm, target, bound_this, args);
+}
+
+// [[Construct]]
+// Defined in ECMAScript 5.1 Chapter 15.3.4.5.2
+JSHandle<JSValue> BoundFunction::Construct(VM* vm, JSHandle<BoundFunction> F, const std::vector<JSHandle<JSValue>>& extra_args) {
+  // 1. Let target be the value of F's [[TargetFunction]] internal property.
+  JSHandle<types::Object> target{vm, F->GetTargetFunction()};
+
+  // 2. If target has no [[Construct]] internal method, a TypeError exception is thrown.
+  //    Builtin functions other than the constructors only have [[Call]].
+  auto kind = target->GetCallKind();
+  if (kind == CallKind::NONE || kind == CallKind::INTERNAL_FUNCTION) {
+    THROW_TYPE_ERROR_AND_RETURN_HANDLE(vm, u"Bound function has no [[Construct]] internal method.", JSValue);
+  }
+
+  // 3. Let boundArgs be the value of F's [[BoundArgs]] internal property.
+  // 4. Let args be a new list containing the same values as the list boundArgs in the same order
+  //    followed by the same values as the list ExtraArgs in the same order.
+  auto args = GetArgs(vm, F, extra_args);
+
+  // 5. Return the result of calling the [[Construct]] internal method of target providing args as the arguments.
+  return types::Object::Construct(vm, target, vm->GetGlobalConstants()->HandledUndefined(), args);
+}
+
+// [[HasInstance]](V)
+// Defined in ECMAScript 5.1 Chapter 15.3.4.5.3
+bool BoundFunction::HasInstance(VM* vm, JSHandle<BoundFunction> F, JSHandle<JSValue> V) {
+  // 1. Let target be the value of F's [[TargetFunction]] internal property.
+  JSHandle<types::Object> target{vm, F->GetTargetFunction()};
+
+  // 2. If target has no [[HasInstance]] internal method, a TypeError exception is thrown.
+  if (!target->IsJSFunction()) {
+    THROW_TYPE_ERROR_AND_RETURN_VALUE(vm, u"Bound function has no [[HasInstance]] internal method.", false);
+  }
+
+  // 3. Return the result of calling the [[HasInstance]] internal method of target providing V as the argument.
+  return JSFunction::HasInstance(vm, target.As<JSFunction>(), V);
+}
+
+std::vector<JSHandle<JSValue>> BoundFunction::GetArgs(
+  VM* vm, JSHandle<BoundFunction> F, const std::vector<JSHandle<JSValue>>& extra_args) {
+  auto bound_args = F->GetBoundArgs().GetHeapObject()->AsArray();
+  std::size_t bound_num = bound_args->GetLength();
+
+  std::vector<JSHandle<JSValue>> args;
+  args.reserve(bound_num + extra_args.size());
+  for (std::size_t idx = 0; idx < bound_num; ++idx) {
+    args.emplace_back(vm, bound_args->Get(idx));
+  }
+  args.insert(args.end(), extra_args.begin(), extra_args.end());
+
+  return args;
+}
+
+}  // namespace builtins
+}  // namespace voidjs
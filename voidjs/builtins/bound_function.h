@@ -0,0 +1,54 @@
+#ifndef VOIDJS_BUILTINS_BOUND_FUNCTION_H
+#define VOIDJS_BUILTINS_BOUND_FUNCTION_H
+
+#include <vector>
+
+#include "voidjs/types/js_value.h"
+#include "voidjs/types/lang_types/object.h"
+#include "voidjs/utils/helper.h"
+
+namespace voidjs {
+namespace builtins {
+
+// Function objects created by Function.prototype.bind (15.3.4.5).
+// They are callable objects of their own CallKind, so [[Call]] and [[Construct]]
+// go straight to the target function with the bound arguments prepended.
+// A bound function is never the [[TargetFunction]] of another one,
+// binding it again binds its target with both lists of arguments joined.
+class BoundFunction : public types::Object {
+ public:
+  // Object*
+  static constexpr std::size_t TARGET_FUNCTION_OFFSET = types::Object::END_OFFSET;
+  JSValue GetTargetFunction() const { return *utils::BitGet<JSValue*>(this, TARGET_FUNCTION_OFFSET); }
+  void SetTargetFunction(JSValue value) { *utils::BitGet<JSValue*>(this, TARGET_FUNCTION_OFFSET) = value; }
+  void SetTargetFunction(JSHandle<JSValue> handle) { *utils::BitGet<JSValue*>(this, TARGET_FUNCTION_OFFSET) = handle.GetJSValue(); }
+
+  static constexpr std::size_t BOUND_THIS_OFFSET = TARGET_FUNCTION_OFFSET + sizeof(JSValue);
+  JSValue GetBoundThis() const { return *utils::BitGet<JSValue*>(this, BOUND_THIS_OFFSET); }
+  void SetBoundThis(JSValue value) { *utils::BitGet<JSValue*>(this, BOUND_THIS_OFFSET) = value; }
+  void SetBoundThis(JSHandle<JSValue> handle) { *utils::BitGet<JSValue*>(this, BOUND_THIS_OFFSET) = handle.GetJSValue(); }
+
+  // Array*
+  static constexpr std::size_t BOUND_ARGS_OFFSET = BOUND_THIS_OFFSET + sizeof(JSValue);
+  JSValue GetBoundArgs() const { return *utils::BitGet<JSValue*>(this, BOUND_ARGS_OFFSET); }
+  void SetBoundArgs(JSValue value) { *utils::BitGet<JSValue*>(this, BOUND_ARGS_OFFSET) = value; }
+  void SetBoundArgs(JSHandle<JSValue> handle) { *utils::BitGet<JSValue*>(this, BOUND_ARGS_OFFSET) = handle.GetJSValue(); }
+
+  static constexpr std::size_t SIZE = sizeof(JSValue) + sizeof(JSValue) + sizeof(JSValue);
+  static constexpr std::size_t END_OFFSET = types::Object::END_OFFSET + SIZE;
+
+  // Internal methods of a bound function
+  // Defined in ECMAScript 5.1 Chapter 15.3.4.5.1 - 15.3.4.5.3
+  static JSHandle<JSValue> Call(VM* vm, JSHandle<BoundFunction> F, const std::vector<JSHandle<JSValue>>& extra_args);
+  static JSHandle<JSValue> Construct(VM* vm, JSHandle<BoundFunction> F, const std::vector<JSHandle<JSValue>>& extra_args);
+  static bool HasInstance(VM* vm, JSHandle<BoundFunction> F, JSHandle<JSValue> V);
+
+ private:
+  // boundArgs followed by extra_args, in a single list
+  static std::vector<JSHandle<JSValue>> GetArgs(VM* vm, JSHandle<BoundFunction> F, const std::vector<JSHandle<JSValue>>& extra_args);
+};
+
+}  // namespace builtins
+}  // namespace voidjs
+
+#endif  // VOIDJS_BUILTINS_BOUND_FUNCTION_H
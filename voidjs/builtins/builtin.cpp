@@ -1,5 +1,6 @@
 #include "voidjs/builtins/builtin.h"
 
+#include <algorithm>
 #include <functional>
 
 #include "voidjs/ir/ast.h"
@@ -32,6 +33,37 @@
 namespace voidjs {
 namespace builtins {
 
+namespace {
+
+// Every builtin method, in the order they are installed.
+// A lazy property refers to its method by the index into this table,
+// which stays valid across processes running the same binary, unlike the function pointer.
+constexpr InternalFunctionType METHODS[] = {
+  GlobalObject::IsNaN, GlobalObject::IsFinite, GlobalObject::Print,
+  JSObject::GetPrototypeOf, JSObject::GetOwnPropertyDescriptor, JSObject::GetOwnPropertyNames,
+  JSObject::Create, JSObject::DefineProperty, JSObject::DefineProperties, JSObject::Seal, JSObject::Freeze,
+  JSObject::PreventExtensions, JSObject::IsSealed, JSObject::IsFrozen, JSObject::IsExtensible,
+  JSObject::Keys, JSObject::SetPrototypeOf, JSObject::ToString, JSObject::ToLocaleString, JSObject::ValueOf,
+  JSObject::HasOwnProperty, JSObject::IsPrototypeOf, JSObject::PropertyIsEnumerable,
+  JSFunction::Apply, JSFunction::Call, JSFunction::Bind,
+  JSArray::IsArray, JSArray::ToString, JSArray::ToLocaleString, JSArray::Concat, JSArray::Join, JSArray::Pop,
+  JSArray::Push, JSArray::Reverse, JSArray::Shift, JSArray::Slice, JSArray::Sort, JSArray::ForEach,
+  JSArray::Map, JSArray::Filter,
+  JSString::FromCharCode, JSString::ToString, JSString::ValueOf, JSString::CharAt, JSString::CharCodeAt,
+  JSString::Concat, JSString::IndexOf, JSString::LastIndexOf, JSString::Slice, JSString::Substring,
+  JSString::ToLowerCase, JSString::ToUpperCase, JSString::Trim,
+  JSBoolean::ToString, JSBoolean::ValueOf,
+  JSNumber::ToString, JSNumber::ValueOf,
+  JSMath::Abs, JSMath::Acos, JSMath::Asin, JSMath::Atan, JSMath::Ceil, JSMath::Cos, JSMath::Exp,
+  JSMath::Floor, JSMath::Log, JSMath::Max, JSMath::Min, JSMath::Pow, JSMath::Random, JSMath::Round,
+  JSMath::Sin, JSMath::Sqrt, JSMath::Tan,
+  JSError::ToString,
+};
+
+constexpr std::int32_t METHOD_NUM = sizeof(METHODS) / sizeof(METHODS[0]);
+
+}  // namespace
+
 void Builtin::InitializeBuiltinObjects(VM* vm) {
   InitializeBaseObjects(vm);
   InitializeArrayObjects(vm);
@@ -94,6 +126,7 @@ void Builtin::InitializeBaseObjects(VM* vm) {
   JSHandle<JSFunction> obj_ctor = factory->NewObject(
     JSFunction::SIZE, JSType::JS_FUNCTION, ObjectClassType::FUNCTION,
     func_proto.As<JSValue>(), true, true, false).As<JSFunction>();
+  obj_ctor->SetCallKind(CallKind::OBJECT_CONSTRUCTOR);
   
   // Initialize Function Constructor
   // The Function constructor is itself a Function object and its [[Class]] is "Function".
@@ -103,6 +136,7 @@ void Builtin::InitializeBaseObjects(VM* vm) {
   JSHandle<JSFunction> func_ctor = factory->NewObject(
     JSFunction::SIZE, JSType::JS_FUNCTION, ObjectClassType::FUNCTION,
     func_proto.As<JSValue>(), true, true, false).As<JSFunction>();
+  func_ctor->SetCallKind(CallKind::FUNCTION_CONSTRUCTOR);
 
   
   vm->SetGlobalObject(global_obj);
@@ -139,6 +173,7 @@ void Builtin::InitializeArrayObjects(VM* vm) {
   JSHandle<JSFunction> arr_ctor = factory->NewObject(
     JSFunction::SIZE, JSType::JS_FUNCTION, ObjectClassType::FUNCTION,
     vm->GetFunctionPrototype().As<JSValue>(), true, true, false).As<JSFunction>();
+  arr_ctor->SetCallKind(CallKind::ARRAY_CONSTRUCTOR);
   
   vm->SetArrayPrototype(arr_proto);
   vm->SetArrayConstructor(arr_ctor);
@@ -165,6 +200,7 @@ void Builtin::InitializeStringObjects(VM *vm) {
   JSHandle<JSFunction> str_ctor = factory->NewObject(
     JSFunction::SIZE, JSType::JS_FUNCTION, ObjectClassType::FUNCTION,
     vm->GetFunctionPrototype().As<JSValue>(), true, true, false).As<JSFunction>();
+  str_ctor->SetCallKind(CallKind::STRING_CONSTRUCTOR);
 
   vm->SetStringPrototype(str_proto);
   vm->SetStringConstructor(str_ctor);
@@ -189,6 +225,7 @@ void Builtin::InitializeBooleanObjects(VM* vm) {
   JSHandle<JSFunction> bool_ctor = factory->NewObject(
     JSFunction::SIZE, JSType::JS_FUNCTION, ObjectClassType::FUNCTION,
     vm->GetFunctionPrototype().As<JSValue>(), true, true, false).As<JSFunction>();
+  bool_ctor->SetCallKind(CallKind::BOOLEAN_CONSTRUCTOR);
 
   vm->SetBooleanPrototype(bool_proto);
   vm->SetBooleanConstructor(bool_ctor);
@@ -218,6 +255,7 @@ void Builtin::InitializeNumberObjects(VM* vm) {
   JSHandle<JSFunction> num_ctor = factory->NewObject(
     JSFunction::SIZE, JSType::JS_FUNCTION, ObjectClassType::FUNCTION,
     vm->GetFunctionPrototype().As<JSValue>(), true, true, false).As<JSFunction>();
+  num_ctor->SetCallKind(CallKind::NUMBER_CONSTRUCTOR);
 
   vm->SetNumberPrototype(num_proto);
   vm->SetNumberConstructor(num_ctor);
@@ -260,6 +298,7 @@ void Builtin::InitializeErrorObjects(VM* vm) {
   JSHandle<JSFunction> error_ctor = factory->NewObject(
     JSError::SIZE, JSType::JS_ERROR, ObjectClassType::FUNCTION,
     vm->GetFunctionPrototype().As<JSValue>(), true, true, false).As<JSFunction>();
+  error_ctor->SetCallKind(CallKind::ERROR_CONSTRUCTOR);
 
   // Initialize Native Error Object, which includes
   // EvalError Prototype, EvalError Constructor, 
@@ -329,6 +368,7 @@ JSHandle<JSFunction> Builtin::InstantiatingFunctionDeclaration(
   JSHandle<JSFunction> F = factory->NewObject(
     JSFunction::SIZE, JSType::JS_FUNCTION, ObjectClassType::FUNCTION,
     vm->GetFunctionPrototype().As<JSValue>(), true, true, true).As<JSFunction>();
+  F->SetCallKind(CallKind::JS_FUNCTION);
   F->SetCode(ast_node);
   F->SetScope(scope.As<JSValue>());
   
@@ -348,26 +388,14 @@ JSHandle<JSFunction> Builtin::InstantiatingFunctionDeclaration(
   ///    Property Descriptor {[[Value]]: len, [[Writable]]: false, [[Enumerable]]: false,
   //     [[Configurable]]: false}, and false.
   types::Object::DefineOwnProperty(vm, F, constants->HandledLengthString(),
-                                   types::PropertyDescriptor{vm, JSHandle<JSValue>{vm, JSValue{len}}, false, false, false}, false);
+                                   types::PropertyDescriptor{vm, JSHandle<JSValue>{vm, JSValue{static_cast<std::int32_t>(len)}}, false, false, false}, false);
   RETURN_HANDLE_IF_HAS_EXCEPTION(vm, JSFunction);
   
-  // 16. Let proto be the result of creating a new object as would be constructed by the expression new Object()
-  //     where Object is the standard built-in constructor with that name.
-  JSHandle<JSObject> proto = types::Object::Construct(
-    vm, vm->GetObjectConstructor(),
-    vm->GetGlobalConstants()->HandledUndefined(), {}).As<JSObject>();
-  
-  // 17. Call the [[DefineOwnProperty]] internal method of proto with arguments "constructor",
-  ///    Property Descriptor {[[Value]]: F, { [[Writable]]: true, [[Enumerable]]: false,
-  //     [[Configurable]]: true}, and false.
-  types::Object::DefineOwnProperty(vm, proto, constants->HandledConstructorString(),
-                                   types::PropertyDescriptor{vm, F.As<JSValue>(), true, false, true}, false);
-  
-  // 18. Call the [[DefineOwnProperty]] internal method of F with arguments "prototype",
-  //     Property Descriptor {[[Value]]: proto, { [[Writable]]: true, [[Enumerable]]: false,
-  //     [[Configurable]]: false}, and false.
-  types::Object::DefineOwnProperty(vm, F, constants->HandledPrototypeString(),
-                                   types::PropertyDescriptor{vm, proto.As<JSValue>(), true, false, false}, false);
+  // 16. - 18. proto is only created when the prototype property is first read, by NewFunctionPrototype.
+  //     Until then the property holds F itself, most functions are never used with new.
+  auto prop_map = JSHandle<types::PropertyMap>{vm, F->GetProperties()};
+  F->SetProperties(types::PropertyMap::SetLazyProperty(
+    vm, prop_map, constants->HandledPrototypeString(), F.As<JSValue>(), true, false, false).As<JSValue>());
   
   // 19. If Strict is true, then
   if (strict) {
@@ -817,11 +845,45 @@ void Builtin::SetDataProperty(VM* vm, JSHandle<types::Object> obj, JSHandle<type
   obj->SetProperties(types::PropertyMap::SetProperty(vm, prop_map, prop_name, desc).As<JSValue>());
 }
 
+// The function of a method in METHODS is only created when the property is first read,
+// most scripts touch a small part of the builtin methods.
 void Builtin::SetFunctionProperty(VM* vm, JSHandle<types::Object> obj, JSHandle<types::String> prop_name, InternalFunctionType func,
                                   bool writable, bool enumerable, bool configurable) {
-  SetDataProperty(vm, obj, prop_name,
-                  vm->GetObjectFactory()->NewInternalFunction(func).As<JSValue>(),
-                  writable, enumerable, configurable);
+  auto index = std::find(METHODS, METHODS + METHOD_NUM, func) - METHODS;
+  if (index == METHOD_NUM) {
+    SetDataProperty(vm, obj, prop_name,
+                    vm->GetObjectFactory()->NewInternalFunction(func).As<JSValue>(),
+                    writable, enumerable, configurable);
+    return;
+  }
+
+  auto prop_map = JSHandle<types::PropertyMap>{vm, obj->GetProperties()};
+  obj->SetProperties(types::PropertyMap::SetLazyProperty(
+    vm, prop_map, prop_name, JSHandle<JSValue>{vm, JSValue{static_cast<std::int32_t>(index)}},
+    writable, enumerable, configurable).As<JSValue>());
+}
+
+JSHandle<types::InternalFunction> Builtin::NewLazyMethod(VM* vm, std::int32_t index) {
+  return vm->GetObjectFactory()->NewInternalFunction(METHODS[index]);
+}
+
+// Steps 16 and 17 of 13.2, the caller stores proto as the value of the prototype property of F (step 18)
+JSHandle<JSObject> Builtin::NewFunctionPrototype(VM* vm, JSHandle<JSFunction> F) {
+  GlobalConstants* constants = vm->GetGlobalConstants();
+
+  // 16. Let proto be the result of creating a new object as would be constructed by the expression new Object()
+  //     where Object is the standard built-in constructor with that name.
+  JSHandle<JSObject> proto = types::Object::Construct(
+    vm, vm->GetObjectConstructor(),
+    vm->GetGlobalConstants()->HandledUndefined(), {}).As<JSObject>();
+  
+  // 17. Call the [[DefineOwnProperty]] internal method of proto with arguments "constructor",
+  ///    Property Descriptor {[[Value]]: F, { [[Writable]]: true, [[Enumerable]]: false,
+  //     [[Configurable]]: true}, and false.
+  types::Object::DefineOwnProperty(vm, proto, constants->HandledConstructorString(),
+                                   types::PropertyDescriptor{vm, F.As<JSValue>(), true, false, true}, false);
+
+  return proto;
 }
 
 }  // namespace builtins
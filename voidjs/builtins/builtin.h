@@ -11,6 +11,7 @@ namespace voidjs {
 namespace types {
 
 class LexicalEnvironment;
+class InternalFunction;
 
 }  // namespace types
 
@@ -51,6 +52,12 @@ class Builtin {
                               bool writable, bool enumerable, bool configurable);
   static void SetFunctionProperty(VM* vm, JSHandle<types::Object> obj, JSHandle<types::String> prop_name, InternalFunctionType func,
                                  bool writable, bool enumerable, bool configurable);
+
+  // Creates the function of a lazy property set by SetFunctionProperty
+  static JSHandle<types::InternalFunction> NewLazyMethod(VM* vm, std::int32_t index);
+
+  // Creates the value of the lazy prototype property set by InstantiatingFunctionDeclaration
+  static JSHandle<JSObject> NewFunctionPrototype(VM* vm, JSHandle<JSFunction> F);
 };
 
 }  // namespace builtins
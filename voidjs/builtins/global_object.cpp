@@ -6,6 +6,7 @@
 #include "voidjs/types/js_value.h"
 #include "voidjs/types/lang_types/number.h"
 #include "voidjs/types/lang_types/string.h"
+#include "voidjs/types/lang_types/string_builder.h"
 #include "voidjs/interpreter/runtime_call_info.h"
 #include "voidjs/utils/helper.h"
 
@@ -51,17 +52,18 @@ JSValue GlobalObject::Print(RuntimeCallInfo* argv) {
   JSHandleScope handle_scope{vm};
   std::size_t args_num = argv->GetArgsNum();
 
-  std::string output_string;
+  types::StringBuilder builder{vm};
   for (std::size_t idx = 0; idx < args_num; ++idx) {
     if (idx != 0) {
-      output_string.push_back(' ');
+      builder.Append(u' ');
     }
     JSHandle<JSValue> value = argv->GetArg(idx);
     JSHandle<types::String> string = JSValue::ToString(vm, value);
-    output_string += utils::U16StrToU8Str(std::u16string{string->GetString()});
+    RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
+    builder.Append(string);
   }
 
-  std::cout << output_string << std::endl;
+  std::cout << utils::U16StrToU8Str(builder.Build()->GetString()) << std::endl;
 
   return JSValue::Undefined();
 }
@@ -1,5 +1,7 @@
 #include "voidjs/builtins/js_array.h"
 
+#include <optional>
+
 #include "voidjs/types/js_value.h"
 #include "voidjs/types/heap_object.h"
 #include "voidjs/types/object_factory.h"
@@ -7,6 +9,7 @@
 #include "voidjs/types/lang_types/number.h"
 #include "voidjs/types/lang_types/object.h"
 #include "voidjs/types/lang_types/string.h"
+#include "voidjs/types/lang_types/string_builder.h"
 #include "voidjs/types/spec_types/property_descriptor.h"
 #include "voidjs/builtins/builtin.h"
 #include "voidjs/builtins/js_function.h"
@@ -14,6 +17,7 @@
 #include "voidjs/gc/js_handle_scope.h"
 #include "voidjs/interpreter/global_constants.h"
 #include "voidjs/interpreter/runtime_call_info.h"
+#include "voidjs/interpreter/prepared_call.h"
 #include "voidjs/utils/macros.h"
 
 namespace voidjs {
@@ -289,17 +293,16 @@ JSValue JSArray::ToString(RuntimeCallInfo* argv) {
   VM* vm = argv->GetVM();
   JSHandleScope handle_scope{vm};
   JSHandle<JSValue> this_value = argv->GetThis();
-  ObjectFactory* factory = vm->GetObjectFactory();
   
   // 1. Let array be the result of calling ToObject on the this value.
   JSHandle<JSArray> array = this_value.As<JSArray>();
   
   // 2. Let func be the result of calling the [[Get]] internal method of array with argument "join".
-  JSHandle<JSValue> func = types::Object::Get(vm, array, factory->NewString(u"join"));
+  JSHandle<JSValue> func = types::Object::Get(vm, array, vm->GetGlobalConstants()->HandledJoinString());
   
   // 3. If IsCallable(func) is false, then let func be the standard built-in method Object.prototype.toString (15.2.4.2).
   if (!func.As<types::Object>()->GetCallable()) {
-    func = types::Object::Get(vm, vm->GetObjectPrototype(), factory->NewString(u"toString"));
+    func = types::Object::Get(vm, vm->GetObjectPrototype(), vm->GetGlobalConstants()->HandledToStringString());
   }
   
   // 4. Return the result of calling the [[Call]] internal method of func providing array as the this value and an empty arguments list.
@@ -411,49 +414,54 @@ JSValue JSArray::Join(RuntimeCallInfo* argv) {
   
   // 4. If separator is undefined, let separator be the single-character String ",".
   if (separator->IsUndefined()) {
-    separator = factory->NewString(u",").As<JSValue>();
+    separator = vm->GetGlobalConstants()->HandledCommaString().As<JSValue>();
   }
   
   // 5. Let sep be ToString(separator).
   JSHandle<types::String> sep = JSValue::ToString(vm, separator);
+  RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
   
   // 6. If len is zero, return the empty String.
   if (len == 0) {
     return JSValue{vm->GetGlobalConstants()->EmptyString()};
   }
+
+  // Every element is converted first, in the same order as the steps below,
+  // so that R can be built with a single allocation once its length is known.
+  std::vector<JSHandle<types::String>> nexts;
+  nexts.reserve(len);
+  std::size_t total_length = sep->GetLength() * (len - 1);
   
   // 7. Let element0 be the result of calling the [[Get]] internal method of O with argument "0".
-  JSHandle<JSValue> element0 = types::Object::Get(vm, O, vm->GetGlobalConstants()->HandledZeroString());
-  
+  // 10.b. Let element be the result of calling the [[Get]] internal method of O with argument ToString(k).
   // 8. If element0 is undefined or null, let R be the empty String;
   //    otherwise, Let R be ToString(element0).
-  JSHandle<types::String> R = element0->IsUndefined() || element0->IsNull() ?
-    vm->GetGlobalConstants()->HandledEmptyString() : JSValue::ToString(vm, element0);
-  
-  // 9. Let k be 1.
-  std::int32_t k = 1;
-  
-  // 10. Repeat, while k < len
-  while (k < len) {
-    // a. Let S be the String value produced by concatenating R and sep.
-    JSHandle<types::String> S = types::String::Concat(vm, R, sep);
-    
-    // b. Let element be the result of calling the [[Get]] internal method of O with argument ToString(k).
+  // 10.c. If element is undefined or null, Let next be the empty String; otherwise, let next be ToString(element).
+  for (std::int32_t k = 0; k < len; ++k) {
     JSHandle<JSValue> element = types::Object::Get(vm, O, factory->NewStringFromInt(k));
+    RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
     
-    // c. If element is undefined or null, Let next be the empty String; otherwise, let next be ToString(element).
     JSHandle<types::String> next = element->IsUndefined() || element->IsNull() ?
       vm->GetGlobalConstants()->HandledEmptyString() : JSValue::ToString(vm, element);
+    RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
     
-    // d. Let R be a String value produced by concatenating S and next.
-    R = types::String::Concat(vm, S, next);
-    
-    // e. Increase k by 1.
-    ++k;
+    nexts.push_back(next);
+    total_length += next->GetLength();
+  }
+
+  // 9. Let k be 1.
+  // 10. Repeat, while k < len
+  //     a. Let S be the String value produced by concatenating R and sep.
+  //     d. Let R be a String value produced by concatenating S and next.
+  types::StringBuilder R{vm, total_length};
+  R.Append(nexts[0]);
+  for (std::int32_t k = 1; k < len; ++k) {
+    R.Append(sep);
+    R.Append(nexts[k]);
   }
   
   // 11. Return R.
-  return R.GetJSValue();
+  return R.Build().GetJSValue();
 }
 
 // Array.prototype.pop()
@@ -815,7 +823,12 @@ JSValue JSArray::Sort(RuntimeCallInfo* argv) {
     }
   }
 
-  std::sort(tmp.begin(), tmp.end(), [=](JSHandle<JSValue> j, JSHandle<JSValue> k) mutable {
+  std::optional<PreparedCall> call;
+  if (!comparefn->IsUndefined()) {
+    call.emplace(vm, comparefn.As<types::Object>(), vm->GetGlobalConstants()->HandledUndefined(), 2);
+  }
+
+  std::sort(tmp.begin(), tmp.end(), [&](JSHandle<JSValue> j, JSHandle<JSValue> k) {
     if (k.IsEmpty()) {
       return true;
     }
@@ -854,8 +867,9 @@ JSValue JSArray::Sort(RuntimeCallInfo* argv) {
       // a. If IsCallable(comparefn) is false, throw a TypeError exception.
       // b. Return the result of calling the [[Call]] internal method of comparefn passing
       //    undefined as the this value and with arguments x and y.
-      JSHandle<JSValue> ret = types::Object::Call(vm, comparefn.As<types::Object>(),
-                                                  vm->GetGlobalConstants()->HandledUndefined(), {x, y});
+      call->SetArg(0, x);
+      call->SetArg(1, y);
+      JSHandle<JSValue> ret = call->Invoke();
       RETURN_VALUE_IF_HAS_EXCEPTION(vm, false);
       return JSValue::ToNumber(vm, ret).GetNumber() < 0;
     }
@@ -913,11 +927,16 @@ JSValue JSArray::ForEach(RuntimeCallInfo* argv) {
   }
   
   // 5. If thisArg was supplied, let T be thisArg; else let T be undefined.
+  PreparedCall call{vm, callbackfn.As<types::Object>(), this_arg, 3};
+  call.SetArg(2, O.As<JSValue>());
+  
   // 6. Let k be 0.
   std::uint32_t k = 0;
   
   // 7. Repeat, while k < len
   while (k < len) {
+    JSHandleScope iteration_scope{vm};
+    
     // a. Let Pk be ToString(k).
     JSHandle<types::String> pk = factory->NewStringFromInt(k);
     
@@ -928,9 +947,13 @@ JSValue JSArray::ForEach(RuntimeCallInfo* argv) {
     if (k_present) {
       // i. Let kValue be the result of calling the [[Get]] internal method of O with argument Pk.
       JSHandle<JSValue> k_value = types::Object::Get(vm, O, pk);
+      RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
       
       // ii. Call the [[Call]] internal method of callbackfn with T as the this value and argument list containing kValue, k, and O.
-      types::Object::Call(vm, callbackfn.As<types::Object>(), this_arg, {k_value, JSHandle<JSValue>{vm, JSValue{k}}, O.As<JSValue>()});
+      call.SetArg(0, k_value);
+      call.SetArg(1, JSValue{k});
+      call.Invoke();
+      RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
     }
 
     // d. Increase k by 1.
@@ -977,8 +1000,13 @@ JSValue JSArray::Map(RuntimeCallInfo* argv) {
   // 7. Let k be 0.
   std::uint32_t k = 0;
   
+  PreparedCall call{vm, callbackfn.As<types::Object>(), T, 3};
+  call.SetArg(2, O.As<JSValue>());
+  
   // 8. Repeat, while k < len
   while (k < len) {
+    JSHandleScope iteration_scope{vm};
+    
     // a. Let Pk be ToString(k).
     JSHandle<types::String> pk = factory->NewStringFromInt(k);
     
@@ -989,11 +1017,13 @@ JSValue JSArray::Map(RuntimeCallInfo* argv) {
     if (k_present) {
       // i. Let kValue be the result of calling the [[Get]] internal method of O with argument Pk.
       JSHandle<JSValue> k_value = types::Object::Get(vm, O, pk);
+      RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
       
       // ii. Let mappedValue be the result of calling the [[Call]] internal method of callbackfn with
       ///    T as the this value and argument list containing kValue, k, and O.
-      auto mapped_value = types::Object::Call(
-        vm, callbackfn.As<types::Object>(), T, {k_value, JSHandle<JSValue>{vm, JSValue{k}}, O.As<JSValue>()});
+      call.SetArg(0, k_value);
+      call.SetArg(1, JSValue{k});
+      auto mapped_value = call.Invoke();
       RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
       
       // iii. Call the [[DefineOwnProperty]] internal method of A with arguments Pk,
@@ -1049,8 +1079,13 @@ JSValue JSArray::Filter(RuntimeCallInfo* argv) {
   // 8. Let to be 0.
   std::uint32_t to = 0;
   
+  PreparedCall call{vm, callbackfn.As<types::Object>(), T, 3};
+  call.SetArg(2, O.As<JSValue>());
+  
   // 9. Repeat, while k < len
   while (k < len) {
+    JSHandleScope iteration_scope{vm};
+    
     // a. Let Pk be ToString(k).
     JSHandle<types::String> pk = factory->NewStringFromInt(k);
     
@@ -1061,11 +1096,14 @@ JSValue JSArray::Filter(RuntimeCallInfo* argv) {
     if (k_present) {
       // i. Let kValue be the result of calling the [[Get]] internal method of O with argument Pk.
       JSHandle<JSValue> k_value = types::Object::Get(vm, O, pk);
+      RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
       
       // ii. Let selected be the result of calling the [[Call]] internal method of
       //     callbackfn with T as the this value and argument list containing kValue, k, and O.
-      JSHandle<JSValue> selected = types::Object::Call(
-        vm, callbackfn.As<types::Object>(), T, {k_value, JSHandle<JSValue>{vm, JSValue{k}}, O.As<JSValue>()});
+      call.SetArg(0, k_value);
+      call.SetArg(1, JSValue{k});
+      JSHandle<JSValue> selected = call.Invoke();
+      RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
       
       // iii. If ToBoolean(selected) is true, then
       if (JSValue::ToBoolean(vm, selected)) {
@@ -5,6 +5,7 @@
 #include "voidjs/types/js_value.h"
 #include "voidjs/types/object_class_type.h"
 #include "voidjs/types/object_factory.h"
+#include "voidjs/types/lang_types/string_builder.h"
 #include "voidjs/builtins/builtin.h"
 #include "voidjs/gc/js_handle_scope.h"
 #include "voidjs/interpreter/runtime_call_info.h"
@@ -57,7 +58,6 @@ JSValue JSError::ToString(RuntimeCallInfo* argv) {
   VM* vm = argv->GetVM();
   JSHandleScope handle_scope{vm};
   JSHandle<JSValue> this_value = argv->GetThis();
-  ObjectFactory* factory = vm->GetObjectFactory();
 
   // 1. Let O be the this value.
   // 2. If Type(O) is not Object, throw a TypeError exception.
@@ -68,14 +68,14 @@ JSValue JSError::ToString(RuntimeCallInfo* argv) {
   JSHandle<types::Object> O = this_value.As<types::Object>();
   
   // 3. Let name be the result of calling the [[Get]] internal method of O with argument "name".
-  JSHandle<JSValue> name_prop = types::Object::Get(vm, O, factory->NewString(u"name"));
+  JSHandle<JSValue> name_prop = types::Object::Get(vm, O, vm->GetGlobalConstants()->HandledNameString());
   
   // 4. If name is undefined, then let name be "Error"; else let name be ToString(name).
   JSHandle<types::String> name = name_prop->IsUndefined() ? 
-    factory->NewString(u"Error") : JSValue::ToString(vm, name_prop);
+    vm->GetGlobalConstants()->HandledErrorString() : JSValue::ToString(vm, name_prop);
   
   // 5. Let msg be the result of calling the [[Get]] internal method of O with argument "message".
-  JSHandle<JSValue> msg_prop = types::Object::Get(vm, O, factory->NewString(u"message"));
+  JSHandle<JSValue> msg_prop = types::Object::Get(vm, O, vm->GetGlobalConstants()->HandledMessageString());
   
   // 6. If msg is undefined, then let msg be the empty String; else let msg be ToString(msg).
   JSHandle<types::String> msg = msg_prop->IsUndefined() ?
@@ -83,7 +83,7 @@ JSValue JSError::ToString(RuntimeCallInfo* argv) {
   
   // 7. If name and msg are both the empty String, return "Error".
   if (name->IsEmptyString() && msg->IsEmptyString()) {
-    return factory->NewString(u"Error").GetJSValue();
+    return JSValue{vm->GetGlobalConstants()->ErrorString()};
   }
   
   // 8. If name is the empty String, return msg.
@@ -97,7 +97,12 @@ JSValue JSError::ToString(RuntimeCallInfo* argv) {
   }
   
   // 10. Return the result of concatenating name, ":", a single space character, and msg.
-  return types::String::Concat(vm, name, factory->NewString(u": "), msg).GetJSValue();
+  constexpr std::u16string_view colon = u": ";
+  types::StringBuilder builder{vm, name->GetLength() + colon.size() + msg->GetLength()};
+  builder.Append(name);
+  builder.Append(colon);
+  builder.Append(msg);
+  return builder.Build().GetJSValue();
 }
 
 // EvalError(message)
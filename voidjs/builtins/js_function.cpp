@@ -1,15 +1,22 @@
 #include "voidjs/builtins/js_function.h"
 
+#include <algorithm>
+
 #include "voidjs/interpreter/runtime_call_info.h"
 #include "voidjs/ir/ast.h"
 #include "voidjs/parser/parser.h"
 #include "voidjs/types/heap_object.h"
 #include "voidjs/types/js_value.h"
+#include "voidjs/types/lang_types/number.h"
 #include "voidjs/types/lang_types/string.h"
 #include "voidjs/types/object_factory.h"
+#include "voidjs/types/internal_types/array.h"
+#include "voidjs/types/internal_types/property_map.h"
 #include "voidjs/builtins/builtin.h"
+#include "voidjs/builtins/bound_function.h"
 #include "voidjs/gc/js_handle.h"
 #include "voidjs/interpreter/global_constants.h"
+#include "voidjs/utils/helper.h"
 #include "voidjs/utils/macros.h"
 
 namespace voidjs {
@@ -124,6 +131,7 @@ JSValue JSFunction::FunctionConstructorConstruct(RuntimeCallInfo* argv) {
     auto str = u"function (" + P + u") {" + body_str + u"}";
     Parser parser(u"function (" + P + u") {" + body_str + u"}");
     func_expr = parser.ParseFunctionExpression();
+    vm->AddArena(parser.ReleaseArena());
   } catch (const utils::Error& error) {
     THROW_SYNTAX_ERROR_AND_RETURN_VALUE(
       vm, u"Wrong arguments for new Function(p1, p2, ..., pn, body)", JSValue{});
@@ -185,9 +193,24 @@ JSValue JSFunction::Apply(RuntimeCallInfo* argv) {
   
   // 5. Let n be ToUint32(len).
   std::uint32_t n = JSValue::ToUint32(vm, len);
+  RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
+  if (n > MAX_APPLY_ARGS_NUM) {
+    THROW_RANGE_ERROR_AND_RETURN_VALUE(vm, u"Too many arguments when using Function.prototype.apply.", JSValue{});
+  }
   
   // 6. Let argList be an empty List.
   std::vector<JSHandle<JSValue>> arg_list;
+
+  // Arrays and unmapped arguments objects keep their elements as own data properties,
+  // which are read from their PropertyMap without going through [[Get]].
+  // Their PropertyMap also bounds how many elements there really are, n alone may be far larger.
+  // Arrays never count as ordinary for their [[DefineOwnProperty]], but their [[Get]] is ordinary.
+  JSHandle<types::Object> obj = arg_array.As<types::Object>();
+  bool own_elements = obj->IsJSArray() || (obj->IsArguments() && obj->IsOrdinary());
+  if (own_elements) {
+    std::uint32_t prop_num = obj->GetProperties().GetHeapObject()->AsPropertyMap()->GetBucketSize();
+    arg_list.reserve(std::min(n, prop_num));
+  }
   
   // 7. Let index be 0.
   std::uint32_t index = 0;
@@ -198,10 +221,15 @@ JSValue JSFunction::Apply(RuntimeCallInfo* argv) {
     JSHandle<types::String> index_name = factory->NewStringFromInt(index);
     
     // b. Let nextArg be the result of calling the [[Get]] internal method of argArray with indexName as the argument.
-    JSHandle<JSValue> next_arg = types::Object::Get(vm, arg_array.As<types::Object>(), index_name);
-    
     // c. Append nextArg as the last element of argList.
-    arg_list.push_back(next_arg);
+    auto props = obj->GetProperties().GetHeapObject()->AsPropertyMap();
+    auto entry = own_elements ? props->FindProperty(index_name) : types::PropertyMap::NOT_FOUND;
+    if (entry != types::PropertyMap::NOT_FOUND && !types::PropertyMap::IsAccessor(props->GetPropertyAttributes(entry))) {
+      arg_list.emplace_back(vm, props->GetPropertyValue(vm, entry));
+    } else {
+      arg_list.push_back(types::Object::Get(vm, obj, index_name));
+      RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
+    }
     
     // d. Set index to index + 1.
     ++index;
@@ -219,7 +247,6 @@ JSValue JSFunction::Call(RuntimeCallInfo* argv) {
   JSHandle<JSValue> this_value = argv->GetThis();
   JSHandle<JSValue> this_arg = argv->GetArg(0);
   std::uint64_t args_num = argv->GetArgsNum();
-  ObjectFactory* factory = vm->GetObjectFactory();
   
   // 1. If IsCallable(func) is false, then throw a TypeError exception.
   if (!this_value->IsObject() || !this_value->GetHeapObject()->GetCallable()) {
@@ -227,19 +254,109 @@ JSValue JSFunction::Call(RuntimeCallInfo* argv) {
   }
   
   // 2. Let argList be an empty List.
-  std::vector<JSHandle<JSValue>> arg_list;
-  
   // 3. If this method was called with more than one argument then in left to right order starting with arg1 append each argument as the last element of argList
-  for (std::size_t idx = 1; idx < args_num; ++idx) {
-    arg_list.push_back(argv->GetArg(idx));
+  //    The handles refer to the arguments of this call in place, no value is copied.
+  std::vector<JSHandle<JSValue>> arg_list;
+  if (args_num > 1) {
+    arg_list.reserve(args_num - 1);
+    for (std::size_t idx = 1; idx < args_num; ++idx) {
+      arg_list.push_back(argv->GetArg(idx));
+    }
   }
   
   // 4. Return the result of calling the [[Call]] internal method of func, providing thisArg as the this value and argList as the list of arguments.
   return types::Object::Call(vm, this_value.As<types::Object>(), this_arg, arg_list).GetJSValue();
 }
 
+// Function.prototype.bind (thisArg [, arg1 [, arg2, …]])
+// Defined in ECMAScript 5.1 Chapter 15.3.4.5
 JSValue JSFunction::Bind(RuntimeCallInfo* argv) {
-  return {};
+  VM* vm = argv->GetVM();
+  JSHandleScope handle_scope{vm};
+  ObjectFactory* factory = vm->GetObjectFactory();
+  std::uint64_t args_num = argv->GetArgsNum();
+  
+  // 1. Let Target be the this value.
+  JSHandle<JSValue> target = argv->GetThis();
+  
+  // 2. If IsCallable(Target) is false, throw a TypeError exception.
+  if (!target->IsCallable()) {
+    THROW_TYPE_ERROR_AND_RETURN_VALUE(vm, u"Bind must be called on a function.", JSValue{});
+  }
+  
+  // 3. Let A be a new (possibly empty) internal list of all of the argument values provided after thisArg (arg1, arg2 etc), in order.
+  std::size_t a_num = args_num > 1 ? args_num - 1 : 0;
+
+  // 15. If the [[Class]] internal property of Target is "Function", then
+  //     a. Let L be the length property of Target minus the length of A.
+  //     b. Set the length own property of F to either 0 or L, whichever is larger.
+  // 16. Else set the length own property of F to 0.
+  double length = 0;
+  if (target.As<types::Object>()->GetClassType() == ObjectClassType::FUNCTION) {
+    auto target_len = types::Object::Get(vm, target.As<types::Object>(), vm->GetGlobalConstants()->HandledLengthString());
+    RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
+    length = std::max(0.0, JSValue::ToInteger(vm, target_len).GetNumber() - a_num);
+  }
+  
+  // Calling a bound function calls its [[TargetFunction]] with its own [[BoundThis]] and [[BoundArgs]] first,
+  // so binding it again is the same as binding its target with the two lists joined.
+  JSHandle<JSValue> bound_this = argv->GetArg(0);
+  JSHandle<types::Array> inner_args;
+  if (target->GetHeapObject()->IsBoundFunction()) {
+    auto inner = target.As<BoundFunction>();
+    bound_this = JSHandle<JSValue>{vm, inner->GetBoundThis()};
+    inner_args = JSHandle<types::Array>{vm, inner->GetBoundArgs()};
+    target = JSHandle<JSValue>{vm, inner->GetTargetFunction()};
+  }
+  std::size_t inner_num = inner_args.IsEmpty() ? 0 : inner_args->GetLength();
+  
+  JSHandle<types::Array> bound_args = factory->NewArray(inner_num + a_num);
+  for (std::size_t idx = 0; idx < inner_num; ++idx) {
+    bound_args->Set(idx, inner_args->Get(idx));
+  }
+  for (std::size_t idx = 0; idx < a_num; ++idx) {
+    bound_args->Set(inner_num + idx, argv->GetArg(idx + 1));
+  }
+  
+  // 4. Let F be a new native ECMAScript object .
+  // 5. Set all the internal methods, except for [[Get]], of F as specified in 8.12.
+  // 6. Set the [[Get]] internal property of F as specified in 15.3.5.4.
+  // 10. Set the [[Class]] internal property of F to "Function".
+  // 11. Set the [[Prototype]] internal property of F to the standard built-in Function prototype object as specified in 15.3.3.1.
+  // 12. Set the [[Call]] internal property of F as described in 15.3.4.5.1.
+  // 13. Set the [[Construct]] internal property of F as described in 15.3.4.5.2.
+  // 14. Set the [[HasInstance]] internal property of F as described in 15.3.4.5.3.
+  // 18. Set the [[Extensible]] internal property of F to true.
+  JSHandle<BoundFunction> F = factory->NewObject(
+    BoundFunction::SIZE, JSType::BOUND_FUNCTION, ObjectClassType::FUNCTION,
+    vm->GetFunctionPrototype().As<JSValue>(), true, true, false).As<BoundFunction>();
+  F->SetCallKind(CallKind::BOUND_FUNCTION);
+  
+  // 7. Set the [[TargetFunction]] internal property of F to Target.
+  F->SetTargetFunction(target);
+  
+  // 8. Set the [[BoundThis]] internal property of F to the value of thisArg.
+  F->SetBoundThis(bound_this);
+  
+  // 9. Set the [[BoundArgs]] internal property of F to A.
+  F->SetBoundArgs(bound_args.As<JSValue>());
+  
+  // 17. Set the attributes of the length own property of F to the values specified in 15.3.5.1.
+  JSValue length_val = utils::CanDoubleConvertToInt32(length) ?
+    JSValue{static_cast<std::int32_t>(length)} : JSValue{length};
+  Builtin::SetDataProperty(vm, F, vm->GetGlobalConstants()->HandledLengthString(),
+                           JSHandle<JSValue>{vm, length_val}, false, false, false);
+  
+  // 19. Let thrower be the [[ThrowTypeError]] function Object (13.2.3).
+  // 20. Call the [[DefineOwnProperty]] internal method of F with arguments "caller",
+  //     PropertyDescriptor {[[Get]]: thrower, [[Set]]: thrower, [[Enumerable]]: false, [[Configurable]]: false}, and false.
+  // 21. Call the [[DefineOwnProperty]] internal method of F with arguments "arguments",
+  //     PropertyDescriptor {[[Get]]: thrower, [[Set]]: thrower, [[Enumerable]]: false, [[Configurable]]: false}, and false.
+  //     The [[ThrowTypeError]] function Object does not exist yet, strict functions and
+  //     strict arguments objects skip these accessors too, so F is left without them.
+  
+  // 22. Return F.
+  return F.GetJSValue();
 }
 
 }  // namespace builtins
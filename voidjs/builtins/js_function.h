@@ -29,6 +29,10 @@ class JSFunction : public types::Object {
   static constexpr std::size_t END_OFFSET = types::Object::END_OFFSET + SIZE;
   static_assert(SIZE == 16);
 
+  // Longest argument list built by Function.prototype.apply,
+  // a longer length of argArray throws a RangeError instead of exhausting memory.
+  static constexpr std::uint32_t MAX_APPLY_ARGS_NUM = 1 << 20;
+
   // [[HasInstance]](V)
   static bool HasInstance(VM* vm, JSHandle<JSFunction> F, JSHandle<JSValue> V);
   static JSHandle<JSValue> Get(VM* vm, JSHandle<JSFunction> O, JSHandle<types::String> P);
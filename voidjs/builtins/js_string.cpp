@@ -11,6 +11,7 @@
 #include "voidjs/types/lang_types/number.h"
 #include "voidjs/types/lang_types/object.h"
 #include "voidjs/types/lang_types/string.h"
+#include "voidjs/types/lang_types/string_builder.h"
 #include "voidjs/interpreter/runtime_call_info.h"
 #include "voidjs/interpreter/global_constants.h"
 #include "voidjs/interpreter/vm.h"
@@ -112,6 +113,10 @@ JSValue JSString::FromCharCode(RuntimeCallInfo* argv) {
   std::size_t args_num = argv->GetArgsNum();
   ObjectFactory* factory = vm->GetObjectFactory();
 
+  if (args_num == 1) {
+    return factory->NewStringFromChar(JSValue::ToUint16(vm, argv->GetArg(0))).GetJSValue();
+  }
+
   std::u16string result;
   for (std::size_t idx = 0; idx < args_num; ++idx) {
     result += JSValue::ToUint16(vm, argv->GetArg(idx));
@@ -259,21 +264,31 @@ JSValue JSString::Concat(RuntimeCallInfo* argv) {
   
   // 3. Let args be an internal list that is a copy of the argument list passed to this function.
   
+  // Every argument is converted first,
+  // so that R can be built with a single allocation once its length is known.
+  std::size_t args_num = argv->GetArgsNum();
+  std::vector<JSHandle<types::String>> nexts;
+  nexts.reserve(args_num);
+  std::size_t total_length = S->GetLength();
+  for (std::size_t idx = 0; idx < args_num; ++idx) {
+    nexts.push_back(JSValue::ToString(vm, argv->GetArg(idx)));
+    RETURN_VALUE_IF_HAS_EXCEPTION(vm, JSValue{});
+    total_length += nexts.back()->GetLength();
+  }
+  
   // 4. Let R be S.
-  JSHandle<types::String> R = S;
+  types::StringBuilder R{vm, total_length};
+  R.Append(S);
   
   // 5. Repeat, while args is not empty
-  std::size_t args_num = argv->GetArgsNum();
-  for (std::size_t idx = 0; idx < args_num; ++idx) {
+  for (auto next : nexts) {
     // a. Remove the first element from args and let next be the value of that element.
-    JSHandle<JSValue> next = argv->GetArg(idx);
-    
     // b. Let R be the String value consisting of the characters in the previous value of R followed by the characters of ToString(next).
-    R = types::String::Concat(vm, R, JSValue::ToString(vm, next));
+    R.Append(next);
   }
   
   // 6. Return R.
-  return R.GetJSValue();
+  return R.Build().GetJSValue();
 }
 
 // String.prototype.indexOf(searchString, position)
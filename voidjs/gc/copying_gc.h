@@ -1,6 +1,7 @@
 #ifndef VOIDJS_GC_COPYING_GC_H
 #define VOIDJS_GC_COPYING_GC_H
 
+#include <atomic>
 #include <iostream>
 #include <cstdint>
 #include <cstddef>
@@ -23,6 +24,7 @@ class CopyingGC {
     tospace_ = space + size / 2;
     extent_ = size / 2; 
     alloc_ = fromspace_;
+    epoch_ = NextEpoch();
   }
 
   ~CopyingGC() {
@@ -43,6 +45,7 @@ class CopyingGC {
 
   void Collect() {
     forward_addr_map_.clear();
+    epoch_ = NextEpoch();
     
     std::swap(fromspace_, tospace_);
     alloc_ = fromspace_;
@@ -88,10 +91,23 @@ class CopyingGC {
     *reinterpret_cast<JSValue*>(handle.GetAddress()) = JSValue{addr};
   }
 
+  // Objects are allocated contiguously in [GetStart(), GetTop())
+  std::uintptr_t GetStart() const { return fromspace_; }
+  std::uintptr_t GetTop() const { return alloc_; }
+
+  // Addresses of objects only hold within an epoch, which is unique among all spaces
+  // and changes whenever objects are moved
+  std::uint64_t GetEpoch() const { return epoch_; }
+
  private:
+  static std::uint64_t NextEpoch() {
+    static std::atomic<std::uint64_t> epoch {0};
+    return ++epoch;
+  }
+
   bool InHeapSpace(std::uintptr_t addr) {
     auto [min_addr, max_addr] = std::minmax(fromspace_, tospace_);
-    return addr < min_addr || addr > max_addr;
+    return addr >= min_addr && addr < max_addr + extent_;
   }
 
  private:
@@ -101,6 +117,7 @@ class CopyingGC {
   std::uintptr_t extent_ {0};
   std::uintptr_t alloc_ {0};
   std::uintptr_t scan_ {0};
+  std::uint64_t epoch_ {0};
   
   std::unordered_map<std::uintptr_t, std::uintptr_t> forward_addr_map_;
 };
@@ -30,10 +30,16 @@ class Heap {
     }
   }
 
- private:
+  const gc::CopyingGC& GetNormalSpace() const { return normal_space_; }
+  const gc::NoGC& GetConstSpace() const { return const_space_; }
+
+  // Objects of the const space never move, so the epoch of the normal space is that of the heap
+  std::uint64_t GetEpoch() const { return normal_space_.GetEpoch(); }
+
   static constexpr std::size_t NORMAL_SPACE_SIZE = 512 * 1024 * 1024;  // 512MB
   static constexpr std::size_t CONST_SPACE_SIZE  = 10 * 1024 * 1024;   // 10 MB
 
+ private:
   VM* vm_;
   gc::CopyingGC normal_space_;
   gc::NoGC const_space_;
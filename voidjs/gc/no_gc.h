@@ -20,6 +20,9 @@ class NoGC {
   }
   
   std::uintptr_t Allocate(std::size_t size) {
+    if (size & 0x7) {
+      size += 0x8 - (size & 0x7);
+    }
     std::uintptr_t addr = alloc_;
     alloc_ += size;
     return addr;
@@ -29,6 +32,10 @@ class NoGC {
     // do nothing
   }
 
+  // Objects are allocated contiguously in [GetStart(), GetTop())
+  std::uintptr_t GetStart() const { return space_; }
+  std::uintptr_t GetTop() const { return alloc_; }
+
  private:
   VM* vm_ {nullptr};
   std::uintptr_t space_ {0};
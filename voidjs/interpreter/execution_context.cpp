@@ -1,10 +1,12 @@
 #include "voidjs/interpreter/execution_context.h"
 
+#include <algorithm>
 #include <functional>
 
 #include "voidjs/ir/program.h"
 #include "voidjs/ir/expression.h"
 #include "voidjs/ir/statement.h"
+#include "voidjs/ir/binding_plan.h"
 #include "voidjs/types/heap_object.h"
 #include "voidjs/types/js_type.h"
 #include "voidjs/types/js_value.h"
@@ -14,8 +16,11 @@
 #include "voidjs/types/spec_types/property_descriptor.h"
 #include "voidjs/types/spec_types/environment_record.h"
 #include "voidjs/types/spec_types/lexical_environment.h"
+#include "voidjs/types/internal_types/binding.h"
+#include "voidjs/types/internal_types/hash_map.h"
 #include "voidjs/builtins/builtin.h"
 #include "voidjs/builtins/global_object.h"
+#include "voidjs/builtins/js_object.h"
 #include "voidjs/builtins/js_function.h"
 #include "voidjs/builtins/arguments.h"
 #include "voidjs/interpreter/vm.h"
@@ -26,8 +31,7 @@ namespace voidjs {
 
 void ExecutionContext::EnterGlobalCode(VM* vm, ast::AstNode* ast_node, bool is_strict) {
   // 1. Initialize the execution context using the global code as described in 10.4.1.1.
-  auto global_ctx = new ExecutionContext(vm->GetGlobalEnv(), vm->GetGlobalEnv(), vm->GetGlobalObject(), is_strict);
-  vm->PushExecutionContext(global_ctx);
+  vm->PushExecutionContext(vm->GetGlobalEnv(), vm->GetGlobalEnv(), vm->GetGlobalObject(), is_strict);
 
   // 2. Perform Declaration Binding Instantiation as described in 10.5 using the global code.
   DeclarationBindingInstantiation(vm, ast_node, {}, {});
@@ -35,11 +39,6 @@ void ExecutionContext::EnterGlobalCode(VM* vm, ast::AstNode* ast_node, bool is_s
 
 void ExecutionContext::EnterFunctionCode(
   VM* vm, ast::AstNode* ast_node, JSHandle<builtins::JSFunction> F, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args) {
-  // 1. If the function code is strict code, set the ThisBinding to thisArg.
-  // 2. Else if thisArg is null or undefined, set the ThisBinding to the global object.
-  // 3. Else if Type(thisArg) is not Object, set the ThisBinding to ToObject(thisArg).
-  // 4. Else set the ThisBinding to thisArg.
-  JSHandle<types::Object> this_binding;
   bool strict = std::invoke([=]() {
     if (ast_node->IsFunctionDeclaration()) {
       return ast_node->AsFunctionDeclaration()->IsStrict();
@@ -48,6 +47,20 @@ void ExecutionContext::EnterFunctionCode(
       return ast_node->AsFunctionExpression()->IsStrict();
     }
   });
+  auto frame_slot_num =
+    ast_node->IsFunctionDeclaration() ? ast_node->AsFunctionDeclaration()->GetFrameSlotNum() :
+    ast_node->AsFunctionExpression()->GetFrameSlotNum();
+  EnterFunctionCode(vm, ast_node, F, this_arg, args, strict, frame_slot_num);
+}
+
+void ExecutionContext::EnterFunctionCode(
+  VM* vm, ast::AstNode* ast_node, JSHandle<builtins::JSFunction> F, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args,
+  bool strict, std::int32_t frame_slot_num) {
+  // 1. If the function code is strict code, set the ThisBinding to thisArg.
+  // 2. Else if thisArg is null or undefined, set the ThisBinding to the global object.
+  // 3. Else if Type(thisArg) is not Object, set the ThisBinding to ToObject(thisArg).
+  // 4. Else set the ThisBinding to thisArg.
+  JSHandle<types::Object> this_binding;
   if (strict) {
     this_binding = this_arg.As<types::Object>();
   } else if (this_arg->IsNull() || this_arg->IsUndefined()) {
@@ -58,23 +71,60 @@ void ExecutionContext::EnterFunctionCode(
   } else {
     this_binding = this_arg.As<types::Object>();
   }
+
+  // Function code whose locals can never be captured keeps them in slots of its frame,
+  // localEnv would hold nothing else and is not created, the scope of F is used in its place.
+  if (frame_slot_num >= 0) {
+    auto scope = JSHandle<types::LexicalEnvironment>{vm, F->GetScope()};
+    auto ctx = vm->PushExecutionContext(scope, scope, this_binding, strict);
+    if (frame_slot_num > 0) {
+      ctx->SetFrameSlots(vm->PushFrameSlots(frame_slot_num), frame_slot_num);
+    }
+    DeclarationBindingInstantiation(vm, ast_node, F, args);
+    return;
+  }
   
   // 5. Let localEnv be the result of calling NewDeclarativeEnvironment passing the value of the [[Scope]] internal property of F as the argument.
-  auto local_env = types::LexicalEnvironment::NewDeclarativeEnvironmentRecord(vm, JSHandle<types::LexicalEnvironment>{vm, F->GetScope()});
+  //    The BindingPlan tells how many bindings localEnv gets, its binding map is allocated large enough for all of them.
+  auto plan = GetBindingPlan(ast_node);
+  auto local_env = types::LexicalEnvironment::NewDeclarativeEnvironmentRecord(
+    vm, JSHandle<types::LexicalEnvironment>{vm, F->GetScope()},
+    plan ? types::HashMap::GetCapacityFor(plan->GetBindingNum()) : types::HashMap::MIN_CAPACITY);
   
   // 6. Set the LexicalEnvironment to localEnv.
   // 7. Set the VariableEnvironment to localEnv.
-  auto context = new ExecutionContext(local_env, local_env, this_binding, strict);
-
-  vm->PushExecutionContext(context);
+  vm->PushExecutionContext(local_env, local_env, this_binding, strict);
   
   // 8. Let code be the value of F’s [[Code]] internal property.
   // 9. Perform Declaration Binding Instantiation using the function code code and argumentList as described in 10.5.
   DeclarationBindingInstantiation(vm, ast_node, F, args);
+
+  // The caller only exits the context it has entered without an exception
+  if (vm->HasException()) {
+    vm->PopExecutionContext();
+  }
 }
 
 void ExecutionContext::DeclarationBindingInstantiation(VM* vm, ast::AstNode* ast_node, JSHandle<builtins::JSFunction> F, const std::vector<JSHandle<JSValue>>& args) {
   auto factory = vm->GetObjectFactory();
+
+  // Locals kept in the frame are only its parameters, variables and catch parameters,
+  // all of which start as undefined, so only the arguments are left to bind (step 4.d).
+  bool keeps_locals_in_frame =
+    ast_node->IsFunctionDeclaration() ? ast_node->AsFunctionDeclaration()->KeepsLocalsInFrame() :
+    ast_node->IsFunctionExpression() ? ast_node->AsFunctionExpression()->KeepsLocalsInFrame() :
+    false;
+  if (keeps_locals_in_frame) {
+    auto ctx = vm->GetExecutionContext();
+    const auto& params =
+      ast_node->IsFunctionDeclaration() ? ast_node->AsFunctionDeclaration()->GetParameters() :
+      ast_node->AsFunctionExpression()->GetParameters();
+    for (std::size_t n = 0; n < params.size(); ++n) {
+      *ctx->GetFrameSlot(params[n]->AsIdentifier()->GetSlot()) =
+        n < args.size() ? args[n].GetJSValue() : JSValue::Undefined();
+    }
+    return;
+  }
   
   // 1. Let env be the environment record component of the running execution context’s VariableEnvironment.
   auto env = JSHandle<types::EnvironmentRecord>{vm, vm->GetExecutionContext()->GetVariableEnvironment()->GetEnvRec()};
@@ -98,11 +148,17 @@ void ExecutionContext::DeclarationBindingInstantiation(VM* vm, ast::AstNode* ast
     ||
     vm->GetExecutionContext()->IsStrict();
 
+  // Function code which keeps its locals in localEnv has them bound as its BindingPlan says
+  if (auto plan = GetBindingPlan(ast_node)) {
+    InstantiateBindingPlan(vm, ast_node, plan, F, args, env.As<types::DeclarativeEnvironmentRecord>(), strict);
+    return;
+  }
+
   // 4. If code is function code, then
   if (ast_node->IsFunctionExpression() || ast_node->IsFunctionDeclaration()) {
     // a. Let func be the function whose [[Call]] internal method initiated execution of code.
     //    Let names be the value of func’s [[FormalParameters]] internal property.
-    auto params = std::invoke([=]() {
+    const auto& params = std::invoke([=]() -> const ast::Expressions& {
       if (ast_node->IsFunctionDeclaration()) {
         return ast_node->AsFunctionDeclaration()->GetParameters();
       } else {
@@ -144,7 +200,7 @@ void ExecutionContext::DeclarationBindingInstantiation(VM* vm, ast::AstNode* ast
   }
 
   // 5. For each FunctionDeclaration f in code, in source text order do
-  const auto& func_decls = std::invoke([](ast::AstNode* ast_node) {
+  const auto& func_decls = std::invoke([](ast::AstNode* ast_node) -> const ast::FunctionDeclarations& {
     if (ast_node->IsProgram()) {
       return ast_node->AsProgram()->GetFunctionDeclarations();
     } else if ( ast_node->IsFunctionDeclaration()) {
@@ -202,38 +258,25 @@ void ExecutionContext::DeclarationBindingInstantiation(VM* vm, ast::AstNode* ast
     types::EnvironmentRecord::SetMutableBinding(vm, env, fn_str, fo.As<JSValue>(), strict);
   }
 
+  // The arguments object can only be observed by code which refers to arguments,
+  // so steps 6 and 7 are skipped for function code which does not, as recorded by the Parser.
+  bool uses_arguments =
+    ast_node->IsFunctionDeclaration() ? ast_node->AsFunctionDeclaration()->UsesArguments() :
+    ast_node->IsFunctionExpression() ? ast_node->AsFunctionExpression()->UsesArguments() :
+    false;
+
   // 6. Let argumentsAlreadyDeclared be the result of
   //    calling env’s HasBinding concrete method passing "arguments" as the argument
-  bool arguments_already_declared = types::EnvironmentRecord::HasBinding(vm, env, factory->NewString(u"arguments"));
+  bool arguments_already_declared =
+    !uses_arguments || types::EnvironmentRecord::HasBinding(vm, env, factory->NewString(u"arguments"));
 
   // 7. If code is function code and argumentsAlreadyDeclared is false, then
   if ((ast_node->IsFunctionDeclaration() || ast_node->IsFunctionExpression()) && !arguments_already_declared) {
-    // a. Let argsObj be the result of calling the abstract operation
-    //    CreateArgumentsObject (10.6) passing func, names, args, env and strict as arguments.
-    JSHandle<builtins::Arguments> args_obj = CreateArgumentsObject(vm, ast_node, F, args, env, strict);
-
-    JSHandle<types::String> arguments_string = factory->NewString(u"arguments");
-    // b. If strict is true, then
-    if (strict) {
-      // i. Call env’s CreateImmutableBinding concrete method passing the String "arguments" as the argument.
-      types::DeclarativeEnvironmentRecord::CreateImmutableBinding(vm, env.As<types::DeclarativeEnvironmentRecord>(), arguments_string);
-                                                                  
-      // ii. Call env’s InitializeImmutableBinding concrete method passing "arguments" and argsObj as arguments.
-      types::DeclarativeEnvironmentRecord::InitializeImmutableBinding(
-        vm, env.As<types::DeclarativeEnvironmentRecord>(), arguments_string, args_obj.As<JSValue>());
-    }
-    // c. Else,
-    else {
-      // i. Call env’s CreateMutableBinding concrete method passing the String "arguments" as the argument.
-      types::EnvironmentRecord::CreateMutableBinding(vm, env, arguments_string, false);
-      
-      // ii. Call env’s SetMutableBinding concrete method passing "arguments", argsObj, and false as arguments.
-      types::EnvironmentRecord::SetMutableBinding(vm, env, arguments_string, args_obj.As<JSValue>(), false);
-    }
+    BindArgumentsObject(vm, ast_node, F, args, env, strict);
   }
 
   // 8. For each VariableDeclaration and VariableDeclarationNoIn d in code, in source text order do
-  const auto& var_decls = std::invoke([](ast::AstNode* ast_node) {
+  const auto& var_decls = std::invoke([](ast::AstNode* ast_node) -> const ast::VariableDeclarations& {
     if (ast_node->IsProgram()) {
       return ast_node->AsProgram()->GetVariableDeclarations();
     } else if ( ast_node->IsFunctionDeclaration()) {
@@ -264,12 +307,93 @@ void ExecutionContext::DeclarationBindingInstantiation(VM* vm, ast::AstNode* ast
   }
 }
 
+const ast::BindingPlan* ExecutionContext::GetBindingPlan(ast::AstNode* ast_node) {
+  return
+    ast_node->IsFunctionDeclaration() ? ast_node->AsFunctionDeclaration()->GetBindingPlan() :
+    ast_node->IsFunctionExpression() ? ast_node->AsFunctionExpression()->GetBindingPlan() :
+    nullptr;
+}
+
+// Steps 4 to 8 of Declaration Binding Instantiation for function code, as given by plan.
+// env is the empty localEnv, each binding is created once and every HasBinding is answered by plan.
+void ExecutionContext::InstantiateBindingPlan(
+  VM* vm, ast::AstNode* ast_node, const ast::BindingPlan* plan, JSHandle<builtins::JSFunction> F,
+  const std::vector<JSHandle<JSValue>>& args, JSHandle<types::DeclarativeEnvironmentRecord> env, bool strict) {
+  auto factory = vm->GetObjectFactory();
+
+  // 4.d.iv, 5.d and 8.c.i, every binding is mutable, not deletable and bound to undefined
+  std::vector<JSHandle<types::Binding>> bindings;
+  bindings.reserve(plan->names.size());
+  auto binding_map = JSHandle<types::HashMap>{vm, env->GetBindingMap()};
+  for (auto name : plan->names) {
+    auto binding = factory->NewBinding(JSHandle<JSValue>{vm, JSValue::Undefined()}, true, false);
+    binding_map = types::HashMap::Insert(vm, binding_map, factory->NewString(name), binding.As<JSValue>());
+    bindings.push_back(binding);
+  }
+  env->SetBindingMap(binding_map.As<JSValue>());
+
+  // 4.d.v Set each parameter to its argument, or to undefined if there are fewer arguments
+  for (std::size_t n = 0; n < plan->parameters.size() && n < args.size(); ++n) {
+    bindings[plan->parameters[n]]->SetValue(args[n]);
+  }
+  for (std::size_t n = args.size(); n < plan->parameters.size(); ++n) {
+    bindings[plan->parameters[n]]->SetValue(JSValue::Undefined());
+  }
+
+  // 5.b and 5.f Set each FunctionDeclaration to its function object
+  const auto& func_decls =
+    ast_node->IsFunctionDeclaration() ? ast_node->AsFunctionDeclaration()->GetFunctionDeclarations() :
+    ast_node->AsFunctionExpression()->GetFunctionDeclarations();
+  for (std::size_t idx = 0; idx < func_decls.size(); ++idx) {
+    auto fo = builtins::Builtin::InstantiatingFunctionDeclaration(
+      vm, func_decls[idx], vm->GetExecutionContext()->GetVariableEnvironment(), strict);
+    bindings[plan->functions[idx]]->SetValue(fo.As<JSValue>());
+  }
+
+  // 6. and 7.
+  if (plan->creates_arguments) {
+    BindArgumentsObject(vm, ast_node, F, args, env.As<types::EnvironmentRecord>(), strict);
+  }
+
+  // 8.c.ii Variables are left as undefined
+}
+
+// Step 7 of Declaration Binding Instantiation
+void ExecutionContext::BindArgumentsObject(
+  VM* vm, ast::AstNode* ast_node, JSHandle<builtins::JSFunction> F,
+  const std::vector<JSHandle<JSValue>>& args, JSHandle<types::EnvironmentRecord> env, bool strict) {
+  auto factory = vm->GetObjectFactory();
+
+  // a. Let argsObj be the result of calling the abstract operation
+  //    CreateArgumentsObject (10.6) passing func, names, args, env and strict as arguments.
+  JSHandle<builtins::Arguments> args_obj = CreateArgumentsObject(vm, ast_node, F, args, env, strict);
+
+  JSHandle<types::String> arguments_string = factory->NewString(u"arguments");
+  // b. If strict is true, then
+  if (strict) {
+    // i. Call env’s CreateImmutableBinding concrete method passing the String "arguments" as the argument.
+    types::DeclarativeEnvironmentRecord::CreateImmutableBinding(vm, env.As<types::DeclarativeEnvironmentRecord>(), arguments_string);
+                                                                
+    // ii. Call env’s InitializeImmutableBinding concrete method passing "arguments" and argsObj as arguments.
+    types::DeclarativeEnvironmentRecord::InitializeImmutableBinding(
+      vm, env.As<types::DeclarativeEnvironmentRecord>(), arguments_string, args_obj.As<JSValue>());
+  }
+  // c. Else,
+  else {
+    // i. Call env’s CreateMutableBinding concrete method passing the String "arguments" as the argument.
+    types::EnvironmentRecord::CreateMutableBinding(vm, env, arguments_string, false);
+    
+    // ii. Call env’s SetMutableBinding concrete method passing "arguments", argsObj, and false as arguments.
+    types::EnvironmentRecord::SetMutableBinding(vm, env, arguments_string, args_obj.As<JSValue>(), false);
+  }
+}
+
 JSHandle<builtins::Arguments> ExecutionContext::CreateArgumentsObject(
   VM* vm, ast::AstNode* ast_node, JSHandle<builtins::JSFunction> F,
   const std::vector<JSHandle<JSValue>>& args, JSHandle<types::EnvironmentRecord> env, bool strict) {
   ObjectFactory* factory = vm->GetObjectFactory();
 
-  auto params = std::invoke([=]() {
+  const auto& params = std::invoke([=]() -> const ast::Expressions& {
     if (ast_node->IsFunctionDeclaration()) {
       return ast_node->AsFunctionDeclaration()->GetParameters();
     } else {
@@ -293,6 +417,8 @@ JSHandle<builtins::Arguments> ExecutionContext::CreateArgumentsObject(
   JSHandle<builtins::Arguments> obj =
     factory->NewObject(builtins::Arguments::SIZE, JSType::ARGUMENTS, ObjectClassType::ARGUMENTS,
                        vm->GetObjectPrototype().As<JSValue>(), true, false, false).As<builtins::Arguments>();
+  obj->SetParameterMap(JSValue::Undefined());
+  obj->SetEnvironment(JSValue::Undefined());
   
   // 7. Call the [[DefineOwnProperty]] internal method on obj passing "length",
   //    the Property Descriptor {[[Value]]: len, [[Writable]]: true, [[Enumerable]]: false, [[Configurable]]: true}, and false as arguments.
@@ -320,40 +446,25 @@ JSHandle<builtins::Arguments> ExecutionContext::CreateArgumentsObject(
                                      types::PropertyDescriptor{vm, val, true, true, true}, false);
 
     // c. If indx is less than the number of elements in names, then
-    // todo
     if (indx < names.size()) {
       // i. Let name be the element of names at 0-origined list position indx.
       JSHandle<types::String> name = names[indx];
       
       // ii. If strict is false and name is not an element of mappedNames, then
-      if (!strict) {
+      bool is_mapped_name = std::any_of(mapped_names.begin(), mapped_names.end(), [&](JSHandle<types::String> mapped_name) {
+        return mapped_name->Equal(name);
+      });
+      if (!strict && !is_mapped_name) {
         // a. Add name as an element of the list mappedNames.
         mapped_names.push_back(name);
 
-        // todo
         // b. Let g be the result of calling the MakeArgGetter abstract operation with arguments name and env.
-        // JSHandle<builtins::JSFunction> g;
-        {
-          // 1. Let body be the result of concatenating the Strings "return ", name, and ";"
-          // JSHandle<types::String> body = types::String::Concat(vm, factory->NewString(u"return "), name, factory->NewString(u";"));
-          
-          // 2. Return the result of creating a function object as described in 13.2
-          //    using no FormalParameterList, body for FunctionBody, env as Scope, and true for Strict.
-          // g = builtins::Builtin::InstantiatingFunctionDeclaration(vm, ast_node, env, true);
-        }
-        
         // c. Let p be the result of calling the MakeArgSetter abstract operation with arguments name and env.
-        // JSHandle<builtins::JSFunction> f;
-        {
-          // 1. Let param be the String name concatenated with the String "_arg"
-          // 2. Let body be the String "<name> = <param>;" with <name> replaced by the value of name and <param> replaced by the value of param.
-          // 3. Return the result of creating a function object as described in 13.2
-          //    using a List containing the single String param as FormalParameterList, body for FunctionBody, env as Scope, and true for Strict.
-        }
-        
         // d. Call the [[DefineOwnProperty]] internal method of map passing ToString(indx),
         //    the Property Descriptor {[[Set]]: p, [[Get]]: g, [[Configurable]]: true}, and false as arguments.
-        
+        //    Instead of g and p, map holds name, whose binding in env is read and written by obj itself.
+        types::Object::DefineOwnPropertyDefault(vm, map, factory->NewStringFromInt(indx),
+                                                types::PropertyDescriptor{vm, name.As<JSValue>(), true, false, true}, false);
       }
     }
 
@@ -365,9 +476,10 @@ JSHandle<builtins::Arguments> ExecutionContext::CreateArgumentsObject(
   if (!mapped_names.empty()) {
     // a. Set the [[ParameterMap]] internal property of obj to map.
     obj->SetParameterMap(map.As<JSValue>());
+    obj->SetEnvironment(env.As<JSValue>());
     
     // b. Set the [[Get]], [[GetOwnProperty]], [[DefineOwnProperty]], and [[Delete]] internal methods of obj to the definitions provided below.
-    
+    obj->SetOrdinary(false);
   }
 
   // 13. If strict is false, then
@@ -1,6 +1,8 @@
 #ifndef VOIDJS_INTERPRETER_EXECUTION_CONTEXT_H
 #define VOIDJS_INTERPRETER_EXECUTION_CONTEXT_H
 
+#include <cstddef>
+#include <cstdint>
 #include <unordered_set>
 
 #include "voidjs/ir/ast.h"
@@ -19,18 +21,20 @@ class ExecutionContext {
                    JSHandle<types::Object> obj, bool is_strict)
     : lexical_environment_(lex_env),
       variable_environment_(var_env),
-      this_binding_(obj), is_strict_(is_strict) {
-    label_set_.push_back(u"");
-  }
+      this_binding_(obj), is_strict_(is_strict)
+  {}
+
+  // Non-Copyable, a context lives in place on the frame stack of VM
+  ExecutionContext(const ExecutionContext&) = delete;
+  ExecutionContext& operator=(const ExecutionContext&) = delete;
   
   bool HasLabel(std::u16string_view label) {
     return std::find(label_set_.begin(), label_set_.end(), label) != label_set_.end();
   }
   bool IsCurrentLabel(std::u16string_view label) {
-    return label == label_set_.back();
+    return label == (label_set_.empty() ? u"" : label_set_.back());
   }
   void AddLabel(std::u16string_view label) {
-    cur_label_ = label;
     label_set_.push_back(label);
   }
   void DeleteLabel() {
@@ -64,19 +68,42 @@ class ExecutionContext {
   JSHandle<types::Object> GetThisBinding() const { return this_binding_; }
   void SetThisBinding(JSHandle<types::Object> this_binding) { this_binding_ = this_binding; }
 
+  // Slots holding the locals of function code which keeps them in its frame,
+  // see ast::FunctionExpression::KeepsLocalsInFrame
+  JSValue* GetFrameSlots() const { return frame_slots_; }
+  std::size_t GetFrameSlotNum() const { return frame_slot_num_; }
+  JSValue* GetFrameSlot(std::int32_t idx) const { return frame_slots_ + idx; }
+  void SetFrameSlots(JSValue* slots, std::size_t num) {
+    frame_slots_ = slots;
+    frame_slot_num_ = num;
+  }
+
   static void EnterGlobalCode(VM* vm, ast::AstNode* ast_node, bool is_strict);
   static void EnterEvalCode(VM* vm);
   static void EnterFunctionCode(
     VM* vm, ast::AstNode* ast_node, JSHandle<builtins::JSFunction> F, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args);
+  // Same as above for function code whose strictness and number of frame slots are known already
+  static void EnterFunctionCode(
+    VM* vm, ast::AstNode* ast_node, JSHandle<builtins::JSFunction> F, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args,
+    bool strict, std::int32_t frame_slot_num);
   static void DeclarationBindingInstantiation(VM* vm, ast::AstNode* ast_node, JSHandle<builtins::JSFunction> F, const std::vector<JSHandle<JSValue>>& args);
   static JSHandle<builtins::Arguments> CreateArgumentsObject(
     VM* vm, ast::AstNode* ast_node, JSHandle<builtins::JSFunction> F,
     const std::vector<JSHandle<JSValue>>& args, JSHandle<types::EnvironmentRecord> env, bool strict);
+
+ private:
+  static const ast::BindingPlan* GetBindingPlan(ast::AstNode* ast_node);
+  static void InstantiateBindingPlan(
+    VM* vm, ast::AstNode* ast_node, const ast::BindingPlan* plan, JSHandle<builtins::JSFunction> F,
+    const std::vector<JSHandle<JSValue>>& args, JSHandle<types::DeclarativeEnvironmentRecord> env, bool strict);
+  static void BindArgumentsObject(
+    VM* vm, ast::AstNode* ast_node, JSHandle<builtins::JSFunction> F,
+    const std::vector<JSHandle<JSValue>>& args, JSHandle<types::EnvironmentRecord> env, bool strict);
   
  private:
-  // label set
-  std::vector<std::u16string_view> label_set_;  // contain "" initially
-  std::u16string_view cur_label_;
+  // label set, the empty label is implied at its bottom
+  // so that a context without labels allocates nothing
+  std::vector<std::u16string_view> label_set_;
 
   // iteration
   std::size_t iteration_depth_ {0};
@@ -90,6 +117,9 @@ class ExecutionContext {
   JSHandle<types::LexicalEnvironment> lexical_environment_;
   JSHandle<types::LexicalEnvironment> variable_environment_;
   JSHandle<types::Object> this_binding_;
+
+  JSValue* frame_slots_ {nullptr};
+  std::size_t frame_slot_num_ {0};
 };
 
 }  // namespace voidjs
@@ -74,6 +74,27 @@ DEFINE_GET_METHOD_FOR_HEAP_OBJECT(SyntaxErrorString, String, types::String, 37)
 DEFINE_GET_METHOD_FOR_HEAP_OBJECT(TypeErrorString, String, types::String, 38)
 DEFINE_GET_METHOD_FOR_HEAP_OBJECT(URIErrorString, String, types::String, 39)
 
+DEFINE_GET_METHOD_FOR_HEAP_OBJECT(JoinString, String, types::String, 40)
+DEFINE_GET_METHOD_FOR_HEAP_OBJECT(NameString, String, types::String, 41)
+DEFINE_GET_METHOD_FOR_HEAP_OBJECT(MessageString, String, types::String, 42)
+DEFINE_GET_METHOD_FOR_HEAP_OBJECT(CommaString, String, types::String, 43)
+
+types::String* GlobalConstants::SingleCharacterString(char16_t ch) const {
+  return single_character_strings_[ch].GetHeapObject()->AsString();
+}
+
+JSHandle<types::String> GlobalConstants::HandledSingleCharacterString(char16_t ch) const {
+  return JSHandle<types::String>{reinterpret_cast<uintptr_t>(&single_character_strings_[ch])};
+}
+
+types::String* GlobalConstants::SmallIntegerString(std::int32_t i) const {
+  return small_integer_strings_[i].GetHeapObject()->AsString();
+}
+
+JSHandle<types::String> GlobalConstants::HandledSmallIntegerString(std::int32_t i) const {
+  return JSHandle<types::String>{reinterpret_cast<uintptr_t>(&small_integer_strings_[i])};
+}
+
 #define SET_CONSTANT(name, value, index)         \
   constants_[index] = value       \
 
@@ -130,6 +151,23 @@ void GlobalConstants::Initialize() {
   SET_CONSTANT(SynTaxString, factory->NewString<GCFlag::CONST>(u"SyntaxError").GetJSValue(), 37);
   SET_CONSTANT(TypeErrorString, factory->NewString<GCFlag::CONST>(u"TypeError").GetJSValue(), 38);
   SET_CONSTANT(URIErrorString, factory->NewString<GCFlag::CONST>(u"URIError").GetJSValue(), 39);
+
+  SET_CONSTANT(JoinString, factory->NewString<GCFlag::CONST>(u"join").GetJSValue(), 40);
+  SET_CONSTANT(NameString, factory->NewString<GCFlag::CONST>(u"name").GetJSValue(), 41);
+  SET_CONSTANT(MessageString, factory->NewString<GCFlag::CONST>(u"message").GetJSValue(), 42);
+  SET_CONSTANT(CommaString, factory->NewString<GCFlag::CONST>(u",").GetJSValue(), 43);
+
+  for (std::size_t idx = 0; idx < SINGLE_CHARACTER_STRING_NUM; ++idx) {
+    char16_t ch = idx;
+    single_character_strings_[idx] =
+      factory->NewString<GCFlag::CONST>(std::u16string_view{&ch, 1}).GetJSValue();
+  }
+
+  for (std::int32_t idx = 0; idx < SMALL_INTEGER_STRING_NUM; ++idx) {
+    auto str = std::to_string(idx);
+    small_integer_strings_[idx] =
+      factory->NewString<GCFlag::CONST>(std::u16string{str.begin(), str.end()}).GetJSValue();
+  }
 }
 
 #undef DEFINE_GET_METHOD_FOR_JSVALUE
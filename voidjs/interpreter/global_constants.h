@@ -70,10 +70,32 @@ class GlobalConstants {
   DECLARE_GET_METHOD_FOR_HEAP_OBJECT(SyntaxErrorString, types::String)
   DECLARE_GET_METHOD_FOR_HEAP_OBJECT(TypeErrorString, types::String)
   DECLARE_GET_METHOD_FOR_HEAP_OBJECT(URIErrorString, types::String)
+
+  DECLARE_GET_METHOD_FOR_HEAP_OBJECT(JoinString, types::String)
+  DECLARE_GET_METHOD_FOR_HEAP_OBJECT(NameString, types::String)
+  DECLARE_GET_METHOD_FOR_HEAP_OBJECT(MessageString, types::String)
+  DECLARE_GET_METHOD_FOR_HEAP_OBJECT(CommaString, types::String)
+
+  // Strings of a single Latin-1 character and decimal strings of small integers
+  // are allocated once in const space and shared by every producer.
+  static constexpr std::size_t SINGLE_CHARACTER_STRING_NUM = 256;
+  static constexpr std::int32_t SMALL_INTEGER_STRING_NUM = 1024;
+
+  static bool HasSingleCharacterString(char16_t ch) { return ch < SINGLE_CHARACTER_STRING_NUM; }
+  static bool HasSmallIntegerString(std::int32_t i) { return 0 <= i && i < SMALL_INTEGER_STRING_NUM; }
+  
+  types::String* SingleCharacterString(char16_t ch) const;
+  JSHandle<types::String> HandledSingleCharacterString(char16_t ch) const;
+  types::String* SmallIntegerString(std::int32_t i) const;
+  JSHandle<types::String> HandledSmallIntegerString(std::int32_t i) const;
   
  private:
+  friend class Snapshot;
+
   static constexpr std::size_t GLOBAL_CONSTANTS_NUM = 100;
   JSValue constants_[GLOBAL_CONSTANTS_NUM];
+  JSValue single_character_strings_[SINGLE_CHARACTER_STRING_NUM];
+  JSValue small_integer_strings_[SMALL_INTEGER_STRING_NUM];
   VM* vm_;
 };
 
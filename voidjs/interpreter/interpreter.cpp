@@ -33,10 +33,13 @@
 #include "voidjs/builtins/js_function.h"
 #include "voidjs/builtins/js_array.h"
 #include "voidjs/builtins/js_error.h"
+#include "voidjs/builtins/bound_function.h"
 #include "voidjs/gc/js_handle.h"
 #include "voidjs/gc/heap.h"
 #include "voidjs/interpreter/execution_context.h"
 #include "voidjs/interpreter/string_table.h"
+#include "voidjs/interpreter/snapshot.h"
+#include "voidjs/parser/streaming_parser.h"
 #include "voidjs/interpreter/global_constants.h"
 #include "voidjs/utils/macros.h"
 
@@ -46,7 +49,14 @@ using namespace ast;
 using namespace types;
 using namespace builtins;
 
+Interpreter::Interpreter(const Snapshot& snapshot)
+  : vm_(new VM{this}) {
+  snapshot.Deserialize(vm_);
+}
+
 void Interpreter::Initialize() {
+  vm_->GetGlobalConstants()->Initialize();
+  
   // Initialize builtin objects and set it for vm
   Builtin::InitializeBuiltinObjects(vm_);
   
@@ -59,6 +69,42 @@ void Interpreter::Initialize() {
 Completion Interpreter::Execute(AstNode* ast_node) {
   return EvalProgram(ast_node);
 }
+
+// Same as EvalProgram, except that SourceElements are evaluated one chunk at a time.
+// The declarations found by the scan of parser are instantiated on entering the global code,
+// those it missed are instantiated just before the chunk holding them is evaluated.
+// A syntax error in a chunk stops the execution, after the chunks before it have been evaluated.
+Completion Interpreter::ExecuteStreaming(StreamingParser* parser) {
+  auto decls = parser->GetDeclarations();
+
+  ExecutionContext::EnterGlobalCode(vm_, decls, decls->IsStrict());
+
+  Completion result{CompletionType::NORMAL};
+  while (!result.IsAbruptCompletion() && !vm_->HasException()) {
+    auto chunk = parser->ParseChunk();
+    if (!chunk) {
+      break;
+    }
+
+    if (!chunk->GetVariableDeclarations().empty() || !chunk->GetFunctionDeclarations().empty()) {
+      ExecutionContext::DeclarationBindingInstantiation(vm_, chunk, {}, {});
+      if (vm_->HasException()) {
+        break;
+      }
+    }
+
+    // The value of the Program is that of its last SourceElement with a value
+    auto chunk_result = EvalSourceElements(chunk->GetStatements());
+    result = Completion{
+      chunk_result.GetType(),
+      chunk_result.GetValue().IsEmpty() ? result.GetValue() : chunk_result.GetValue(),
+      chunk_result.GetTarget()};
+  }
+
+  vm_->PopExecutionContext();
+
+  return result;
+}
   
 // Eval Program
 // Defined in ECMAScript 5.1 Chapter 14
@@ -491,7 +537,8 @@ Completion Interpreter::EvalForInStatement(ForInStatement* for_in_stmt) {
 
     // b. Let lhsRef be the result of evaluating the LeftHandSideExpression ( it may be evaluated repeatedly).
     auto lhs_ref = for_in_stmt->GetLeft()->IsVariableDeclaraion() ?
-      IdentifierResolution(var_name.As<String>()) : EvalExpression(for_in_stmt->GetLeft()->AsExpression());
+      EvalIdentifier(for_in_stmt->GetLeft()->AsVariableDeclaration()->GetIdentifier()->AsIdentifier()) :
+      EvalExpression(for_in_stmt->GetLeft()->AsExpression());
     
     // c. Call PutValue(lhsRef, P).
     PutValue(lhs_ref, P);
@@ -916,6 +963,7 @@ std::variant<JSHandle<JSValue>, Reference> Interpreter::EvalAssignmentExpression
     if (auto plref = std::get_if<Reference>(&lref);
         plref                                                   &&
         plref->IsStrictReference()                              &&
+        !plref->IsSlotReference()                               &&
         plref->GetBase()->GetHeapObject()->IsEnvironmentRecord()&&
         (plref->GetReferencedName()->Equal(u"eval")     ||
          plref->GetReferencedName()->Equal(u"arguments"))) {
@@ -963,6 +1011,7 @@ std::variant<JSHandle<JSValue>, Reference> Interpreter::EvalAssignmentExpression
     if (auto plref = std::get_if<Reference>(&lref);
         plref                                                   &&
         plref->IsStrictReference()                              &&
+        !plref->IsSlotReference()                               &&
         plref->GetBase()->GetHeapObject()->IsEnvironmentRecord()&&
         (plref->GetReferencedName()->Equal(u"eval")     ||
          plref->GetReferencedName()->Equal(u"arguments"))) {
@@ -1168,17 +1217,30 @@ std::variant<JSHandle<JSValue>, Reference> Interpreter::EvalCallExpression(CallE
   // 3. Let argList be the result of evaluating Arguments, producing an internal list of argument values (see 11.2.4).
   auto arg_list = EvalArgumentList(call_expr->GetArguments());
   RETURN_HANDLE_IF_HAS_EXCEPTION(vm_, JSValue);
+
+  // The function last called here has passed steps 4 and 5 already
+  auto cache = call_expr->GetCache();
+  auto epoch = vm_->GetObjectFactory()->GetHeap()->GetEpoch();
+  bool cached = cache->Matches(func.GetJSValue().GetRawData(), epoch);
+  if (cached) {
+    cache->AddHit();
+    ++call_site_stats_.hits;
+  } else {
+    // 4. If Type(func) is not Object, throw a TypeError exception.
+    if (!func->IsObject()) {
+      THROW_SYNTAX_ERROR_AND_RETURN_HANDLE(
+        vm_, u"Function call on non-object value.", JSValue);
+    }
   
-  // 4. If Type(func) is not Object, throw a TypeError exception.
-  if (!func->IsObject()) {
-    THROW_SYNTAX_ERROR_AND_RETURN_HANDLE(
-      vm_, u"Function call on non-object value.", JSValue);
-  }
-  
-  // 5. If IsCallable(func) is false, throw a TypeError exception.
-  if (!func->IsCallable()) {
-    THROW_SYNTAX_ERROR_AND_RETURN_HANDLE(
-      vm_, u"Function call on non-callable value.", JSValue);
+    // 5. If IsCallable(func) is false, throw a TypeError exception.
+    if (!func->IsCallable()) {
+      THROW_SYNTAX_ERROR_AND_RETURN_HANDLE(
+        vm_, u"Function call on non-callable value.", JSValue);
+    }
+
+    cache->AddMiss();
+    ++call_site_stats_.misses;
+    cached = UpdateCallSiteCache(cache, func, epoch);
   }
 
   JSHandle<JSValue> this_value {};
@@ -1190,6 +1252,10 @@ std::variant<JSHandle<JSValue>, Reference> Interpreter::EvalCallExpression(CallE
       // i. Let thisValue be GetBase(ref).
       this_value = pref->GetBase();
     }
+    // ImplicitThisValue of a Declarative Environment Record is undefined
+    else if (pref->IsSlotReference()) {
+      this_value = vm_->GetGlobalConstants()->HandledUndefined();
+    }
     // b. Else, the base of ref is an Environment Record
     else {
       // i. Let thisValue be the result of calling the ImplicitThisValue concrete method of GetBase(ref).
@@ -1204,9 +1270,81 @@ std::variant<JSHandle<JSValue>, Reference> Interpreter::EvalCallExpression(CallE
   
   // 8. Return the result of calling the [[Call]] internal method on func,
   //    providing thisValue as the this value and providing the list argList as the argument values.
+  if (cached) {
+    return CallCachedFunction(*cache, func.As<JSFunction>(), this_value, arg_list);
+  }
   return Object::Call(vm_, func.As<Object>(), this_value, arg_list);
 }
 
+// Records func in cache if it is a JSFunction, whose code is parsed in advance.
+// Returns whether func can be called through cache.
+bool Interpreter::UpdateCallSiteCache(CallSiteCache* cache, JSHandle<JSValue> func, std::uint64_t epoch) {
+  if (func.As<Object>()->GetCallKind() != CallKind::JS_FUNCTION ||
+      cache->GetState() == CallSiteCache::State::MEGAMORPHIC) {
+    return false;
+  }
+
+  auto code = func.As<JSFunction>()->GetCode();
+  try {
+    Parser::ParseLazyFunction(code);
+  } catch (const utils::Error&) {
+    // Left to [[Call]], which throws the SyntaxError
+    return false;
+  }
+
+  bool updated = code->IsFunctionDeclaration() ?
+    cache->Update(func.GetJSValue().GetRawData(), epoch, code,
+                  code->AsFunctionDeclaration()->IsStrict(),
+                  &code->AsFunctionDeclaration()->GetStatements(),
+                  code->AsFunctionDeclaration()->GetFrameSlotNum()) :
+    cache->Update(func.GetJSValue().GetRawData(), epoch, code,
+                  code->AsFunctionExpression()->IsStrict(),
+                  &code->AsFunctionExpression()->GetStatements(),
+                  code->AsFunctionExpression()->GetFrameSlotNum());
+  if (!updated) {
+    // The call site has just turned megamorphic
+    ++call_site_stats_.megamorphic_sites;
+  }
+  return updated;
+}
+
+// [[Call]] of the JSFunction recorded by cache
+JSHandle<JSValue> Interpreter::CallCachedFunction(
+  const CallSiteCache& cache, JSHandle<JSFunction> F, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args) {
+  // cache may be updated by calls made from the body
+  return CallFunctionCode(F, cache.GetCode(), cache.GetStatements(), cache.IsStrict(), cache.GetFrameSlotNum(), this_arg, args);
+}
+
+// [[Call]] of F whose code has been parsed already
+// Defined in ECMAScript 5.1 Chapter 13.2.1
+// The parts which only depend on the code of F are passed in by the caller.
+JSHandle<JSValue> Interpreter::CallFunctionCode(
+  JSHandle<JSFunction> F, ast::AstNode* code, const ast::Statements& stmts, bool strict, std::int32_t frame_slot_num,
+  JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args) {
+  // 1. Let funcCtx be the result of establishing a new execution context for function code
+  //    using the value of F's [[FormalParameters]] internal property,
+  //    the passed arguments List args, and the this value as described in 10.4.3.
+  ExecutionContext::EnterFunctionCode(vm_, code, F, this_arg, args, strict, frame_slot_num);
+  RETURN_HANDLE_IF_HAS_EXCEPTION(vm_, JSValue);
+
+  // 2. Let result be the result of evaluating the FunctionBody that is the value of F's [[Code]] internal property.
+  auto result = stmts.empty() ? Completion{} : EvalSourceElements(stmts);
+
+  // 3. Exit the execution context funcCtx, restoring the previous execution context.
+  vm_->PopExecutionContext();
+
+  // 4. If result.type is throw then throw result.value.
+  RETURN_HANDLE_IF_HAS_EXCEPTION(vm_, JSValue);
+
+  // 5. If result.type is return then return result.value.
+  // 6. Otherwise result.type must be normal. Return undefined.
+  if (result.GetType() == CompletionType::RETURN) {
+    return result.GetValue();
+  } else {
+    return JSHandle<JSValue>{vm_, JSValue::Undefined()};
+  }
+}
+
 // EvalFunctionExpression
 // Defined in ECMAScript 5.1 Chapter 13
 JSHandle<JSValue> Interpreter::EvalFunctionExpression(FunctionExpression* func_expr) {
@@ -1409,6 +1547,13 @@ Completion Interpreter::EvalCaseBlock(const CaseClauses& cases, JSHandle<JSValue
 // Defined in ECMAScript 5.1 Chapter 12.14
 Completion Interpreter::EvalCatch(Expression* catch_name, Statement* catch_block, JSHandle<JSValue> C) {
   auto factory = vm_->GetObjectFactory();
+
+  // In a function keeping its locals in its frame, the Identifier has a slot of its own
+  // standing for the binding of catchEnv, which Block refers to directly.
+  if (auto ident = catch_name->AsIdentifier(); ident->HasSlot()) {
+    *vm_->GetExecutionContext()->GetFrameSlot(ident->GetSlot()) = C.GetJSValue();
+    return EvalStatement(catch_block);
+  }
   
   // 1. Let C be the parameter that has been passed to this production.
   // 2. Let oldEnv be the running execution context’s LexicalEnvironment.
@@ -1506,6 +1651,11 @@ JSHandle<JSValue> Interpreter::EvalThis(This* this_expr) {
 // Eval Identifier
 // Defined in ECMAScript 5.1 Chapter 11.1.2
 Reference Interpreter::EvalIdentifier(Identifier* ident) {
+  // A local kept in the frame is bound to its slot by the Parser
+  if (ident->HasSlot()) {
+    auto ctx = vm_->GetExecutionContext();
+    return Reference{ctx->GetFrameSlot(ident->GetSlot()), ctx->IsStrict()};
+  }
   return IdentifierResolution(vm_->GetObjectFactory()->NewString(ident->GetName()));
 }
 
@@ -2035,12 +2185,14 @@ JSHandle<JSValue> Interpreter::ApplyRelationalOperator(TokenType op, Expression*
     }
     
     // 6. If rval does not have a [[HasInstance]] internal method, throw a TypeError exception.
+    // 7. Return the result of calling the [[HasInstance]] internal method of rval with argument lval.
+    if (rval->GetHeapObject()->IsBoundFunction()) {
+      return JSHandle<JSValue>{vm_, JSValue{builtins::BoundFunction::HasInstance(vm_, rval.As<builtins::BoundFunction>(), lval)}};
+    }
     if (!rval->GetHeapObject()->IsJSFunction()) {
       THROW_TYPE_ERROR_AND_RETURN_HANDLE(
         vm_, u"Object does not have a [[HasInstance]] internal method when using instanceof operator", JSValue);
     }
-    
-    // 7. Return the result of calling the [[HasInstance]] internal method of rval with argument lval.
     return JSHandle<JSValue>{vm_, JSValue{builtins::JSFunction::HasInstance(vm_, rval.As<builtins::JSFunction>(), lval)}};
   } else {
     // op must be TokenType::KEYWORD_IN
@@ -2277,6 +2429,11 @@ JSHandle<JSValue> Interpreter::ApplyUnaryOperator(TokenType op, Expression* expr
           THROW_SYNTAX_ERROR_AND_RETURN_HANDLE(vm_, u"Cannot delete.", JSValue);
         }
         
+        // Bindings for parameters and variables can not be deleted
+        if (pref.IsSlotReference()) {
+          return vm_->GetGlobalConstants()->HandledFalse();
+        }
+        
         // b. Let bindings be GetBase(ref).
         auto bindings = pref.GetBase().As<EnvironmentRecord>();
         
@@ -2333,6 +2490,7 @@ JSHandle<JSValue> Interpreter::ApplyUnaryOperator(TokenType op, Expression* expr
       if (auto plref = std::get_if<Reference>(&ref);
           plref                                                   &&
           plref->IsStrictReference()                              &&
+          !plref->IsSlotReference()                               &&
           plref->GetBase()->GetHeapObject()->IsEnvironmentRecord()&&
           (plref->GetReferencedName()->Equal(u"eval")     ||
            plref->GetReferencedName()->Equal(u"arguments"))) {
@@ -2366,6 +2524,7 @@ JSHandle<JSValue> Interpreter::ApplyUnaryOperator(TokenType op, Expression* expr
       if (auto plref = std::get_if<Reference>(&ref);
           plref                                                   &&
           plref->IsStrictReference()                              &&
+          !plref->IsSlotReference()                               &&
           plref->GetBase()->GetHeapObject()->IsEnvironmentRecord()&&
           (plref->GetReferencedName()->Equal(u"eval")     ||
            plref->GetReferencedName()->Equal(u"arguments"))) {
@@ -2454,6 +2613,7 @@ JSHandle<JSValue> Interpreter::ApplyPostfixOperator(TokenType op, Expression* ex
   if (auto plref = std::get_if<Reference>(&lhs);
       plref                                                   &&
       plref->IsStrictReference()                              &&
+      !plref->IsSlotReference()                               &&
       plref->GetBase()->GetHeapObject()->IsEnvironmentRecord()&&
       (plref->GetReferencedName()->Equal(u"eval")     ||
        plref->GetReferencedName()->Equal(u"arguments"))) {
@@ -2780,6 +2940,10 @@ JSHandle<JSValue> Interpreter::GetValue(const std::variant<JSHandle<JSValue>, Re
       return GetUsedByGetValue(base, ref.GetReferencedName());
     }
   }
+  // The value is copied out of the slot, which may be assigned to before it is used
+  else if (ref.IsSlotReference()) {
+    return JSHandle<JSValue>{vm_, base.GetJSValue()};
+  }
   // 5. Else, base must be an environment record.
   else { 
     // a. Return the result of calling the GetBindingValue concrete method of
@@ -2864,6 +3028,9 @@ void Interpreter::PutValue(const std::variant<JSHandle<JSValue>, Reference>& V,
       PutUsedByPutValue(base, ref->GetReferencedName(), W, ref->IsStrictReference());
     }
   }
+  else if (ref->IsSlotReference()) {
+    **base = W.GetJSValue();
+  }
   // 5. Else base must be a reference whose base is an environment record. So,
   else {
     // a. Call the SetMutableBinding (10.2.1) concrete method of base,
@@ -1,6 +1,7 @@
 #ifndef VOIDJS_INTERPRETER_INTERPRETER_H
 #define VOIDJS_INTERPRETER_INTERPRETER_H
 
+#include <cstdint>
 #include <variant>
 #include <memory>
 
@@ -22,12 +23,18 @@
 
 namespace voidjs {
 
+class Snapshot;
+class StreamingParser;
+
 class Interpreter {
  public:
   Interpreter() : vm_(new VM{this}) {
     Initialize();
   }
 
+  // Restores the builtin objects from snapshot instead of running the initializers
+  explicit Interpreter(const Snapshot& snapshot);
+
   ~Interpreter() {
     delete vm_;
   }
@@ -36,6 +43,10 @@ class Interpreter {
   
   types::Completion Execute(ast::AstNode* ast_node);
 
+  // Executes the Program of parser chunk by chunk while it is parsed,
+  // parser->ScanDeclarations must have succeeded.
+  types::Completion ExecuteStreaming(StreamingParser* parser);
+
   types::Completion EvalProgram(ast::AstNode* ast_node);
 
   types::Completion EvalStatement(ast::Statement* stmt);
@@ -115,8 +126,29 @@ class Interpreter {
 
   VM* GetVM() const { return vm_; }
 
+  // Calls through the CallSiteCache of all CallExpressions,
+  // and the number of call sites which turned megamorphic
+  struct CallSiteStats {
+    std::uint64_t hits {0};
+    std::uint64_t misses {0};
+    std::uint64_t megamorphic_sites {0};
+  };
+  const CallSiteStats& GetCallSiteStats() const { return call_site_stats_; }
+
+  // [[Call]] of F, whose code is parsed and whose strictness, statements and number of frame slots
+  // are known to the caller, as for a call through a CallSiteCache or a PreparedCall
+  JSHandle<JSValue> CallFunctionCode(
+    JSHandle<builtins::JSFunction> F, ast::AstNode* code, const ast::Statements& stmts, bool strict, std::int32_t frame_slot_num,
+    JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args);
+
+ private:
+  bool UpdateCallSiteCache(ast::CallSiteCache* cache, JSHandle<JSValue> func, std::uint64_t epoch);
+  JSHandle<JSValue> CallCachedFunction(
+    const ast::CallSiteCache& cache, JSHandle<builtins::JSFunction> F, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args);
+
  private:
   VM* vm_;
+  CallSiteStats call_site_stats_;
 };
 
 }  // namespace voidjs
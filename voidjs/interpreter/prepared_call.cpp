@@ -0,0 +1,87 @@
+#include "voidjs/interpreter/prepared_call.h"
+
+#include "voidjs/ir/expression.h"
+#include "voidjs/ir/statement.h"
+#include "voidjs/parser/parser.h"
+#include "voidjs/types/lang_types/object.h"
+#include "voidjs/types/internal_types/internal_function.h"
+#include "voidjs/builtins/js_function.h"
+#include "voidjs/builtins/js_error.h"
+#include "voidjs/gc/js_handle_scope.h"
+#include "voidjs/interpreter/interpreter.h"
+#include "voidjs/interpreter/vm.h"
+#include "voidjs/utils/error.h"
+
+namespace voidjs {
+
+PreparedCall::PreparedCall(VM* vm, JSHandle<types::Object> func, JSHandle<JSValue> this_arg, std::size_t arg_num)
+  : vm_(vm), func_(func), this_arg_(this_arg),
+    result_(vm, JSValue::Undefined()), call_kind_(func->GetCallKind()) {
+  args_.reserve(arg_num);
+  for (std::size_t idx = 0; idx < arg_num; ++idx) {
+    args_.emplace_back(vm, JSValue::Undefined());
+  }
+
+  if (call_kind_ == CallKind::JS_FUNCTION) {
+    auto code = func.As<builtins::JSFunction>()->GetCode();
+    try {
+      Parser::ParseLazyFunction(code);
+    } catch (const utils::Error&) {
+      // Left to [[Call]], which throws the SyntaxError
+      return;
+    }
+    code_ = code;
+    if (code->IsFunctionDeclaration()) {
+      statements_ = &code->AsFunctionDeclaration()->GetStatements();
+      strict_ = code->AsFunctionDeclaration()->IsStrict();
+      frame_slot_num_ = code->AsFunctionDeclaration()->GetFrameSlotNum();
+    } else {
+      statements_ = &code->AsFunctionExpression()->GetStatements();
+      strict_ = code->AsFunctionExpression()->IsStrict();
+      frame_slot_num_ = code->AsFunctionExpression()->GetFrameSlotNum();
+    }
+  } else if (call_kind_ == CallKind::INTERNAL_FUNCTION) {
+    info_ = RuntimeCallInfo::New(vm, this_arg, args_);
+  }
+}
+
+PreparedCall::~PreparedCall() {
+  if (info_) {
+    RuntimeCallInfo::Delete(info_);
+  }
+}
+
+JSHandle<JSValue> PreparedCall::Invoke() {
+  {
+    JSHandleScope handle_scope{vm_};
+    auto ret = InvokeCallee();
+    **result_ = vm_->HasException() ? vm_->GetException().GetJSValue() : ret.GetJSValue();
+  }
+
+  // The exception is moved out of the handles just released
+  if (vm_->HasException()) {
+    vm_->SetException(JSHandle<builtins::JSError>{vm_, result_.GetJSValue()});
+    **result_ = JSValue::Undefined();
+  }
+  return result_;
+}
+
+JSHandle<JSValue> PreparedCall::InvokeCallee() {
+  if (code_) {
+    return vm_->GetInterpreter()->CallFunctionCode(
+      func_.As<builtins::JSFunction>(), code_, *statements_, strict_, frame_slot_num_, this_arg_, args_);
+  }
+
+  // The values in info_ are not updated by the GC, they are copied again for each call
+  if (info_) {
+    info_->SetThis(this_arg_);
+    for (std::size_t idx = 0; idx < args_.size(); ++idx) {
+      info_->SetArg(idx, args_[idx]);
+    }
+    return JSHandle<JSValue>{vm_, func_->AsInternalFunction()->GetFunction()(info_)};
+  }
+
+  return types::Object::Call(vm_, func_, this_arg_, args_);
+}
+
+}  // namespace voidjs
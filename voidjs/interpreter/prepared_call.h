@@ -0,0 +1,72 @@
+#ifndef VOIDJS_INTERPRETER_PREPARED_CALL_H
+#define VOIDJS_INTERPRETER_PREPARED_CALL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "voidjs/ir/ast.h"
+#include "voidjs/types/js_value.h"
+#include "voidjs/types/call_kind.h"
+#include "voidjs/gc/js_handle.h"
+#include "voidjs/interpreter/runtime_call_info.h"
+
+namespace voidjs {
+
+namespace types {
+
+class Object;
+
+}  // namespace types
+
+class VM;
+
+// PreparedCall is the [[Call]] of one callable object repeated by a native function,
+// such as callbackfn of Array.prototype.map, which is called once per element.
+//
+// What only depends on the callee is settled once by the constructor:
+// its CallKind, and for a JSFunction its parsed body, strictness and number of frame slots.
+// The argument list is allocated once as well, Invoke only rewrites its slots,
+// and the handles made by each call are released when it returns.
+class PreparedCall {
+ public:
+  // func must be callable
+  PreparedCall(VM* vm, JSHandle<types::Object> func, JSHandle<JSValue> this_arg, std::size_t arg_num);
+  ~PreparedCall();
+
+  // Non-Copyable
+  PreparedCall(const PreparedCall&) = delete;
+  PreparedCall& operator=(const PreparedCall&) = delete;
+
+  void SetArg(std::size_t idx, JSValue value) { **args_[idx] = value; }
+  void SetArg(std::size_t idx, JSHandle<JSValue> handle) { **args_[idx] = handle.GetJSValue(); }
+
+  // The returned handle is the same for every call,
+  // its value must be used before the next call to Invoke.
+  JSHandle<JSValue> Invoke();
+
+ private:
+  JSHandle<JSValue> InvokeCallee();
+
+ private:
+  VM* vm_;
+  JSHandle<types::Object> func_;
+  JSHandle<JSValue> this_arg_;
+  std::vector<JSHandle<JSValue>> args_;
+  JSHandle<JSValue> result_;
+
+  CallKind call_kind_;
+
+  // JSFunction whose body has been parsed
+  ast::AstNode* code_ {nullptr};
+  const ast::Statements* statements_ {nullptr};
+  bool strict_ {false};
+  std::int32_t frame_slot_num_ {-1};
+
+  // InternalFunction
+  RuntimeCallInfo* info_ {nullptr};
+};
+
+}  // namespace voidjs
+
+#endif  // VOIDJS_INTERPRETER_PREPARED_CALL_H
@@ -0,0 +1,407 @@
+#include "voidjs/interpreter/snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include <link.h>
+#include <unistd.h>
+
+#include "voidjs/builtins/builtin.h"
+#include "voidjs/gc/heap.h"
+#include "voidjs/gc/js_handle.h"
+#include "voidjs/types/heap_object.h"
+#include "voidjs/types/js_value.h"
+#include "voidjs/types/object_factory.h"
+#include "voidjs/types/internal_types/internal_function.h"
+#include "voidjs/interpreter/interpreter.h"
+#include "voidjs/interpreter/global_constants.h"
+#include "voidjs/interpreter/vm.h"
+#include "voidjs/utils/helper.h"
+#include "voidjs/utils/mapped_file.h"
+
+namespace voidjs {
+
+namespace {
+
+// Native functions are stored relative to this one,
+// the whole image of the binary moves together under ASLR.
+std::uintptr_t GetCodeAnchor() {
+  return reinterpret_cast<std::uintptr_t>(&builtins::Builtin::InitializeBuiltinObjects);
+}
+
+// Returns the GNU build id of the binary the code anchor lives in,
+// or an empty string if it was linked without one.
+std::string GetBuildId() {
+  struct Search {
+    std::uintptr_t anchor;
+    std::string build_id;
+  } search {GetCodeAnchor(), {}};
+
+  ::dl_iterate_phdr([](dl_phdr_info* info, std::size_t, void* data) -> int {
+    auto search = static_cast<Search*>(data);
+
+    bool contains_anchor = false;
+    for (std::size_t idx = 0; idx < info->dlpi_phnum; ++idx) {
+      const auto& phdr = info->dlpi_phdr[idx];
+      std::uintptr_t start = info->dlpi_addr + phdr.p_vaddr;
+      if (phdr.p_type == PT_LOAD && search->anchor >= start && search->anchor < start + phdr.p_memsz) {
+        contains_anchor = true;
+      }
+    }
+    if (!contains_anchor) {
+      return 0;
+    }
+
+    for (std::size_t idx = 0; idx < info->dlpi_phnum; ++idx) {
+      const auto& phdr = info->dlpi_phdr[idx];
+      if (phdr.p_type != PT_NOTE) {
+        continue;
+      }
+      auto pos = info->dlpi_addr + phdr.p_vaddr;
+      auto end = pos + phdr.p_memsz;
+      while (pos + sizeof(ElfW(Nhdr)) <= end) {
+        auto note = reinterpret_cast<const ElfW(Nhdr)*>(pos);
+        auto name = reinterpret_cast<const char*>(pos + sizeof(ElfW(Nhdr)));
+        auto desc = name + ((note->n_namesz + 3) & ~3);
+        if (note->n_type == NT_GNU_BUILD_ID && note->n_namesz == 4 && std::memcmp(name, "GNU", 4) == 0) {
+          search->build_id.assign(desc, note->n_descsz);
+          return 1;
+        }
+        pos = reinterpret_cast<std::uintptr_t>(desc) + ((note->n_descsz + 3) & ~3);
+      }
+    }
+    return 1;
+  }, &search);
+
+  return search.build_id;
+}
+
+std::uint64_t Hash(std::string_view data) {
+  return utils::detail::wyhash::hash(data.data(), data.size());
+}
+
+std::uint64_t GetBuildIdHash() {
+  static const std::uint64_t hash = std::invoke([]() -> std::uint64_t {
+    auto build_id = GetBuildId();
+    return build_id.empty() ? 0 : Hash(build_id);
+  });
+  return hash;
+}
+
+// The const space followed by the normal space,
+// offsets into it are what heap pointers become in a Snapshot.
+struct Layout {
+  std::uintptr_t const_start;
+  std::size_t const_size;
+  std::uintptr_t normal_start;
+  std::size_t normal_size;
+
+  std::size_t GetSize() const { return const_size + normal_size; }
+
+  bool Contains(std::uintptr_t addr) const {
+    return (addr >= const_start && addr < const_start + const_size) ||
+      (addr >= normal_start && addr < normal_start + normal_size);
+  }
+
+  std::uint64_t ToOffset(std::uintptr_t addr) const {
+    if (addr >= const_start && addr < const_start + const_size) {
+      return addr - const_start;
+    } else {
+      return addr - normal_start + const_size;
+    }
+  }
+
+  std::uintptr_t ToAddress(std::uint64_t offset) const {
+    if (offset < const_size) {
+      return const_start + offset;
+    } else {
+      return normal_start + offset - const_size;
+    }
+  }
+};
+
+}  // namespace
+
+template <typename F>
+void Snapshot::VisitConstants(GlobalConstants* constants, F&& f) {
+  for (auto& value : constants->constants_) {
+    f(value);
+  }
+  for (auto& value : constants->single_character_strings_) {
+    f(value);
+  }
+  for (auto& value : constants->small_integer_strings_) {
+    f(value);
+  }
+}
+
+template <typename F>
+void Snapshot::VisitBuiltins(VM* vm, F&& f) {
+  f(vm->object_proto_);
+  f(vm->object_ctor_);
+  f(vm->function_proto_);
+  f(vm->function_ctor_);
+  f(vm->array_proto_);
+  f(vm->array_ctor_);
+  f(vm->string_proto_);
+  f(vm->string_ctor_);
+  f(vm->boolean_proto_);
+  f(vm->boolean_ctor_);
+  f(vm->number_proto_);
+  f(vm->number_ctor_);
+  f(vm->math_obj_);
+  f(vm->error_proto_);
+  f(vm->error_ctor_);
+  f(vm->eval_error_proto_);
+  f(vm->eval_error_ctor_);
+  f(vm->range_error_proto_);
+  f(vm->range_error_ctor_);
+  f(vm->reference_error_proto_);
+  f(vm->reference_error_ctor_);
+  f(vm->syntax_error_proto_);
+  f(vm->syntax_error_ctor_);
+  f(vm->type_error_proto_);
+  f(vm->type_error_ctor_);
+  f(vm->uri_error_proto_);
+  f(vm->uri_error_ctor_);
+  f(vm->global_obj_);
+  f(vm->global_env_);
+}
+
+Snapshot Snapshot::Create() {
+  Interpreter interpreter;
+  return Snapshot{interpreter.GetVM()};
+}
+
+Snapshot::Snapshot(VM* vm) {
+  const Heap* heap = vm->GetObjectFactory()->GetHeap();
+  const auto& const_space = heap->GetConstSpace();
+  const auto& normal_space = heap->GetNormalSpace();
+  Layout layout {
+    const_space.GetStart(), const_space.GetTop() - const_space.GetStart(),
+    normal_space.GetStart(), normal_space.GetTop() - normal_space.GetStart(),
+  };
+
+  std::string image(layout.GetSize(), '\0');
+  std::memcpy(image.data(), reinterpret_cast<void*>(layout.const_start), layout.const_size);
+  std::memcpy(image.data() + layout.const_size, reinterpret_cast<void*>(layout.normal_start), layout.normal_size);
+
+  std::vector<std::uint64_t> relocations;
+  std::vector<std::uint64_t> roots;
+
+  // Only objects reachable from the roots are relocated,
+  // garbage left by the initializers keeps its stale pointers and is never scanned.
+  std::unordered_set<std::uintptr_t> visited;
+  std::vector<std::uintptr_t> worklist;
+  auto mark = [&](JSValue value) {
+    if (visited.insert(value.GetRawData()).second) {
+      worklist.push_back(value.GetRawData());
+    }
+  };
+
+  auto add_root = [&](JSValue value) {
+    if (value.IsHeapObject() && layout.Contains(value.GetRawData())) {
+      roots.push_back(HEAP_OBJECT);
+      roots.push_back(layout.ToOffset(value.GetRawData()));
+      mark(value);
+    } else {
+      roots.push_back(VALUE);
+      roots.push_back(value.GetRawData());
+    }
+  };
+  VisitConstants(vm->GetGlobalConstants(), add_root);
+  VisitBuiltins(vm, [&](const auto& handle) { add_root(handle.GetJSValue()); });
+
+  auto add_relocation = [&](std::uintptr_t slot, SlotKind kind, std::uint64_t value) {
+    std::uint64_t offset = layout.ToOffset(slot);
+    std::memcpy(image.data() + offset, &value, sizeof(value));
+    relocations.push_back(offset << 2 | kind);
+  };
+  while (!worklist.empty()) {
+    JSValue object {worklist.back()};
+    worklist.pop_back();
+
+    for (auto handle : HeapObject::GetValues(object)) {
+      // The code of JSFunction is not a heap pointer,
+      // but none of the builtin functions has any.
+      JSValue value = handle.GetJSValue();
+      if (value.IsHeapObject() && layout.Contains(value.GetRawData())) {
+        add_relocation(handle.GetAddress(), HEAP_OBJECT, layout.ToOffset(value.GetRawData()));
+        mark(value);
+      }
+    }
+
+    if (object.GetHeapObject()->IsInternalFunction()) {
+      auto func = reinterpret_cast<std::uintptr_t>(object.GetHeapObject()->AsInternalFunction()->GetFunction());
+      add_relocation(object.GetRawData() + types::InternalFunction::FUNCTION_OFFSET,
+                     NATIVE_FUNCTION, func - GetCodeAnchor());
+    }
+  }
+
+  Header header;
+  std::memcpy(header.magic, "VJSS", 4);
+  header.version = VERSION;
+  header.build_id_hash = GetBuildIdHash();
+  header.const_size = layout.const_size;
+  header.normal_size = layout.normal_size;
+  header.relocation_num = relocations.size();
+  header.root_num = roots.size() / 2;
+
+  data_.reserve(sizeof(Header) + image.size() + (relocations.size() + roots.size()) * sizeof(std::uint64_t));
+  data_.append(sizeof(Header), '\0');
+  data_.append(image);
+  data_.append(reinterpret_cast<const char*>(relocations.data()), relocations.size() * sizeof(std::uint64_t));
+  data_.append(reinterpret_cast<const char*>(roots.data()), roots.size() * sizeof(std::uint64_t));
+
+  header.payload_hash = Hash(std::string_view{data_}.substr(sizeof(Header)));
+  std::memcpy(data_.data(), &header, sizeof(Header));
+}
+
+void Snapshot::Deserialize(VM* vm) const {
+  Header header;
+  std::memcpy(&header, data_.data(), sizeof(Header));
+
+  // Nothing has been allocated yet, so each image lands at the start of its space
+  Heap* heap = vm->GetObjectFactory()->GetHeap();
+  Layout layout {
+    heap->Allocate<GCFlag::CONST>(header.const_size), header.const_size,
+    heap->Allocate<GCFlag::NORMAL>(header.normal_size), header.normal_size,
+  };
+
+  auto image = data_.data() + sizeof(Header);
+  std::memcpy(reinterpret_cast<void*>(layout.const_start), image, layout.const_size);
+  std::memcpy(reinterpret_cast<void*>(layout.normal_start), image + layout.const_size, layout.normal_size);
+
+  auto relocations = reinterpret_cast<const std::uint64_t*>(image + layout.GetSize());
+  for (std::size_t idx = 0; idx < header.relocation_num; ++idx) {
+    std::uint64_t relocation;
+    std::memcpy(&relocation, relocations + idx, sizeof(relocation));
+
+    auto slot = reinterpret_cast<std::uint64_t*>(layout.ToAddress(relocation >> 2));
+    if ((relocation & 0x3) == HEAP_OBJECT) {
+      *slot = layout.ToAddress(*slot);
+    } else {
+      *slot += GetCodeAnchor();
+    }
+  }
+
+  auto roots = relocations + header.relocation_num;
+  auto next_root = [&]() {
+    std::uint64_t root[2];
+    std::memcpy(root, roots, sizeof(root));
+    roots += 2;
+    return JSValue{root[0] == HEAP_OBJECT ? layout.ToAddress(root[1]) : root[1]};
+  };
+  VisitConstants(vm->GetGlobalConstants(), [&](JSValue& value) {
+    value = next_root();
+  });
+  VisitBuiltins(vm, [&](auto& handle) {
+    handle = std::decay_t<decltype(handle)>{vm, next_root()};
+  });
+}
+
+std::unique_ptr<Snapshot> Snapshot::Load(const std::string& path) {
+  utils::MappedFile file{path};
+  if (!file.IsMapped()) {
+    return nullptr;
+  }
+
+  std::string_view data {reinterpret_cast<const char*>(file.GetData()), file.GetSize()};
+  if (!Validate(data)) {
+    return nullptr;
+  }
+  return std::unique_ptr<Snapshot>{new Snapshot{std::string{data}}};
+}
+
+bool Snapshot::Store(const std::string& path) const {
+  // A Snapshot of a binary without build id could never be validated
+  if (!GetBuildIdHash()) {
+    return false;
+  }
+
+  // Write to a private file first and rename it into place,
+  // so that processes sharing the file never see a partial snapshot.
+  auto tmp_path = path + ".tmp" + std::to_string(::getpid());
+  {
+    std::ofstream file{tmp_path, std::ios::binary | std::ios::trunc};
+    file.write(data_.data(), data_.size());
+    file.close();
+    if (!file) {
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+// Everything Deserialize relies on is checked here, a snapshot from another build
+// or a corrupted file is rejected as a whole. The number of roots is left to the build id,
+// the same build always visits the same roots.
+bool Snapshot::Validate(std::string_view data) {
+  if (data.size() < sizeof(Header)) {
+    return false;
+  }
+
+  Header header;
+  std::memcpy(&header, data.data(), sizeof(Header));
+  if (std::memcmp(header.magic, "VJSS", 4) != 0 ||
+      header.version != VERSION ||
+      !header.build_id_hash ||
+      header.build_id_hash != GetBuildIdHash()) {
+    return false;
+  }
+
+  if (header.const_size > Heap::CONST_SPACE_SIZE || header.const_size % sizeof(JSValue) ||
+      header.normal_size > Heap::NORMAL_SPACE_SIZE / 2 || header.normal_size % sizeof(JSValue) ||
+      header.relocation_num > (header.const_size + header.normal_size) / sizeof(JSValue)) {
+    return false;
+  }
+
+  std::size_t image_size = header.const_size + header.normal_size;
+  if (data.size() != sizeof(Header) + image_size +
+      (header.relocation_num + 2 * header.root_num) * sizeof(std::uint64_t) ||
+      header.payload_hash != Hash(data.substr(sizeof(Header)))) {
+    return false;
+  }
+
+  auto entries = data.data() + sizeof(Header) + image_size;
+  for (std::size_t idx = 0; idx < header.relocation_num; ++idx) {
+    std::uint64_t relocation;
+    std::memcpy(&relocation, entries + idx * sizeof(std::uint64_t), sizeof(relocation));
+    std::uint64_t offset = relocation >> 2;
+    std::uint64_t kind = relocation & 0x3;
+    if (offset % sizeof(JSValue) || offset + sizeof(JSValue) > image_size ||
+        (kind != HEAP_OBJECT && kind != NATIVE_FUNCTION)) {
+      return false;
+    }
+    if (kind == HEAP_OBJECT) {
+      std::uint64_t target;
+      std::memcpy(&target, data.data() + sizeof(Header) + offset, sizeof(target));
+      if (target >= image_size) {
+        return false;
+      }
+    }
+  }
+
+  entries += header.relocation_num * sizeof(std::uint64_t);
+  for (std::size_t idx = 0; idx < header.root_num; ++idx) {
+    std::uint64_t root[2];
+    std::memcpy(root, entries + 2 * idx * sizeof(std::uint64_t), sizeof(root));
+    if (root[0] != VALUE && (root[0] != HEAP_OBJECT || root[1] >= image_size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace voidjs
@@ -0,0 +1,86 @@
+#ifndef VOIDJS_INTERPRETER_SNAPSHOT_H
+#define VOIDJS_INTERPRETER_SNAPSHOT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace voidjs {
+
+class VM;
+class GlobalConstants;
+
+// Snapshot is an image of the heap right after Interpreter::Initialize,
+// holding the const space, the normal space and the roots kept by VM and GlobalConstants.
+// Restoring it copies both spaces into a new VM and relocates them, instead of
+// running GlobalConstants::Initialize and Builtin::InitializeBuiltinObjects again.
+//
+// The data is position independent. It starts with a header
+//   magic "VJSS", VERSION, hash of the build id, sizes of both spaces,
+//   number of relocations and roots, hash of the payload
+// followed by the payload
+//   const space, normal space, relocations, roots
+// Heap pointers are stored as offsets into the two spaces laid out one after another,
+// native functions of InternalFunction as offsets from a function of this binary.
+// The latter only hold for the very same build, which is why a Snapshot
+// written to disk is tied to the build id of the binary.
+class Snapshot {
+ public:
+  // Must be bumped whenever the layout of heap objects or the set of roots changes
+  static constexpr std::uint32_t VERSION = 3;
+
+  // Initializes a fresh VM and takes its snapshot
+  static Snapshot Create();
+
+  // Returns nullptr if there is no valid snapshot for this binary at path
+  static std::unique_ptr<Snapshot> Load(const std::string& path);
+
+  // Returns false if the snapshot could not be written
+  bool Store(const std::string& path) const;
+
+  // vm must be newly created, with nothing allocated on its heap yet
+  void Deserialize(VM* vm) const;
+
+  std::string_view GetData() const { return data_; }
+
+ private:
+  explicit Snapshot(std::string data)
+    : data_(std::move(data))
+  {}
+
+  explicit Snapshot(VM* vm);
+
+  static bool Validate(std::string_view data);
+
+  template <typename F>
+  static void VisitConstants(GlobalConstants* constants, F&& f);
+  template <typename F>
+  static void VisitBuiltins(VM* vm, F&& f);
+
+ private:
+  struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t build_id_hash;
+    std::uint64_t const_size;
+    std::uint64_t normal_size;
+    std::uint64_t relocation_num;
+    std::uint64_t root_num;
+    std::uint64_t payload_hash;
+  };
+
+  // A relocation is the offset of a slot shifted left by 2 bits, or'ed with its kind.
+  // A root is a pair of its kind and its value.
+  enum SlotKind : std::uint64_t {
+    VALUE = 0,
+    HEAP_OBJECT = 1,
+    NATIVE_FUNCTION = 2,
+  };
+
+  std::string data_;
+};
+
+}  // namespace voidjs
+
+#endif  // VOIDJS_INTERPRETER_SNAPSHOT_H
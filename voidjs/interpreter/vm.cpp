@@ -1,9 +1,11 @@
 #include "voidjs/interpreter/vm.h"
 
+#include <algorithm>
+#include <cstddef>
+
 #include "voidjs/types/object_factory.h"
 #include "voidjs/interpreter/string_table.h"
 #include "voidjs/interpreter/global_constants.h"
-#include "voidjs/interpreter/global_constants.h"
 
 namespace voidjs {
 
@@ -11,50 +13,81 @@ VM::VM(Interpreter* interpreter)
   : interpreter_{interpreter},
     object_factory_{new ObjectFactory{this, new Heap{this}, new StringTable{this}}},
     global_constants_{new GlobalConstants{this}}
-{
-  global_constants_->Initialize();
-}
+{}
 
 VM::~VM() {
+  while (execution_ctx_num_ > 0) {
+    PopExecutionContext();
+  }
+  
   delete object_factory_;
   
   delete global_constants_;
 }
 
+// Blocks are allocated one by one so that handles never move,
+// and are kept for the scopes opened later.
 JSValue* VM::ExpandHandleScopeBlock() {
-  if (handle_scope_current_block_index_ + 1 == handle_scope_blocks_.size()) {
-    auto block = new std::array<JSValue, HANDLE_SCOPE_BLOCK_SIZE>{};
-    handle_scope_blocks_.push_back(*block);
-    handle_scope_current_block_pos_ = block->data();
-    handle_scope_current_block_end_ = block->data() + block->size();
-    ++handle_scope_current_block_index_;
-    return block->data();
-  } else {
-    auto block = &handle_scope_blocks_.back();
-    handle_scope_current_block_pos_ = block->data();
-    handle_scope_current_block_end_ = block->data() + block->size();
-    ++handle_scope_current_block_index_;
-    return block->data();
+  if (handle_scope_current_block_index_ + 1 == static_cast<std::int32_t>(handle_scope_blocks_.size())) {
+    handle_scope_blocks_.push_back(std::make_unique<std::array<JSValue, HANDLE_SCOPE_BLOCK_SIZE>>());
+  }
+  auto block = handle_scope_blocks_[++handle_scope_current_block_index_].get();
+  handle_scope_current_block_pos_ = block->data();
+  handle_scope_current_block_end_ = block->data() + block->size();
+  return block->data();
+}
+
+JSValue* VM::PushFrameSlots(std::size_t num) {
+  if (frame_slot_end_ - frame_slot_pos_ < static_cast<std::ptrdiff_t>(num)) {
+    if (frame_slot_pos_) {
+      ++frame_slot_block_index_;
+    }
+    if (frame_slot_block_index_ == frame_slot_blocks_.size()) {
+      frame_slot_blocks_.push_back(std::make_unique<std::array<JSValue, FRAME_SLOT_BLOCK_SIZE>>());
+    }
+    auto block = frame_slot_blocks_[frame_slot_block_index_].get();
+    frame_slot_pos_ = block->data();
+    frame_slot_end_ = block->data() + block->size();
   }
+  auto slots = frame_slot_pos_;
+  std::fill(slots, slots + num, JSValue::Undefined());
+  frame_slot_pos_ += num;
+  return slots;
+}
+
+// Frames are released in the reverse order, so slots is the top of the stack,
+// possibly in a block below the current one
+void VM::PopFrameSlots(JSValue* slots) {
+  while (slots < frame_slot_blocks_[frame_slot_block_index_]->data() ||
+         slots >= frame_slot_blocks_[frame_slot_block_index_]->data() + FRAME_SLOT_BLOCK_SIZE) {
+    --frame_slot_block_index_;
+  }
+  auto block = frame_slot_blocks_[frame_slot_block_index_].get();
+  frame_slot_pos_ = slots;
+  frame_slot_end_ = block->data() + block->size();
 }
 
 std::vector<JSHandle<JSValue>> VM::GetRoots() {
   std::vector<JSHandle<JSValue>> handles;
 
-  // Execution Contexts
-  handles.reserve(3 * execution_ctxs_.size());
-  for (auto ctx : execution_ctxs_) {
+  // Execution Contexts, scanned in place from the bottom of the frame stack
+  handles.reserve(3 * execution_ctx_num_);
+  for (std::size_t idx = 0; idx < execution_ctx_num_; ++idx) {
+    auto ctx = GetExecutionContext(idx);
     handles.push_back(ctx->GetVariableEnvironment().As<JSValue>());
     handles.push_back(ctx->GetLexicalEnvironment().As<JSValue>());
     handles.push_back(ctx->GetThisBinding().As<JSValue>());
+    for (std::size_t slot = 0; slot < ctx->GetFrameSlotNum(); ++slot) {
+      handles.push_back(JSHandle<JSValue>{reinterpret_cast<std::uintptr_t>(ctx->GetFrameSlot(slot))});
+    }
   }
 
   // HandelScope
-  for (std::int32_t idx = 0; idx < handle_scope_current_block_index_; ++idx) {
+  for (std::int32_t idx = 0; idx <= handle_scope_current_block_index_; ++idx) {
     JSValue* limit = idx == handle_scope_current_block_index_ ?
       handle_scope_current_block_pos_ :
-      handle_scope_blocks_[idx].data() + handle_scope_blocks_[idx].size();
-    for (JSValue* start = handle_scope_blocks_[idx].data(); start < limit; ++start) {
+      handle_scope_blocks_[idx]->data() + handle_scope_blocks_[idx]->size();
+    for (JSValue* start = handle_scope_blocks_[idx]->data(); start < limit; ++start) {
       handles.push_back(JSHandle<JSValue>{reinterpret_cast<std::uintptr_t>(start)});
     }
   }
@@ -1,12 +1,19 @@
 #ifndef VOIDJS_INTERPRETER_VM_H
 #define VOIDJS_INTERPRETER_VM_H
 
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "voidjs/interpreter/execution_context.h"
 #include "voidjs/types/heap_object.h"
 #include "voidjs/gc/js_handle.h"
 #include "voidjs/utils/macros.h"
+#include "voidjs/utils/arena.h"
 
 namespace voidjs {
 
@@ -23,9 +30,36 @@ class VM {
 
   Interpreter* GetInterpreter() const { return interpreter_; }
   
-  ExecutionContext* GetExecutionContext() const { return execution_ctxs_.back(); }
-  void PushExecutionContext(ExecutionContext* ctx) { execution_ctxs_.push_back(ctx); }
-  void PopExecutionContext() { execution_ctxs_.pop_back(); }
+  ExecutionContext* GetExecutionContext() const { return execution_ctx_current_; }
+  
+  // Constructs the new running execution context in place on the frame stack
+  template <typename... Args>
+  ExecutionContext* PushExecutionContext(Args&&... args) {
+    auto pos = execution_ctx_num_ % EXECUTION_CONTEXT_BLOCK_SIZE;
+    if (pos == 0 && execution_ctx_num_ / EXECUTION_CONTEXT_BLOCK_SIZE == execution_ctx_blocks_.size()) {
+      execution_ctx_blocks_.push_back(std::make_unique<ExecutionContextBlock>());
+    }
+    auto block = execution_ctx_blocks_[execution_ctx_num_ / EXECUTION_CONTEXT_BLOCK_SIZE].get();
+    execution_ctx_current_ = new (&(*block)[pos]) ExecutionContext(std::forward<Args>(args)...);
+    ++execution_ctx_num_;
+    return execution_ctx_current_;
+  }
+  
+  // Destroys the running execution context, restoring the previous one
+  void PopExecutionContext() {
+    if (execution_ctx_current_->GetFrameSlots()) {
+      PopFrameSlots(execution_ctx_current_->GetFrameSlots());
+    }
+    execution_ctx_current_->~ExecutionContext();
+    --execution_ctx_num_;
+    execution_ctx_current_ = execution_ctx_num_ == 0 ? nullptr : GetExecutionContext(execution_ctx_num_ - 1);
+  }
+
+  std::size_t GetExecutionContextNum() const { return execution_ctx_num_; }
+
+  // Reserves num contiguous slots, initialized to undefined, on top of the frame slot stack.
+  // They are released along with the execution context they are given to.
+  JSValue* PushFrameSlots(std::size_t num);
   
   PROPERTY_ACCESSORS(JSHandle<types::LexicalEnvironment>, GlobalEnv, global_env_)
   PROPERTY_ACCESSORS(JSHandle<builtins::GlobalObject>, GlobalObject, global_obj_)
@@ -78,8 +112,20 @@ class VM {
 
   std::vector<JSHandle<JSValue>> GetRoots();
 
+  // Code parsed at runtime (e.g. by the Function constructor) may be referred to
+  // by functions living anywhere in the heap, so its Arena is kept until the VM is destroyed.
+  void AddArena(std::unique_ptr<utils::Arena> arena) { arenas_.push_back(std::move(arena)); }
+
  private:
   friend class JSHandleScope;
+  friend class Snapshot;
+
+  void PopFrameSlots(JSValue* slots);
+
+  ExecutionContext* GetExecutionContext(std::size_t idx) const {
+    auto& block = *execution_ctx_blocks_[idx / EXECUTION_CONTEXT_BLOCK_SIZE];
+    return std::launder(reinterpret_cast<ExecutionContext*>(&block[idx % EXECUTION_CONTEXT_BLOCK_SIZE]));
+  }
 
  private:
   // standard builtin objects
@@ -127,7 +173,25 @@ class VM {
   // 
   JSHandle<builtins::GlobalObject> global_obj_;
   JSHandle<types::LexicalEnvironment> global_env_;
-  std::vector<ExecutionContext*> execution_ctxs_;
+
+  // execution context stack
+  // Contexts are laid out one after another in blocks which are allocated one by one,
+  // so that a context never moves while it is running, and are kept once allocated.
+  static constexpr std::size_t EXECUTION_CONTEXT_BLOCK_SIZE = 256;
+  using ExecutionContextBlock =
+    std::array<std::aligned_storage_t<sizeof(ExecutionContext), alignof(ExecutionContext)>, EXECUTION_CONTEXT_BLOCK_SIZE>;
+  std::vector<std::unique_ptr<ExecutionContextBlock>> execution_ctx_blocks_;
+  std::size_t execution_ctx_num_ {0};
+  ExecutionContext* execution_ctx_current_ {nullptr};
+
+  // frame slot stack
+  // The slots of a frame never span two blocks, the rest of a block which can not hold them is left unused.
+  // A block is large enough for the slots of any frame, see Parser::MAX_FRAME_SLOT_NUM.
+  static constexpr std::size_t FRAME_SLOT_BLOCK_SIZE = 16 * 1024;
+  std::vector<std::unique_ptr<std::array<JSValue, FRAME_SLOT_BLOCK_SIZE>>> frame_slot_blocks_;
+  std::size_t frame_slot_block_index_ {0};
+  JSValue* frame_slot_pos_ {nullptr};
+  JSValue* frame_slot_end_ {nullptr};
 
   //  
   ObjectFactory* object_factory_;
@@ -137,7 +201,7 @@ class VM {
   
   // handle scope
   static constexpr std::size_t HANDLE_SCOPE_BLOCK_SIZE = 10 * 1024;
-  std::vector<std::array<JSValue, HANDLE_SCOPE_BLOCK_SIZE>> handle_scope_blocks_;
+  std::vector<std::unique_ptr<std::array<JSValue, HANDLE_SCOPE_BLOCK_SIZE>>> handle_scope_blocks_;
   JSValue* handle_scope_current_block_pos_ {nullptr};
   JSValue* handle_scope_current_block_end_ {nullptr};
   std::int32_t handle_scope_current_block_index_ {-1};
@@ -145,6 +209,9 @@ class VM {
   //
   JSHandle<builtins::JSError> exception_;
 
+  //
+  std::vector<std::unique_ptr<utils::Arena>> arenas_;
+
   // 
   Interpreter* interpreter_;
 };
@@ -4,6 +4,8 @@
 #include <memory>
 #include <vector>
 
+#include "voidjs/utils/arena.h"
+
 namespace voidjs {
 namespace ast {
 
@@ -109,13 +111,15 @@ class ObjectLiteral;
 class Property;
 class CaseClause;
 class FunctionDeclaration;
+struct BindingPlan;
 
-using Statements = std::vector<Statement*>;
-using Expressions = std::vector<Expression*>;
-using VariableDeclarations = std::vector<VariableDeclaration*>;
-using CaseClauses = std::vector<CaseClause*>;
-using Properties = std::vector<Property*>;
-using FunctionDeclarations = std::vector<FunctionDeclaration*>;
+// AST nodes and the lists in them are allocated in the Arena of the Program they belong to
+using Statements = utils::ArenaVector<Statement*>;
+using Expressions = utils::ArenaVector<Expression*>;
+using VariableDeclarations = utils::ArenaVector<VariableDeclaration*>;
+using CaseClauses = utils::ArenaVector<CaseClause*>;
+using Properties = utils::ArenaVector<Property*>;
+using FunctionDeclarations = utils::ArenaVector<FunctionDeclaration*>;
 
 class Dumper;
 
@@ -0,0 +1,59 @@
+#include "voidjs/ir/binding_plan.h"
+
+#include <limits>
+#include <unordered_map>
+
+#include "voidjs/ir/expression.h"
+#include "voidjs/ir/statement.h"
+
+namespace voidjs {
+namespace ast {
+
+const BindingPlan* BindingPlan::New(utils::Arena* arena, const Expressions& params,
+                                    const VariableDeclarations& var_decls, const FunctionDeclarations& func_decls,
+                                    bool uses_arguments) {
+  auto plan = arena->New<BindingPlan>(BindingPlan{
+      utils::ArenaVector<std::u16string_view>{arena},
+      utils::ArenaVector<std::uint32_t>{arena},
+      utils::ArenaVector<std::uint32_t>{arena},
+      false,
+    });
+
+  std::unordered_map<std::u16string_view, std::uint32_t> indices;
+  auto declare = [&](std::u16string_view name) {
+    auto [iter, inserted] = indices.emplace(name, plan->names.size());
+    if (inserted) {
+      plan->names.push_back(name);
+    }
+    return iter->second;
+  };
+
+  // 4.d For each String argName in names, a binding is created unless argAlreadyDeclared
+  plan->parameters.reserve(params.size());
+  for (auto param : params) {
+    plan->parameters.push_back(declare(param->AsIdentifier()->GetName()));
+  }
+
+  // 5. For each FunctionDeclaration f in code, a binding is created unless funcAlreadyDeclared
+  plan->functions.reserve(func_decls.size());
+  for (auto func : func_decls) {
+    plan->functions.push_back(declare(func->GetName()->AsIdentifier()->GetName()));
+  }
+
+  // 6. and 7. arguments is bound unless argumentsAlreadyDeclared, outside of names.
+  //    A var named arguments is then already declared.
+  plan->creates_arguments = uses_arguments && !indices.count(u"arguments");
+  if (plan->creates_arguments) {
+    indices.emplace(u"arguments", std::numeric_limits<std::uint32_t>::max());
+  }
+
+  // 8. For each VariableDeclaration d in code, a binding is created unless varAlreadyDeclared
+  for (auto var_decl : var_decls) {
+    declare(var_decl->GetIdentifier()->AsIdentifier()->GetName());
+  }
+
+  return plan;
+}
+
+}  // namespace ast
+}  // namespace voidjs
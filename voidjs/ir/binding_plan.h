@@ -0,0 +1,44 @@
+#ifndef VOIDJS_IR_BINDING_PLAN_H
+#define VOIDJS_IR_BINDING_PLAN_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "voidjs/ir/ast.h"
+#include "voidjs/utils/arena.h"
+
+namespace voidjs {
+namespace ast {
+
+// BindingPlan is Declaration Binding Instantiation (10.5) of a function code, worked out once by the Parser.
+// localEnv of function code starts without bindings, so every HasBinding of steps 4 to 8 only depends
+// on the code, and so does which name ends up bound to which parameter or FunctionDeclaration.
+// A call then creates the bindings of names, all of which are mutable and start as undefined,
+// and only assigns the arguments and the function objects to them.
+struct BindingPlan {
+  // Every binding but arguments, parameters first, then FunctionDeclarations, then variables
+  utils::ArenaVector<std::u16string_view> names;
+
+  // Index into names of each formal parameter, in list order.
+  // A parameter given twice is bound to the later argument, as in step 4.d.
+  utils::ArenaVector<std::uint32_t> parameters;
+
+  // Index into names of each FunctionDeclaration, in source text order
+  utils::ArenaVector<std::uint32_t> functions;
+
+  // Whether steps 6 and 7 create the arguments object,
+  // which is false if the code does not use it or a parameter or FunctionDeclaration is named arguments
+  bool creates_arguments;
+
+  // Number of bindings in localEnv once the plan is carried out
+  std::size_t GetBindingNum() const { return names.size() + creates_arguments; }
+
+  static const BindingPlan* New(utils::Arena* arena, const Expressions& params,
+                                const VariableDeclarations& var_decls, const FunctionDeclarations& func_decls,
+                                bool uses_arguments);
+};
+
+}  // namespace ast
+}  // namespace voidjs
+
+#endif  // VOIDJS_IR_BINDING_PLAN_H
@@ -69,7 +69,7 @@ void Dumper::DumpString(std::string string) {
 }
 
 void Dumper::DumpString(std::u16string string) {
-  ss_ << '"' << utils::U16StrToU8Str(std::u16string{string}) << '"';
+  ss_ << '"' << utils::U16StrToU8Str(string) << '"';
 }
 
 void Dumper::DumpNumber(int number) {
@@ -53,12 +53,12 @@ class Dumper {
       : key_(key), value_(string)
     {}
 
-    DumperNode(const char* key, std::u16string string)
+    DumperNode(const char* key, std::u16string_view string)
       : key_(key), value_(utils::U16StrToU8Str(string))
     {}
 
     template <typename T>
-    DumperNode(const char* key, const std::vector<T*>& ast_nodes)
+    DumperNode(const char* key, const utils::ArenaVector<T*>& ast_nodes)
       : key_(key)
     {
       std::vector<AstNode*> nodes;
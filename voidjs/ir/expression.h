@@ -1,6 +1,8 @@
 #ifndef VOIDJS_IR_EXPRESSION_H
 #define VOIDJS_IR_EXPRESSION_H
 
+#include <cstdint>
+
 #include "voidjs/lexer/token.h"
 #include "voidjs/ir/ast.h"
 
@@ -47,6 +49,75 @@ class NewExpression : public Expression {
   Expressions arguments_;
 };
 
+// CallSiteCache remembers the function object last called by a CallExpression,
+// along with what calling it needs from its code, i.e. the code itself, its strictness,
+// its statements and the number of slots of its frame, so that calling it again skips
+// checking the callee, dispatching the call and looking all of them up.
+// It is filled and read by the Interpreter and is never serialized.
+//
+// The callee is identified by its address, which only holds within the epoch of the heap it was recorded in.
+// A call site whose callee has changed code more than MAX_RETARGETS times turns megamorphic and is no longer cached.
+class CallSiteCache {
+ public:
+  enum class State : std::uint8_t {
+    UNINITIALIZED,
+    MONOMORPHIC,
+    MEGAMORPHIC,
+  };
+
+  static constexpr std::uint32_t MAX_RETARGETS = 4;
+
+  bool Matches(std::uintptr_t callee, std::uint64_t epoch) const {
+    return callee_ == callee && epoch_ == epoch;
+  }
+
+  // Records a callee and its code, returns false once the call site is megamorphic
+  bool Update(std::uintptr_t callee, std::uint64_t epoch, AstNode* code,
+              bool strict, const Statements* statements, std::int32_t frame_slot_num) {
+    if (state_ == State::MEGAMORPHIC) {
+      return false;
+    }
+    if (state_ == State::MONOMORPHIC && code != code_ && ++retargets_ > MAX_RETARGETS) {
+      state_ = State::MEGAMORPHIC;
+      callee_ = 0;
+      code_ = nullptr;
+      return false;
+    }
+    state_ = State::MONOMORPHIC;
+    callee_ = callee;
+    epoch_ = epoch;
+    code_ = code;
+    strict_ = strict;
+    statements_ = statements;
+    frame_slot_num_ = frame_slot_num;
+    return true;
+  }
+
+  State GetState() const { return state_; }
+  AstNode* GetCode() const { return code_; }
+  bool IsStrict() const { return strict_; }
+  const Statements& GetStatements() const { return *statements_; }
+  std::int32_t GetFrameSlotNum() const { return frame_slot_num_; }
+
+  std::uint64_t GetHits() const { return hits_; }
+  std::uint64_t GetMisses() const { return misses_; }
+  std::uint32_t GetRetargets() const { return retargets_; }
+  void AddHit() { ++hits_; }
+  void AddMiss() { ++misses_; }
+
+ private:
+  std::uintptr_t callee_ {0};
+  std::uint64_t epoch_ {0};
+  AstNode* code_ {nullptr};
+  const Statements* statements_ {nullptr};
+  std::int32_t frame_slot_num_ {-1};
+  bool strict_ {false};
+  State state_ {State::UNINITIALIZED};
+  std::uint32_t retargets_ {0};
+  std::uint64_t hits_ {0};
+  std::uint64_t misses_ {0};
+};
+
 class CallExpression : public Expression {
  public:
   CallExpression(Expression* callee, Expressions arguments)
@@ -57,11 +128,15 @@ class CallExpression : public Expression {
   Expression* GetCallee() const { return callee_; }
   const Expressions& GetArguments() const { return arguments_; }
 
+  CallSiteCache* GetCache() { return &cache_; }
+  const CallSiteCache& GetCache() const { return cache_; }
+
   void Dump(Dumper* dumper) const override;
 
  private:
   Expression* callee_;
   Expressions arguments_;
+  CallSiteCache cache_;
 };
 
 class MemberExpression : public Expression {
@@ -222,6 +297,40 @@ class FunctionExpression : public Expression {
 
   bool IsStrict() const { return is_strict_; }
 
+  // A lazily parsed function only keeps the source text of its body,
+  // the body is parsed into the same Arena when the function is first called.
+  bool IsLazy() const { return !lazy_body_.empty(); }
+  std::u16string_view GetLazyBody() const { return lazy_body_; }
+  utils::Arena* GetArena() const { return statements_.get_allocator().GetArena(); }
+  void SetLazyBody(std::u16string_view body) { lazy_body_ = body; }
+  void SetBody(Statements statements, VariableDeclarations var_decls, FunctionDeclarations func_decls,
+               bool uses_arguments, std::int32_t frame_slot_num, const BindingPlan* binding_plan) {
+    statements_ = std::move(statements);
+    variable_declarations_ = std::move(var_decls);
+    function_declarations_ = std::move(func_decls);
+    uses_arguments_ = uses_arguments;
+    frame_slot_num_ = frame_slot_num;
+    binding_plan_ = binding_plan;
+    lazy_body_ = {};
+  }
+
+  // Whether the body refers to arguments, or may do so through a direct call to eval.
+  // Only known once the body is parsed, the arguments object is not created otherwise.
+  bool UsesArguments() const { return uses_arguments_; }
+  void SetUsesArguments(bool uses_arguments) { uses_arguments_ = uses_arguments; }
+
+  // Whether the locals of the function can never be captured, by an inner function, with or eval.
+  // Its parameters, variables and catch parameters are then kept in GetFrameSlotNum slots of its frame,
+  // as resolved in Identifier::GetSlot, and calling it creates no environment.
+  bool KeepsLocalsInFrame() const { return frame_slot_num_ >= 0; }
+  std::int32_t GetFrameSlotNum() const { return frame_slot_num_; }
+  void SetFrameSlotNum(std::int32_t frame_slot_num) { frame_slot_num_ = frame_slot_num; }
+
+  // How Declaration Binding Instantiation binds the locals kept in an environment,
+  // nullptr while the body is lazy or if the locals are kept in the frame.
+  const BindingPlan* GetBindingPlan() const { return binding_plan_; }
+  void SetBindingPlan(const BindingPlan* binding_plan) { binding_plan_ = binding_plan; }
+
   void Dump(Dumper* dumper) const override;
 
  private:
@@ -232,21 +341,35 @@ class FunctionExpression : public Expression {
   
   VariableDeclarations variable_declarations_;
   FunctionDeclarations function_declarations_;
+
+  bool uses_arguments_ {};
+  std::int32_t frame_slot_num_ {-1};
+  const BindingPlan* binding_plan_ {};
+
+  std::u16string_view lazy_body_;
 };
 
 class Identifier : public Expression {
  public:
-  explicit Identifier(std::u16string name)
+  explicit Identifier(std::u16string_view name)
     : Expression(AstNodeType::IDENTIFIER),
-      name_(std::move(name))
+      name_(name)
   {}
 
   std::u16string_view GetName() const { return name_; }
 
+  // The frame slot the Identifier is bound to in a function which keeps its locals in its frame,
+  // NO_SLOT if it is resolved through the LexicalEnvironment.
+  static constexpr std::int32_t NO_SLOT = -1;
+  bool HasSlot() const { return slot_ != NO_SLOT; }
+  std::int32_t GetSlot() const { return slot_; }
+  void SetSlot(std::int32_t slot) { slot_ = slot; }
+
   void Dump(Dumper* dumper) const override;
 
  private:
-  std::u16string name_;
+  std::u16string_view name_;  // characters live in the Arena
+  std::int32_t slot_ {NO_SLOT};
 };
 
 class ArrayLiteral : public Expression {
@@ -55,17 +55,17 @@ class NumericLiteral : public Expression {
 
 class StringLiteral : public Expression {
  public:
-  explicit StringLiteral(std::u16string str)
+  explicit StringLiteral(std::u16string_view str)
     : Expression(AstNodeType::STRING_LITERAL),
-      string_(std::move(str))
+      string_(str)
   {}
 
-  std::u16string GetString() const { return string_; }
+  std::u16string_view GetString() const { return string_; }
 
   void Dump(Dumper* dumper) const override;
 
  private:
-  std::u16string string_;
+  std::u16string_view string_;  // characters live in the Arena
 };
 
 
@@ -8,12 +8,16 @@ namespace ast {
 
 class VariableDeclaration;
 
+// Program owns the Arena in which all of its nodes are allocated,
+// deleting the Program releases the whole tree at once.
 class Program : public AstNode {
  public:
-  explicit Program(Statements statements, bool is_strict,
+  explicit Program(std::unique_ptr<utils::Arena> arena,
+                   Statements statements, bool is_strict,
                    VariableDeclarations var_decls,
                    FunctionDeclarations func_decls)
     : AstNode(AstNodeType::PROGRAM),
+      arena_(std::move(arena)),
       statements_(std::move(statements)), is_strict_(is_strict),
       variable_declarations_(std::move(var_decls)),
       function_declarations_(std::move(func_decls))
@@ -25,9 +29,18 @@ class Program : public AstNode {
   
   bool IsStrict() const { return is_strict_; }
 
+  const utils::Arena* GetArena() const { return arena_.get(); }
+
+  // Takes over an Arena holding function bodies parsed apart from the Program
+  void AddArena(std::unique_ptr<utils::Arena> arena) { function_arenas_.push_back(std::move(arena)); }
+
   void Dump(Dumper* dumper) const override;
   
  private:
+  // Declared first so that it is destroyed after the lists below
+  std::unique_ptr<utils::Arena> arena_;
+  std::vector<std::unique_ptr<utils::Arena>> function_arenas_;
+  
   Statements statements_;
   bool is_strict_;
   
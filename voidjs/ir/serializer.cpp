@@ -0,0 +1,591 @@
+#include "voidjs/ir/serializer.h"
+
+#include <algorithm>
+
+#include "voidjs/lexer/token_type.h"
+#include "voidjs/ir/ast.h"
+#include "voidjs/ir/program.h"
+#include "voidjs/ir/statement.h"
+#include "voidjs/ir/expression.h"
+#include "voidjs/ir/literal.h"
+#include "voidjs/ir/binding_plan.h"
+
+namespace voidjs {
+namespace ast {
+
+namespace {
+
+// A node reference is either NULL_NODE, NEW_NODE followed by the node itself,
+// or the index plus one of a node which has been written before.
+constexpr std::uint32_t NULL_NODE = 0;
+constexpr std::uint32_t NEW_NODE = 0xFFFFFFFF;
+
+}  // namespace
+
+Serializer::Serializer(const Program* program) {
+  Write<std::uint8_t>(program->IsStrict());
+  WriteNodes(program->GetStatements());
+  WriteNodes(program->GetVariableDeclarations());
+  WriteNodes(program->GetFunctionDeclarations());
+}
+
+std::string Serializer::GetData() const {
+  std::string data;
+  std::uint32_t count = string_indices_.size();
+  data.reserve(sizeof(count) + strings_.size() + buffer_.size());
+  data.append(reinterpret_cast<const char*>(&count), sizeof(count));
+  data.append(strings_);
+  data.append(buffer_);
+  return data;
+}
+
+void Serializer::WriteNode(const AstNode* ast_node) {
+  if (!ast_node) {
+    Write(NULL_NODE);
+    return;
+  }
+
+  if (auto iter = node_indices_.find(ast_node); iter != node_indices_.end()) {
+    Write(iter->second + 1);
+    return;
+  }
+
+  std::uint32_t index = node_indices_.size();
+  node_indices_.emplace(ast_node, index);
+  Write(NEW_NODE);
+  Write(static_cast<std::uint8_t>(ast_node->GetType()));
+  WriteNodeBody(ast_node);
+}
+
+void Serializer::WriteNodeBody(const AstNode* ast_node) {
+  switch (ast_node->GetType()) {
+    case AstNodeType::BLOCK_STATEMENT: {
+      WriteNodes(ast_node->AsBlockStatement()->GetStatements());
+      break;
+    }
+    case AstNodeType::VARIABLE_STATEMENT: {
+      WriteNodes(ast_node->AsVariableStatement()->GetVariableDeclarations());
+      break;
+    }
+    case AstNodeType::EXPRESSION_STATEMENT: {
+      WriteNode(ast_node->AsExpressionStatement()->GetExpression());
+      break;
+    }
+    case AstNodeType::IF_STATEMENT: {
+      auto if_stmt = ast_node->AsIfStatement();
+      WriteNode(if_stmt->GetCondition());
+      WriteNode(if_stmt->GetConsequent());
+      WriteNode(if_stmt->GetAlternate());
+      break;
+    }
+    case AstNodeType::DO_WHILE_STATEMENT: {
+      auto do_while_stmt = ast_node->AsDoWhileStatement();
+      WriteNode(do_while_stmt->GetCondition());
+      WriteNode(do_while_stmt->GetBody());
+      break;
+    }
+    case AstNodeType::WHILE_STATEMENT: {
+      auto while_stmt = ast_node->AsWhileStatement();
+      WriteNode(while_stmt->GetCondition());
+      WriteNode(while_stmt->GetBody());
+      break;
+    }
+    case AstNodeType::FOR_STATEMENT: {
+      auto for_stmt = ast_node->AsForStatement();
+      WriteNode(for_stmt->GetInitializer());
+      WriteNode(for_stmt->GetCondition());
+      WriteNode(for_stmt->GetUpdate());
+      WriteNode(for_stmt->GetBody());
+      break;
+    }
+    case AstNodeType::FOR_IN_STATEMENT: {
+      auto for_in_stmt = ast_node->AsForInStatement();
+      WriteNode(for_in_stmt->GetLeft());
+      WriteNode(for_in_stmt->GetRight());
+      WriteNode(for_in_stmt->GetBody());
+      break;
+    }
+    case AstNodeType::CONTINUE_STATEMENT: {
+      WriteNode(ast_node->AsContinueStatement()->GetIdentifier());
+      break;
+    }
+    case AstNodeType::BREAK_STATEMENT: {
+      WriteNode(ast_node->AsBreakStatement()->GetIdentifier());
+      break;
+    }
+    case AstNodeType::RETURN_STATEMENT: {
+      WriteNode(ast_node->AsReturnStatement()->GetExpression());
+      break;
+    }
+    case AstNodeType::WITH_STATEMENT: {
+      auto with_stmt = ast_node->AsWithStatement();
+      WriteNode(with_stmt->GetContext());
+      WriteNode(with_stmt->GetBody());
+      break;
+    }
+    case AstNodeType::SWITCH_STATEMENT: {
+      auto switch_stmt = ast_node->AsSwitchStatement();
+      WriteNode(switch_stmt->GetDiscriminant());
+      WriteNodes(switch_stmt->GetCaseClauses());
+      break;
+    }
+    case AstNodeType::LABELLED_STATEMENT: {
+      auto labelled_stmt = ast_node->AsLabelledStatement();
+      WriteNode(labelled_stmt->GetLabel());
+      WriteNode(labelled_stmt->GetBody());
+      break;
+    }
+    case AstNodeType::THROW_STATEMENT: {
+      WriteNode(ast_node->AsThrowStatement()->GetExpression());
+      break;
+    }
+    case AstNodeType::TRY_STATEMENT: {
+      auto try_stmt = ast_node->AsTryStatement();
+      WriteNode(try_stmt->GetBody());
+      WriteNode(try_stmt->GetCatchName());
+      WriteNode(try_stmt->GetCatchBlock());
+      WriteNode(try_stmt->GetFinallyBlock());
+      break;
+    }
+    case AstNodeType::NEW_EXPRESSION: {
+      auto new_expr = ast_node->AsNewExpression();
+      WriteNode(new_expr->GetConstructor());
+      WriteNodes(new_expr->GetArguments());
+      break;
+    }
+    case AstNodeType::CALL_EXPRESSION: {
+      auto call_expr = ast_node->AsCallExpression();
+      WriteNode(call_expr->GetCallee());
+      WriteNodes(call_expr->GetArguments());
+      break;
+    }
+    case AstNodeType::MEMBER_EXPRESSION: {
+      auto mem_expr = ast_node->AsMemberExpression();
+      WriteNode(mem_expr->GetObject());
+      WriteNode(mem_expr->GetProperty());
+      Write<std::uint8_t>(mem_expr->IsDot());
+      break;
+    }
+    case AstNodeType::POSTFIX_EXPRESSION: {
+      auto post_expr = ast_node->AsPostfixExpression();
+      Write(static_cast<std::uint16_t>(post_expr->GetOperator()));
+      WriteNode(post_expr->GetExpression());
+      break;
+    }
+    case AstNodeType::UNARY_EXPRESSION: {
+      auto unary_expr = ast_node->AsUnaryExpression();
+      Write(static_cast<std::uint16_t>(unary_expr->GetOperator()));
+      WriteNode(unary_expr->GetExpression());
+      break;
+    }
+    case AstNodeType::BINARY_EXPRESSION: {
+      auto binary_expr = ast_node->AsBinaryExpression();
+      Write(static_cast<std::uint16_t>(binary_expr->GetOperator()));
+      WriteNode(binary_expr->GetLeft());
+      WriteNode(binary_expr->GetRight());
+      break;
+    }
+    case AstNodeType::CONDITIONAL_EXPRESSION: {
+      auto cond_expr = ast_node->AsConditionalExpression();
+      WriteNode(cond_expr->GetConditional());
+      WriteNode(cond_expr->GetConsequent());
+      WriteNode(cond_expr->GetAlternate());
+      break;
+    }
+    case AstNodeType::ASSIGNMENT_EXPRESSION: {
+      auto assign_expr = ast_node->AsAssignmentExpression();
+      Write(static_cast<std::uint16_t>(assign_expr->GetOperator()));
+      WriteNode(assign_expr->GetLeft());
+      WriteNode(assign_expr->GetRight());
+      break;
+    }
+    case AstNodeType::SEQUENCE_EXPRESSION: {
+      WriteNodes(ast_node->AsSequenceExpression()->GetExpressions());
+      break;
+    }
+    case AstNodeType::FUNCTION_EXPRESSION: {
+      WriteFunction(ast_node->AsFunctionExpression());
+      break;
+    }
+    case AstNodeType::BOOLEAN_LITERAL: {
+      Write<std::uint8_t>(ast_node->AsBooleanLiteral()->GetBoolean());
+      break;
+    }
+    case AstNodeType::NUMERIC_LITERAL: {
+      Write(ast_node->AsNumericLiteral()->GetDouble());
+      break;
+    }
+    case AstNodeType::STRING_LITERAL: {
+      WriteString(ast_node->AsStringLiteral()->GetString());
+      break;
+    }
+    case AstNodeType::IDENTIFIER: {
+      WriteString(ast_node->AsIdentifier()->GetName());
+      Write<std::int32_t>(ast_node->AsIdentifier()->GetSlot());
+      break;
+    }
+    case AstNodeType::VARIABLE_DECLARATION: {
+      auto var_decl = ast_node->AsVariableDeclaration();
+      WriteNode(var_decl->GetIdentifier());
+      WriteNode(var_decl->GetInitializer());
+      break;
+    }
+    case AstNodeType::ARRAY_LITERAL: {
+      WriteNodes(ast_node->AsArrayLiteral()->GetElements());
+      break;
+    }
+    case AstNodeType::OBJECT_LITERAL: {
+      WriteNodes(ast_node->AsObjectLiteral()->GetProperties());
+      break;
+    }
+    case AstNodeType::PROPERTY: {
+      auto prop = ast_node->AsProperty();
+      Write(static_cast<std::uint8_t>(prop->GetPropertyType()));
+      WriteNode(prop->GetKey());
+      WriteNode(prop->GetValue());
+      break;
+    }
+    case AstNodeType::CASE_CLAUSE: {
+      auto case_clause = ast_node->AsCaseClause();
+      WriteNode(case_clause->GetCondition());
+      WriteNodes(case_clause->GetStatements());
+      break;
+    }
+    case AstNodeType::FUNCTION_DECLARATION: {
+      WriteFunction(ast_node->AsFunctionDeclaration());
+      break;
+    }
+    default: {
+      // EmptyStatement, DebuggerStatement, This and NullLiteral carry nothing but their type
+      break;
+    }
+  }
+}
+
+template <typename T>
+void Serializer::WriteNodes(const utils::ArenaVector<T*>& ast_nodes) {
+  Write(static_cast<std::uint32_t>(ast_nodes.size()));
+  for (auto ast_node : ast_nodes) {
+    WriteNode(ast_node);
+  }
+}
+
+template <typename T>
+void Serializer::WriteFunction(const T* func) {
+  WriteNode(func->GetName());
+  WriteNodes(func->GetParameters());
+  Write<std::uint8_t>(func->IsStrict());
+  Write<std::uint8_t>(func->UsesArguments());
+  Write<std::int32_t>(func->GetFrameSlotNum());
+  WriteNodes(func->GetStatements());
+  WriteNodes(func->GetVariableDeclarations());
+  WriteNodes(func->GetFunctionDeclarations());
+  WriteString(func->GetLazyBody());
+}
+
+void Serializer::WriteString(std::u16string_view str) {
+  auto [iter, inserted] = string_indices_.emplace(str, string_indices_.size());
+  if (inserted) {
+    std::uint32_t length = str.size();
+    strings_.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    strings_.append(reinterpret_cast<const char*>(str.data()), str.size() * sizeof(char16_t));
+  }
+  Write(iter->second);
+}
+
+Program* Deserializer::Deserialize() {
+  auto count = Read<std::uint32_t>();
+  strings_.reserve(std::min<std::size_t>(count, end_ - cur_));
+  for (std::uint32_t i = 0; i < count && !failed_; ++i) {
+    auto length = Read<std::uint32_t>();
+    std::size_t size = static_cast<std::size_t>(length) * sizeof(char16_t);
+    if (static_cast<std::size_t>(end_ - cur_) < size) {
+      failed_ = true;
+      break;
+    }
+    // The data may not be aligned for char16_t, so the characters are copied into the Arena
+    auto chars = static_cast<char16_t*>(arena_->Allocate(size));
+    std::memcpy(chars, cur_, size);
+    cur_ += size;
+    strings_.emplace_back(chars, length);
+  }
+
+  bool is_strict = Read<std::uint8_t>();
+  auto stmts = ReadNodes<Statement>();
+  auto var_decls = ReadNodes<VariableDeclaration>();
+  auto func_decls = ReadNodes<FunctionDeclaration>();
+
+  if (failed_ || cur_ != end_) {
+    return nullptr;
+  }
+
+  return new Program(std::move(arena_), std::move(stmts), is_strict, std::move(var_decls), std::move(func_decls));
+}
+
+AstNode* Deserializer::ReadNode() {
+  auto ref = Read<std::uint32_t>();
+  if (failed_ || ref == NULL_NODE) {
+    return nullptr;
+  }
+
+  if (ref != NEW_NODE) {
+    if (ref > nodes_.size() || !nodes_[ref - 1]) {
+      failed_ = true;
+      return nullptr;
+    }
+    return nodes_[ref - 1];
+  }
+
+  // The slot is taken before the children are read to keep the pre-order numbering of Serializer
+  auto index = nodes_.size();
+  nodes_.push_back(nullptr);
+  auto type = static_cast<AstNodeType>(Read<std::uint8_t>());
+  auto ast_node = failed_ ? nullptr : ReadNodeBody(type);
+  nodes_[index] = ast_node;
+  return ast_node;
+}
+
+AstNode* Deserializer::ReadNodeBody(AstNodeType type) {
+  switch (type) {
+    case AstNodeType::BLOCK_STATEMENT: {
+      auto stmts = ReadNodes<Statement>();
+      return NewNode<BlockStatement>(std::move(stmts));
+    }
+    case AstNodeType::VARIABLE_STATEMENT: {
+      auto var_decls = ReadNodes<VariableDeclaration>();
+      return NewNode<VariableStatement>(std::move(var_decls));
+    }
+    case AstNodeType::EMPTY_STATEMENT: {
+      return NewNode<EmptyStatement>();
+    }
+    case AstNodeType::EXPRESSION_STATEMENT: {
+      auto expr = ReadNodeAs<Expression>();
+      return NewNode<ExpressionStatement>(expr);
+    }
+    case AstNodeType::IF_STATEMENT: {
+      auto cond = ReadNodeAs<Expression>();
+      auto cons = ReadNodeAs<Statement>();
+      auto alter = ReadNodeAs<Statement>();
+      return NewNode<IfStatement>(cond, cons, alter);
+    }
+    case AstNodeType::DO_WHILE_STATEMENT: {
+      auto cond = ReadNodeAs<Expression>();
+      auto body = ReadNodeAs<Statement>();
+      return NewNode<DoWhileStatement>(cond, body);
+    }
+    case AstNodeType::WHILE_STATEMENT: {
+      auto cond = ReadNodeAs<Expression>();
+      auto body = ReadNodeAs<Statement>();
+      return NewNode<WhileStatement>(cond, body);
+    }
+    case AstNodeType::FOR_STATEMENT: {
+      auto initializer = ReadNode();
+      auto cond = ReadNodeAs<Expression>();
+      auto update = ReadNodeAs<Expression>();
+      auto body = ReadNodeAs<Statement>();
+      return NewNode<ForStatement>(initializer, cond, update, body);
+    }
+    case AstNodeType::FOR_IN_STATEMENT: {
+      auto left = ReadNode();
+      auto right = ReadNodeAs<Expression>();
+      auto body = ReadNodeAs<Statement>();
+      return NewNode<ForInStatement>(left, right, body);
+    }
+    case AstNodeType::CONTINUE_STATEMENT: {
+      auto ident = ReadNodeAs<Expression>();
+      return NewNode<ContinueStatement>(ident);
+    }
+    case AstNodeType::BREAK_STATEMENT: {
+      auto ident = ReadNodeAs<Expression>();
+      return NewNode<BreakStatement>(ident);
+    }
+    case AstNodeType::RETURN_STATEMENT: {
+      auto expr = ReadNodeAs<Expression>();
+      return NewNode<ReturnStatement>(expr);
+    }
+    case AstNodeType::WITH_STATEMENT: {
+      auto context = ReadNodeAs<Expression>();
+      auto body = ReadNodeAs<Statement>();
+      return NewNode<WithStatement>(context, body);
+    }
+    case AstNodeType::SWITCH_STATEMENT: {
+      auto discriminant = ReadNodeAs<Expression>();
+      auto case_clauses = ReadNodes<CaseClause>();
+      return NewNode<SwitchStatement>(discriminant, std::move(case_clauses));
+    }
+    case AstNodeType::LABELLED_STATEMENT: {
+      auto label = ReadNodeAs<Expression>();
+      auto body = ReadNodeAs<Statement>();
+      return NewNode<LabelledStatement>(label, body);
+    }
+    case AstNodeType::THROW_STATEMENT: {
+      auto expr = ReadNodeAs<Expression>();
+      return NewNode<ThrowStatement>(expr);
+    }
+    case AstNodeType::TRY_STATEMENT: {
+      auto body = ReadNodeAs<Statement>();
+      auto catch_name = ReadNodeAs<Expression>();
+      auto catch_block = ReadNodeAs<Statement>();
+      auto finally_block = ReadNodeAs<Statement>();
+      return NewNode<TryStatement>(body, catch_name, catch_block, finally_block);
+    }
+    case AstNodeType::DEBUGGER_STATEMENT: {
+      return NewNode<DebuggerStatement>();
+    }
+    case AstNodeType::NEW_EXPRESSION: {
+      auto constructor = ReadNodeAs<Expression>();
+      auto args = ReadNodes<Expression>();
+      return NewNode<NewExpression>(constructor, std::move(args));
+    }
+    case AstNodeType::CALL_EXPRESSION: {
+      auto callee = ReadNodeAs<Expression>();
+      auto args = ReadNodes<Expression>();
+      return NewNode<CallExpression>(callee, std::move(args));
+    }
+    case AstNodeType::MEMBER_EXPRESSION: {
+      auto object = ReadNodeAs<Expression>();
+      auto prop = ReadNodeAs<Expression>();
+      bool is_dot = Read<std::uint8_t>();
+      return NewNode<MemberExpression>(object, prop, is_dot);
+    }
+    case AstNodeType::POSTFIX_EXPRESSION: {
+      auto op = static_cast<TokenType>(Read<std::uint16_t>());
+      auto expr = ReadNodeAs<Expression>();
+      return NewNode<PostfixExpression>(op, expr);
+    }
+    case AstNodeType::UNARY_EXPRESSION: {
+      auto op = static_cast<TokenType>(Read<std::uint16_t>());
+      auto expr = ReadNodeAs<Expression>();
+      return NewNode<UnaryExpression>(op, expr);
+    }
+    case AstNodeType::BINARY_EXPRESSION: {
+      auto op = static_cast<TokenType>(Read<std::uint16_t>());
+      auto left = ReadNodeAs<Expression>();
+      auto right = ReadNodeAs<Expression>();
+      return NewNode<BinaryExpression>(op, left, right);
+    }
+    case AstNodeType::CONDITIONAL_EXPRESSION: {
+      auto cond = ReadNodeAs<Expression>();
+      auto cons = ReadNodeAs<Expression>();
+      auto alter = ReadNodeAs<Expression>();
+      return NewNode<ConditionalExpression>(cond, cons, alter);
+    }
+    case AstNodeType::ASSIGNMENT_EXPRESSION: {
+      auto op = static_cast<TokenType>(Read<std::uint16_t>());
+      auto left = ReadNodeAs<Expression>();
+      auto right = ReadNodeAs<Expression>();
+      return NewNode<AssignmentExpression>(op, left, right);
+    }
+    case AstNodeType::SEQUENCE_EXPRESSION: {
+      auto exprs = ReadNodes<Expression>();
+      return NewNode<SequenceExpression>(std::move(exprs));
+    }
+    case AstNodeType::FUNCTION_EXPRESSION: {
+      return ReadFunction<FunctionExpression>();
+    }
+    case AstNodeType::NULL_LITERAL: {
+      return NewNode<NullLiteral>();
+    }
+    case AstNodeType::BOOLEAN_LITERAL: {
+      bool boolean = Read<std::uint8_t>();
+      return NewNode<BooleanLiteral>(boolean);
+    }
+    case AstNodeType::NUMERIC_LITERAL: {
+      auto number = Read<double>();
+      return NewNode<NumericLiteral>(number);
+    }
+    case AstNodeType::STRING_LITERAL: {
+      auto str = ReadString();
+      return NewNode<StringLiteral>(str);
+    }
+    case AstNodeType::THIS: {
+      return NewNode<This>();
+    }
+    case AstNodeType::IDENTIFIER: {
+      auto name = ReadString();
+      auto ident = NewNode<Identifier>(name);
+      ident->SetSlot(Read<std::int32_t>());
+      return ident;
+    }
+    case AstNodeType::VARIABLE_DECLARATION: {
+      auto ident = ReadNodeAs<Expression>();
+      auto initializer = ReadNodeAs<Expression>();
+      return NewNode<VariableDeclaration>(ident, initializer);
+    }
+    case AstNodeType::ARRAY_LITERAL: {
+      auto elements = ReadNodes<Expression>();
+      return NewNode<ArrayLiteral>(std::move(elements));
+    }
+    case AstNodeType::OBJECT_LITERAL: {
+      auto props = ReadNodes<Property>();
+      return NewNode<ObjectLiteral>(std::move(props));
+    }
+    case AstNodeType::PROPERTY: {
+      auto type = static_cast<PropertyType>(Read<std::uint8_t>());
+      auto key = ReadNodeAs<Expression>();
+      auto value = ReadNodeAs<Expression>();
+      return NewNode<Property>(type, key, value);
+    }
+    case AstNodeType::CASE_CLAUSE: {
+      auto cond = ReadNodeAs<Expression>();
+      auto stmts = ReadNodes<Statement>();
+      return NewNode<CaseClause>(cond, std::move(stmts));
+    }
+    case AstNodeType::FUNCTION_DECLARATION: {
+      return ReadFunction<FunctionDeclaration>();
+    }
+    default: {
+      failed_ = true;
+      return nullptr;
+    }
+  }
+}
+
+template <typename T>
+utils::ArenaVector<T*> Deserializer::ReadNodes() {
+  utils::ArenaVector<T*> ast_nodes{arena_.get()};
+  auto count = Read<std::uint32_t>();
+  // Every reference takes at least 4 bytes, which bounds the count of malformed data
+  ast_nodes.reserve(std::min<std::size_t>(count, (end_ - cur_) / sizeof(std::uint32_t)));
+  for (std::uint32_t i = 0; i < count && !failed_; ++i) {
+    ast_nodes.push_back(ReadNodeAs<T>());
+  }
+  return ast_nodes;
+}
+
+template <typename T>
+T* Deserializer::ReadFunction() {
+  auto name = ReadNodeAs<Expression>();
+  auto params = ReadNodes<Expression>();
+  bool is_strict = Read<std::uint8_t>();
+  bool uses_arguments = Read<std::uint8_t>();
+  auto frame_slot_num = Read<std::int32_t>();
+  auto stmts = ReadNodes<Statement>();
+  auto var_decls = ReadNodes<VariableDeclaration>();
+  auto func_decls = ReadNodes<FunctionDeclaration>();
+  auto lazy_body = ReadString();
+  auto func = NewNode<T>(name, std::move(params), std::move(stmts), is_strict,
+                         std::move(var_decls), std::move(func_decls));
+  func->SetLazyBody(lazy_body);
+  func->SetUsesArguments(uses_arguments);
+  func->SetFrameSlotNum(frame_slot_num);
+
+  // The BindingPlan is not serialized, it follows from the rest of the function
+  if (!failed_ && !func->IsLazy() && !func->KeepsLocalsInFrame()) {
+    func->SetBindingPlan(BindingPlan::New(arena_.get(), func->GetParameters(), func->GetVariableDeclarations(),
+                                          func->GetFunctionDeclarations(), uses_arguments));
+  }
+  return func;
+}
+
+std::u16string_view Deserializer::ReadString() {
+  auto index = Read<std::uint32_t>();
+  if (failed_ || index >= strings_.size()) {
+    failed_ = true;
+    return {};
+  }
+  return strings_[index];
+}
+
+}  // namespace ast
+}  // namespace voidjs
@@ -0,0 +1,105 @@
+#ifndef VOIDJS_IR_SERIALIZER_H
+#define VOIDJS_IR_SERIALIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "voidjs/ir/ast.h"
+#include "voidjs/utils/arena.h"
+#include "voidjs/utils/helper.h"
+
+namespace voidjs {
+namespace ast {
+
+// The serialized form of a Program is laid out as
+//   string table : count, then the length and the characters of each string
+//   program      : strict flag, statements, variable declarations, function declarations
+// Every node is written once in pre-order and referred to by its index afterwards,
+// since declarations appear both in the statements and in the lists of their scope.
+// Numbers are stored in the byte order of the host.
+
+// Serializer writes a Program into a flat buffer
+class Serializer {
+ public:
+  explicit Serializer(const Program* program);
+
+  std::string GetData() const;
+
+ private:
+  void WriteNode(const AstNode* ast_node);
+  void WriteNodeBody(const AstNode* ast_node);
+  template <typename T>
+  void WriteNodes(const utils::ArenaVector<T*>& ast_nodes);
+  template <typename T>
+  void WriteFunction(const T* func);
+  void WriteString(std::u16string_view str);
+
+  template <typename T>
+  void Write(T value) {
+    buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+ private:
+  std::string buffer_;
+  std::string strings_;
+  std::unordered_map<const AstNode*, std::uint32_t> node_indices_;
+  std::unordered_map<std::u16string_view, std::uint32_t,
+                     utils::detail::hash<std::u16string_view>> string_indices_;
+};
+
+// Deserializer rebuilds a Program from the output of Serializer in a new Arena,
+// without running the Lexer or the Parser.
+class Deserializer {
+ public:
+  Deserializer(const std::uint8_t* data, std::size_t size)
+    : cur_(data), end_(data + size), arena_(new utils::Arena)
+  {}
+
+  // Returns nullptr if the data is malformed
+  Program* Deserialize();
+
+ private:
+  AstNode* ReadNode();
+  AstNode* ReadNodeBody(AstNodeType type);
+  template <typename T>
+  T* ReadNodeAs() { return static_cast<T*>(ReadNode()); }
+  template <typename T>
+  utils::ArenaVector<T*> ReadNodes();
+  template <typename T>
+  T* ReadFunction();
+  std::u16string_view ReadString();
+
+  template <typename T>
+  T Read() {
+    T value {};
+    if (static_cast<std::size_t>(end_ - cur_) < sizeof(T)) {
+      failed_ = true;
+      return value;
+    }
+    std::memcpy(&value, cur_, sizeof(T));
+    cur_ += sizeof(T);
+    return value;
+  }
+
+  template <typename T, typename... Args>
+  T* NewNode(Args&&... args) { return arena_->New<T>(std::forward<Args>(args)...); }
+
+ private:
+  const std::uint8_t* cur_;
+  const std::uint8_t* end_;
+  std::unique_ptr<utils::Arena> arena_;
+  std::vector<AstNode*> nodes_;
+  std::vector<std::u16string_view> strings_;
+  bool failed_ {false};
+};
+
+}  // namespace ast
+}  // namespace voidjs
+
+#endif  // VOIDJS_IR_SERIALIZER_H
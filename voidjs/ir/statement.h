@@ -355,7 +355,7 @@ class CaseClause : public Statement {
   {}
 
   Expression* GetCondition() const { return condition_; }
-  Statements GetStatements() const { return statements_; }
+  const Statements& GetStatements() const { return statements_; }
 
   bool IsDefault() const { return condition_ == nullptr; }
 
@@ -387,6 +387,40 @@ class FunctionDeclaration : public Statement {
 
   bool IsStrict() const { return is_strict_; }
 
+  // A lazily parsed function only keeps the source text of its body,
+  // the body is parsed into the same Arena when the function is first called.
+  bool IsLazy() const { return !lazy_body_.empty(); }
+  std::u16string_view GetLazyBody() const { return lazy_body_; }
+  utils::Arena* GetArena() const { return statements_.get_allocator().GetArena(); }
+  void SetLazyBody(std::u16string_view body) { lazy_body_ = body; }
+  void SetBody(Statements statements, VariableDeclarations var_decls, FunctionDeclarations func_decls,
+               bool uses_arguments, std::int32_t frame_slot_num, const BindingPlan* binding_plan) {
+    statements_ = std::move(statements);
+    variable_declarations_ = std::move(var_decls);
+    function_declarations_ = std::move(func_decls);
+    uses_arguments_ = uses_arguments;
+    frame_slot_num_ = frame_slot_num;
+    binding_plan_ = binding_plan;
+    lazy_body_ = {};
+  }
+
+  // Whether the body refers to arguments, or may do so through a direct call to eval.
+  // Only known once the body is parsed, the arguments object is not created otherwise.
+  bool UsesArguments() const { return uses_arguments_; }
+  void SetUsesArguments(bool uses_arguments) { uses_arguments_ = uses_arguments; }
+
+  // Whether the locals of the function can never be captured, by an inner function, with or eval.
+  // Its parameters, variables and catch parameters are then kept in GetFrameSlotNum slots of its frame,
+  // as resolved in Identifier::GetSlot, and calling it creates no environment.
+  bool KeepsLocalsInFrame() const { return frame_slot_num_ >= 0; }
+  std::int32_t GetFrameSlotNum() const { return frame_slot_num_; }
+  void SetFrameSlotNum(std::int32_t frame_slot_num) { frame_slot_num_ = frame_slot_num; }
+
+  // How Declaration Binding Instantiation binds the locals kept in an environment,
+  // nullptr while the body is lazy or if the locals are kept in the frame.
+  const BindingPlan* GetBindingPlan() const { return binding_plan_; }
+  void SetBindingPlan(const BindingPlan* binding_plan) { binding_plan_ = binding_plan; }
+
   void Dump(Dumper* dumper) const override;
 
  private:
@@ -397,6 +431,12 @@ class FunctionDeclaration : public Statement {
   
   VariableDeclarations variable_declarations_;
   FunctionDeclarations function_declarations_;
+
+  bool uses_arguments_ {};
+  std::int32_t frame_slot_num_ {-1};
+  const BindingPlan* binding_plan_ {};
+
+  std::u16string_view lazy_body_;
 };
 
 }  // namespace voidjs
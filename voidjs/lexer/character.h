@@ -1,6 +1,15 @@
 #ifndef VOIDJS_LEXER_CHARACTER_H
 #define VOIDJS_LEXER_CHARACTER_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "voidjs/lexer/unicode.h"
 
 namespace voidjs {
@@ -33,6 +42,28 @@ inline constexpr char16_t PS = 0x2029;  // Paragrah Separater
 // U+0000 means NULL in Unicode, here we use it to represent EOS
 inline constexpr char16_t EOS = 0x0000;
 
+// Classification of ASCII characters, looked up before the Unicode category tables
+inline constexpr std::uint8_t ASCII_IDENTIFIER_START = 1 << 0;
+inline constexpr std::uint8_t ASCII_IDENTIFIER_PART  = 1 << 1;
+inline constexpr std::uint8_t ASCII_WHITESPACE       = 1 << 2;
+
+inline constexpr std::array<std::uint8_t, 128> kAsciiTable = [] {
+  std::array<std::uint8_t, 128> table {};
+  for (char16_t ch = 0; ch < 128; ++ch) {
+    if ((u'a' <= ch && ch <= u'z') || (u'A' <= ch && ch <= u'Z') ||
+        ch == u'$' || ch == u'_' || ch == u'\\') {
+      table[ch] |= ASCII_IDENTIFIER_START | ASCII_IDENTIFIER_PART;
+    }
+    if (u'0' <= ch && ch <= u'9') {
+      table[ch] |= ASCII_IDENTIFIER_PART;
+    }
+    if (ch == TAB || ch == VT || ch == FF || ch == SP) {
+      table[ch] |= ASCII_WHITESPACE;
+    }
+  }
+  return table;
+}();
+
 // Unicode Character Categories "Space Separater"
 // https://www.compart.com/en/unicode/category/Zs
 constexpr bool IsUSP(char16_t ch) {
@@ -43,6 +74,9 @@ constexpr bool IsUSP(char16_t ch) {
 }
 
 constexpr bool IsWhitespace(char16_t ch) {
+  if (ch < 128) {
+    return kAsciiTable[ch] & ASCII_WHITESPACE;
+  }
   return
     ch == TAB || ch == VT      || ch == FF  ||
     ch == SP  || ch == HASHx0a || ch == BOM || IsUSP(ch);
@@ -72,10 +106,16 @@ inline bool IsUnicodeConnectorPunctuation(char16_t ch) {
 }
 
 inline bool IsIdentifierStart(char16_t ch) {
+  if (ch < 128) {
+    return kAsciiTable[ch] & ASCII_IDENTIFIER_START;
+  }
   return IsUnicodeLetter(ch) || ch == u'$' || ch == u'_' || ch == u'\\';
 }
 
 inline bool IsIdentifierPart(char16_t ch) {
+  if (ch < 128) {
+    return kAsciiTable[ch] & ASCII_IDENTIFIER_PART;
+  }
   return
     IsIdentifierStart(ch) || IsUnicodeCombiningMark(ch)        ||
     IsUnicodeDigit(ch)   || IsUnicodeConnectorPunctuation(ch) ||
@@ -117,6 +157,126 @@ inline bool IsCharacterEscapeSequence(char16_t c) {
   return IsSingleEscapeCharacter(c) || IsNonEscapeCharacter(c);
 }
 
+// Bulk scanning
+// Each function below returns the position of the first character at or after pos
+// which ends the run it scans for, or src.size() if there is none.
+// Eight characters are tested at once with SSE2, the tail is tested one by one.
+namespace detail {
+
+template <typename SimdStop, typename Stop>
+inline std::size_t ScanUntil(std::u16string_view src, std::size_t pos, SimdStop simd_stop, Stop stop) {
+#if defined(__SSE2__)
+  while (pos + 8 <= src.size()) {
+    auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data() + pos));
+    std::uint32_t mask = _mm_movemask_epi8(simd_stop(chars));
+    if (mask) {
+      return pos + (__builtin_ctz(mask) >> 1);
+    }
+    pos += 8;
+  }
+#endif
+  while (pos < src.size() && !stop(src[pos])) {
+    ++pos;
+  }
+  return pos;
+}
+
+#if defined(__SSE2__)
+// Lanes of chars which lie in [lo, hi], compared as unsigned
+inline __m128i InRange(__m128i chars, char16_t lo, char16_t hi) {
+  auto bias = _mm_set1_epi16(static_cast<short>(0x8000));
+  auto biased = _mm_xor_si128(chars, bias);
+  auto below = _mm_cmplt_epi16(biased, _mm_xor_si128(_mm_set1_epi16(static_cast<short>(lo)), bias));
+  auto above = _mm_cmpgt_epi16(biased, _mm_xor_si128(_mm_set1_epi16(static_cast<short>(hi)), bias));
+  return _mm_andnot_si128(_mm_or_si128(below, above), _mm_set1_epi16(-1));
+}
+
+inline __m128i Equal(__m128i chars, char16_t ch) {
+  return _mm_cmpeq_epi16(chars, _mm_set1_epi16(static_cast<short>(ch)));
+}
+#endif
+
+}  // namespace detail
+
+// ASCII IdentifierPart: letters, digits, $ and _ (but not \, which starts an escape)
+inline std::size_t SkipAsciiIdentifierPart(std::u16string_view src, std::size_t pos) {
+  return detail::ScanUntil(
+    src, pos,
+#if defined(__SSE2__)
+    [](__m128i chars) {
+      auto part = _mm_or_si128(
+        _mm_or_si128(detail::InRange(chars, u'a', u'z'), detail::InRange(chars, u'A', u'Z')),
+        _mm_or_si128(detail::InRange(chars, u'0', u'9'),
+                     _mm_or_si128(detail::Equal(chars, u'$'), detail::Equal(chars, u'_'))));
+      return _mm_andnot_si128(part, _mm_set1_epi16(-1));
+    },
+#else
+    nullptr,
+#endif
+    [](char16_t ch) { return ch == u'\\' || !(ch < 128 && kAsciiTable[ch] & ASCII_IDENTIFIER_PART); });
+}
+
+// Spaces and tabs
+inline std::size_t SkipAsciiWhitespace(std::u16string_view src, std::size_t pos) {
+  return detail::ScanUntil(
+    src, pos,
+#if defined(__SSE2__)
+    [](__m128i chars) {
+      auto space = _mm_or_si128(detail::Equal(chars, SP), detail::Equal(chars, TAB));
+      return _mm_andnot_si128(space, _mm_set1_epi16(-1));
+    },
+#else
+    nullptr,
+#endif
+    [](char16_t ch) { return ch != SP && ch != TAB; });
+}
+
+// Body of a SingleLineComment, ends at a LineTerminator or EOS
+inline std::size_t FindSingleLineCommentEnd(std::u16string_view src, std::size_t pos) {
+  return detail::ScanUntil(
+    src, pos,
+#if defined(__SSE2__)
+    [](__m128i chars) {
+      return _mm_or_si128(
+        _mm_or_si128(detail::Equal(chars, LF), detail::Equal(chars, CR)),
+        _mm_or_si128(detail::InRange(chars, LS, PS), detail::Equal(chars, EOS)));
+    },
+#else
+    nullptr,
+#endif
+    [](char16_t ch) { return ch == EOS || IsLineTerminator(ch); });
+}
+
+// Body of a MultiLineComment, stops at every * (which may start */) or EOS
+inline std::size_t FindMultiLineCommentStop(std::u16string_view src, std::size_t pos) {
+  return detail::ScanUntil(
+    src, pos,
+#if defined(__SSE2__)
+    [](__m128i chars) {
+      return _mm_or_si128(detail::Equal(chars, u'*'), detail::Equal(chars, EOS));
+    },
+#else
+    nullptr,
+#endif
+    [](char16_t ch) { return ch == u'*' || ch == EOS; });
+}
+
+// Body of a StringLiteral quoted by quote, stops at the quote, \ or EOS
+inline std::size_t FindStringLiteralStop(std::u16string_view src, std::size_t pos, char16_t quote) {
+  return detail::ScanUntil(
+    src, pos,
+#if defined(__SSE2__)
+    [quote](__m128i chars) {
+      return _mm_or_si128(
+        detail::Equal(chars, quote),
+        _mm_or_si128(detail::Equal(chars, u'\\'), detail::Equal(chars, EOS)));
+    },
+#else
+    nullptr,
+#endif
+    [quote](char16_t ch) { return ch == quote || ch == u'\\' || ch == EOS; });
+}
+
 // This code is copied directly from https://github.com/zhuzilin/es/blob/67fb4d579bb142669acd8384ea34c62cd052945c/es/parser/character.h#L166
 inline char16_t ToLowerCase(char16_t c) {
   if ('A' <= c && c <= 'Z') {
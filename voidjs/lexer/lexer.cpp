@@ -23,6 +23,7 @@ void Lexer::NextToken() {
   // go back to start when encounter Line Terminator
  start:
   SkipWhitespace();
+  token_start_ = cur_;
   
   switch (ch_) {
     // Punctuator
@@ -300,20 +301,16 @@ void Lexer::NextToken() {
 
 Token Lexer::NextRewindToken() {
   std::size_t start = cur_;
+  std::size_t token_start = token_start_;
   auto token = token_;
   
   NextToken();
   auto ret = token_;
   
-  cur_ = start;
-  nxt_ = cur_ + 1;
-  if (cur_ < src_.size()) {
-    ch_ = src_.at(cur_);
-  } else {
-    ch_ = character::EOS;
-  }
+  SeekTo(start);
   has_line_terminator_ = false;
   token_ = token;
+  token_start_ = token_start;
   
   return ret;
 }
@@ -325,7 +322,7 @@ bool Lexer::HasLineTerminator() {
 char16_t Lexer::NextChar() {
   cur_ = nxt_++;
   if (cur_ < src_.size()) {
-    ch_ = src_.at(cur_);
+    ch_ = src_[cur_];
   } else {
     ch_= character::EOS;
   }
@@ -334,20 +331,31 @@ char16_t Lexer::NextChar() {
 
 char16_t Lexer::PeekChar() {
   if (nxt_ < src_.size()) {
-    return src_.at(nxt_);
+    return src_[nxt_];
   } else {
     return character::EOS;
   }
 }
 
+void Lexer::SeekTo(std::size_t pos) {
+  cur_ = pos;
+  nxt_ = pos + 1;
+  if (cur_ < src_.size()) {
+    ch_ = src_[cur_];
+  } else {
+    ch_ = character::EOS;
+  }
+}
+
 void Lexer::SkipWhitespace() {
   while (character::IsWhitespace(ch_)) {
-    NextChar();
+    // Spaces and tabs following it are skipped in bulk
+    SeekTo(character::SkipAsciiWhitespace(src_, cur_ + 1));
   }
 }
 
 // Assume input string is always vaild
-double Lexer::ConvertToNumber(std::u16string source) {
+double Lexer::ConvertToNumber(std::u16string_view source) {
   double ret = 0;
   double val = 0;
   bool dot = false;
@@ -406,7 +414,8 @@ double Lexer::ConvertToNumber(std::u16string source) {
 
 // Assume input string is always valid
 // Copy from https://github.com/zhuzilin/es/blob/67fb4d579bb142669acd8384ea34c62cd052945c/es/impl/base-impl.h#L121
-std::u16string Lexer::ConvertToString(std::u16string source) {
+// The result refers to source itself unless the literal contains escapes.
+std::u16string_view Lexer::ConvertToString(std::u16string_view source) {
   size_t pos = 1;
   std::u16string vals;
   auto ToDigit = [](char16_t ch) -> char16_t {
@@ -504,12 +513,7 @@ std::u16string Lexer::ConvertToString(std::u16string source) {
       }
     }
   }
-  if (vals.size() == 0) {
-    return {};
-  } else if (vals.size() == 1) {
-    return std::u16string(1, vals[0]);
-  }
-  return vals;
+  return arena_->NewString(vals);
 }
 
 // Skip line terminator
@@ -542,9 +546,7 @@ TokenType Lexer::SkipSingleLineComment() {
   }
   NextChar();
   NextChar();
-  while (ch_ != character::EOS && !character::IsLineTerminator(ch_)) {
-    NextChar();
-  }
+  SeekTo(character::FindSingleLineCommentEnd(src_, cur_));
   return TokenType::SINGLE_LINE_COMMENT;
 }
 
@@ -559,8 +561,12 @@ TokenType Lexer::SkipMultiLineComment() {
   }
   NextChar();
   NextChar();
-  while (ch_ != character::EOS) {
-    if (ch_ == u'*' && PeekChar() == u'/') {
+  while (true) {
+    SeekTo(character::FindMultiLineCommentStop(src_, cur_));
+    if (ch_ == character::EOS) {
+      break;
+    }
+    if (PeekChar() == u'/') {
       NextChar();
       NextChar();
       return TokenType::MULTI_LINE_COMMENT;
@@ -787,58 +793,40 @@ bool Lexer::SkipDoubleStringCharacter() {
 // where they contribute a single character to the IdentifierName,
 // as computed by the CV of the UnicodeEscapeSequence (see 7.8.4).
 void Lexer::ScanIdentifier() {
-  std::u16string ident_name;
   std::size_t start = cur_;
 
-  // IdentifierStart
-  if (ch_ == u'\\') {
-    if (auto ret = SkipUnicodeEscapeSequence(); ret.has_value()) {
-      ident_name.push_back(ret.value());
-    } else {
-      token_.SetType(TokenType::ILLEGAL);
-      return ;
+  // Identifiers without escapes, which are the common case, refer to src_ directly.
+  // Runs of ASCII characters are skipped in bulk.
+  while (true) {
+    SeekTo(character::SkipAsciiIdentifierPart(src_, cur_));
+    if (ch_ < 128 || !character::IsIdentifierPart(ch_)) {
+      break;
     }
-  } else {
-    ident_name.push_back(ch_);
     NextChar();
   }
-  
-  while (character::IsIdentifierPart(ch_)) {
-    if (ch_ == u'\\') {
-      if (auto ret = SkipUnicodeEscapeSequence(); ret.has_value()) {
-        ident_name.push_back(ret.value());
+  std::u16string_view ident_name = src_.substr(start, cur_ - start);
+
+  if (ch_ == u'\\') {
+    std::u16string escaped_name {ident_name};
+    while (character::IsIdentifierPart(ch_)) {
+      if (ch_ == u'\\') {
+        if (auto ret = SkipUnicodeEscapeSequence(); ret.has_value()) {
+          escaped_name.push_back(ret.value());
+        } else {
+          token_.SetType(TokenType::ILLEGAL);
+          return ;
+        }
       } else {
-        token_.SetType(TokenType::ILLEGAL);
-        return ;
+        escaped_name.push_back(ch_);
+        NextChar();
       }
-    } else {
-      ident_name.push_back(ch_);
-      NextChar();
     }
+    ident_name = arena_->NewString(escaped_name);
   }
 
   // ReservedWord
-  if (ident_name == u"null") {
-    token_.SetType(TokenType::NULL_LITERAL);
-  } else if (ident_name == u"true" || ident_name == u"false") {
-    token_.SetType(ident_name == u"true" ? TokenType::TRUE: TokenType::FALSE);
-  } else if (std::find(kKeywords.begin(), kKeywords.end(), ident_name) != kKeywords.end()) {
-    token_.SetType(kStringToKeywords.at(ident_name));
-    token_.SetString(std::move(ident_name));
-  } else if (std::find(kFutureReservedWords.begin(),
-                       kFutureReservedWords.end(), ident_name) != kFutureReservedWords.end()) {
-    token_.SetType(TokenType::FUTURE_RESERVED_WORD);
-    token_.SetString(std::move(ident_name));
-  }
-  // else if (std::find(kStrictModeFutureReservedWords.begin(),
-  //                    kStrictModeFutureReservedWords.end(), ident_name) != kStrictModeFutureReservedWords.end()) {
-  //   token_.SetType(TokenType::STRICT_MODE_FUTURE_RESERVED_WORD);
-  //   token_.SetString(std::move(ident_name));
-  // }
-  else {
-    token_.SetType(TokenType::IDENTIFIER);
-    token_.SetString(std::move(ident_name));
-  }
+  token_.SetType(Token::LookupReservedWord(ident_name));
+  token_.SetString(ident_name);
 }
 
 // Scan NumericLiteral
@@ -913,7 +901,7 @@ void Lexer::ScanStringLiteral() {
       return ;
         }
       } else {
-        NextChar();
+        SeekTo(character::FindStringLiteralStop(src_, cur_ + 1, u'\''));
       }
     }
     // ' not found
@@ -931,7 +919,7 @@ void Lexer::ScanStringLiteral() {
       return ;
         }
       } else {
-        NextChar();
+        SeekTo(character::FindStringLiteralStop(src_, cur_ + 1, u'"'));
       }
     }
     // " not found
@@ -2,17 +2,26 @@
 #define VOIDJS_LEXER_LEXER_H
 
 #include <string>
+#include <string_view>
 #include <optional>
+#include <memory>
 
 #include "voidjs/lexer/character.h"
 #include "voidjs/lexer/token.h"
+#include "voidjs/utils/arena.h"
 
 namespace voidjs {
 
+// Lexer does not copy the source, src must outlive the Lexer and the Tokens it produces.
+// Literals with escapes are materialized in arena, or in an Arena owned by the Lexer if none is given.
 class Lexer {
  public:
-  explicit Lexer(const std::u16string& src)
-    : src_(src), cur_(0), nxt_(1) {
+  explicit Lexer(std::u16string_view src, utils::Arena* arena = nullptr)
+    : src_(src), arena_(arena), cur_(0), nxt_(1) {
+    if (!arena_) {
+      own_arena_ = std::make_unique<utils::Arena>();
+      arena_ = own_arena_.get();
+    }
     if (!src_.empty()) {
       ch_ = src_.at(0);
     } else {
@@ -33,9 +42,23 @@ class Lexer {
   Token& GetToken() { return token_; }
   const Token& GetToken() const { return token_; }
 
+  // Literals are materialized in arena from now on, the string of the current Token
+  // is copied there too, so that the previous Arena may be released.
+  void SetArena(utils::Arena* arena) {
+    arena_ = arena;
+    if (token_.HasString()) {
+      token_.SetString(arena_->NewString(token_.GetString()));
+    }
+  }
+
+  // Offset in the source where the current Token starts
+  std::size_t GetTokenOffset() const { return token_start_; }
+  std::u16string_view GetSource() const { return src_; }
+
  private:
   char16_t NextChar();
   char16_t PeekChar();
+  void SeekTo(std::size_t pos);
 
   void SkipWhitespace();
   bool SkipLineTerminatorSequence();
@@ -58,15 +81,18 @@ class Lexer {
   void ScanNumericLiteral();
   void ScanStringLiteral();
 
-  double ConvertToNumber(std::u16string source);
-  std::u16string ConvertToString(std::u16string source);
+  double ConvertToNumber(std::u16string_view source);
+  std::u16string_view ConvertToString(std::u16string_view source);
   
  private:
-  std::u16string src_;
+  std::u16string_view src_;
+  utils::Arena* arena_;
+  std::unique_ptr<utils::Arena> own_arena_;
   Token token_;
   char16_t ch_ {};
   std::size_t cur_ {};
   std::size_t nxt_ {};
+  std::size_t token_start_ {};
   bool has_line_terminator_ {};
 };
 
@@ -1,4 +1,6 @@
 #include <cmath>
+#include <array>
+#include <string_view>
 
 #include "voidjs/lexer/token.h"
 #include "voidjs/lexer/character.h"
@@ -6,6 +8,69 @@
 
 namespace voidjs {
 
+namespace {
+
+struct ReservedWordEntry {
+  std::u16string_view word;
+  TokenType type {TokenType::IDENTIFIER};
+};
+
+// ReservedWord
+// Defined in ECMAScript 5.1 Chapter 7.6.1
+constexpr std::array<ReservedWordEntry, 36> kReservedWords = {{
+  {u"break", TokenType::KEYWORD_BREAK},         {u"do", TokenType::KEYWORD_DO},
+  {u"instanceof", TokenType::KEYWORD_INSTANCEOF}, {u"typeof", TokenType::KEYWORD_TYPEOF},
+  {u"case", TokenType::KEYWORD_CASE},           {u"else", TokenType::KEYWORD_ELSE},
+  {u"new", TokenType::KEYWORD_NEW},             {u"var", TokenType::KEYWORD_VAR},
+  {u"catch", TokenType::KEYWORD_CATCH},         {u"finally", TokenType::KEYWORD_FINALLY},
+  {u"return", TokenType::KEYWORD_RETURN},       {u"void", TokenType::KEYWORD_VOID},
+  {u"continue", TokenType::KEYWORD_CONTINUE},   {u"for", TokenType::KEYWORD_FOR},
+  {u"switch", TokenType::KEYWORD_SWITCH},       {u"while", TokenType::KEYWORD_WHILE},
+  {u"debugger", TokenType::KEYWORD_DEBUGGER},   {u"function", TokenType::KEYWORD_FUNCTION},
+  {u"this", TokenType::KEYWORD_THIS},           {u"with", TokenType::KEYWORD_WITH},
+  {u"default", TokenType::KEYWORD_DEFAULT},     {u"if", TokenType::KEYWORD_IF},
+  {u"throw", TokenType::KEYWORD_THROW},         {u"delete", TokenType::KEYWORD_DELETE},
+  {u"in", TokenType::KEYWORD_IN},               {u"try", TokenType::KEYWORD_TRY},
+  {u"null", TokenType::NULL_LITERAL},
+  {u"true", TokenType::TRUE},                   {u"false", TokenType::FALSE},
+  {u"class", TokenType::FUTURE_RESERVED_WORD},  {u"enum", TokenType::FUTURE_RESERVED_WORD},
+  {u"extends", TokenType::FUTURE_RESERVED_WORD}, {u"super", TokenType::FUTURE_RESERVED_WORD},
+  {u"const", TokenType::FUTURE_RESERVED_WORD},  {u"export", TokenType::FUTURE_RESERVED_WORD},
+  {u"import", TokenType::FUTURE_RESERVED_WORD},
+}};
+
+constexpr std::size_t RESERVED_WORD_MIN_LENGTH = 2;
+constexpr std::size_t RESERVED_WORD_MAX_LENGTH = 10;
+constexpr std::size_t RESERVED_WORD_TABLE_SIZE = 128;
+
+// The multiplier is chosen so that no two ReservedWords collide,
+// which is checked when kReservedWordTable is built at compile time.
+constexpr std::size_t HashReservedWord(std::u16string_view word) {
+  return (word.size() * 26 + word[0] + word[1]) & (RESERVED_WORD_TABLE_SIZE - 1);
+}
+
+constexpr auto kReservedWordTable = [] {
+  std::array<ReservedWordEntry, RESERVED_WORD_TABLE_SIZE> table {};
+  for (const auto& entry : kReservedWords) {
+    auto& slot = table[HashReservedWord(entry.word)];
+    if (!slot.word.empty()) {
+      throw "ReservedWords collide in kReservedWordTable";
+    }
+    slot = entry;
+  }
+  return table;
+}();
+
+}  // namespace
+
+TokenType Token::LookupReservedWord(std::u16string_view str) {
+  if (str.size() < RESERVED_WORD_MIN_LENGTH || str.size() > RESERVED_WORD_MAX_LENGTH) {
+    return TokenType::IDENTIFIER;
+  }
+  const auto& entry = kReservedWordTable[HashReservedWord(str)];
+  return entry.word == str ? entry.type : TokenType::IDENTIFIER;
+}
+
 std::int32_t Token::GetPrecedence() const {
   switch (type_) {
     case TokenType::LOGICAL_OR: {
@@ -2,15 +2,18 @@
 #define VOIDJS_LEXER_TOKEN_H
 
 #include <string>
+#include <string_view>
 
 #include "voidjs/lexer/token_type.h"
 
 namespace voidjs {
 
+// The string of a Token is a view, it refers either to the source buffer of the Lexer
+// or, when the literal contains escapes, to the text materialized in the Arena of the Lexer.
 class Token {
  public:
   Token() = default;
-  Token(TokenType type, std::u16string str = u"", double num = 0.0)
+  Token(TokenType type, std::u16string_view str = {}, double num = 0.0)
     : type_(type), string_(str), number_(num)
   {}
 
@@ -19,8 +22,8 @@ class Token {
   void SetType(TokenType type) { type_ = type; }
   TokenType GetType() const { return type_;}
 
-  void SetString(std::u16string str) { string_ = std::move(str); }
-  const std::u16string& GetString() const { return string_; }
+  void SetString(std::u16string_view str) { string_ = str; }
+  std::u16string_view GetString() const { return string_; }
 
   void SetNumber(double number) { number_ = number; }
   double GetNumber() const { return number_; }
@@ -36,10 +39,13 @@ class Token {
   bool HasString() const;
 
   static std::string_view TokenTypeToString(TokenType type);
+
+  // Returns the type of the ReservedWord spelled by str, or IDENTIFIER if it is not one
+  static TokenType LookupReservedWord(std::u16string_view str);
   
  private:
   TokenType type_ {TokenType::EOS};
-  std::u16string string_;
+  std::u16string_view string_;
   double number_ {};
 };
  
@@ -1,10 +1,6 @@
 #ifndef VOIDJS_LEXER_TOKEN_TYPE_H
 #define VOIDJS_LEXER_TOKEN_TYPE_H
 
-#include <array>
-#include <string>
-#include <unordered_map>
-
 namespace voidjs {
 
 // Defined in ECMAScript 5.1 Chapter 7
@@ -120,56 +116,6 @@ enum class TokenType {
   EOS, 
 };
 
-const std::unordered_map<std::u16string, TokenType> kStringToKeywords = {
-  {u"break", TokenType::KEYWORD_BREAK},
-  {u"do", TokenType::KEYWORD_DO},
-  {u"instanceof", TokenType::KEYWORD_INSTANCEOF},
-  {u"typeof", TokenType::KEYWORD_TYPEOF},
-  {u"case", TokenType::KEYWORD_CASE},
-  {u"else", TokenType::KEYWORD_ELSE},
-  {u"new", TokenType::KEYWORD_NEW},
-  {u"var", TokenType::KEYWORD_VAR},
-  {u"catch", TokenType::KEYWORD_CATCH},
-  {u"finally", TokenType::KEYWORD_FINALLY},
-  {u"return", TokenType::KEYWORD_RETURN},
-  {u"void", TokenType::KEYWORD_VOID},
-  {u"continue", TokenType::KEYWORD_CONTINUE},
-  {u"for", TokenType::KEYWORD_FOR},
-  {u"switch", TokenType::KEYWORD_SWITCH},
-  {u"while", TokenType::KEYWORD_WHILE},
-  {u"debugger", TokenType::KEYWORD_DEBUGGER},
-  {u"function", TokenType::KEYWORD_FUNCTION},
-  {u"this", TokenType::KEYWORD_THIS},
-  {u"with", TokenType::KEYWORD_WITH},
-  {u"default", TokenType::KEYWORD_DEFAULT},
-  {u"if", TokenType::KEYWORD_IF},
-  {u"throw", TokenType::KEYWORD_THROW},
-  {u"delete", TokenType::KEYWORD_DELETE},
-  {u"in", TokenType::KEYWORD_IN},
-  {u"try", TokenType::KEYWORD_TRY},
-};
-
-const std::array<std::u16string, 26> kKeywords = {
-  u"break",       u"do",         u"instanceof",  u"typeof",
-  u"case",        u"else",       u"new",         u"var",
-  u"catch",       u"finally",    u"return",      u"void",
-  u"continue",    u"for",        u"switch",      u"while",
-  u"debugger",    u"function",   u"this",        u"with",
-  u"default",     u"if",         u"throw",       u"delete",
-  u"in",          u"try",
-};
-
-const std::array<std::u16string, 7> kFutureReservedWords = {
-  u"class",       u"enum",       u"extends",     u"super",
-  u"const",       u"export",     u"import",
-};
-
-const std::array<std::u16string, 9> kStrictModeFutureReservedWords = {
-  u"implements",  u"let",        u"private",     u"public",
-  u"yield",       u"interface",  u"package",     u"protected",
-  u"static"
-};
-
 }  // namespace voidjs
 
 #endif  // VOIDJS_LEXER_TOKEN_TYPE_H
@@ -0,0 +1,91 @@
+#include "voidjs/parser/code_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <unistd.h>
+
+#include "voidjs/ir/serializer.h"
+#include "voidjs/utils/helper.h"
+#include "voidjs/utils/mapped_file.h"
+
+namespace voidjs {
+
+ast::Program* CodeCache::Load(std::string_view source) const {
+  utils::MappedFile file{GetPath(source)};
+  if (!file.IsMapped() || file.GetSize() < sizeof(Header)) {
+    return nullptr;
+  }
+
+  Header header;
+  std::memcpy(&header, file.GetData(), sizeof(Header));
+  if (std::memcmp(header.magic, "VJSC", 4) != 0 ||
+      header.version != VERSION ||
+      header.source_size != source.size() ||
+      header.source_hash != Hash(source) ||
+      header.payload_size != file.GetSize() - sizeof(Header)) {
+    return nullptr;
+  }
+
+  // A truncated or corrupted entry is treated as a miss
+  auto payload = file.GetData() + sizeof(Header);
+  if (header.payload_hash != Hash({reinterpret_cast<const char*>(payload), header.payload_size})) {
+    return nullptr;
+  }
+
+  ast::Deserializer deserializer{payload, header.payload_size};
+  return deserializer.Deserialize();
+}
+
+bool CodeCache::Store(std::string_view source, const ast::Program* program) const {
+  std::error_code ec;
+  std::filesystem::create_directories(dir_, ec);
+  if (ec) {
+    return false;
+  }
+
+  auto payload = ast::Serializer{program}.GetData();
+
+  Header header;
+  std::memcpy(header.magic, "VJSC", 4);
+  header.version = VERSION;
+  header.source_hash = Hash(source);
+  header.source_size = source.size();
+  header.payload_hash = Hash(payload);
+  header.payload_size = payload.size();
+
+  // Write to a private file first and rename it into place,
+  // so that processes sharing the directory never see a partial entry.
+  auto path = GetPath(source);
+  auto tmp_path = path + ".tmp" + std::to_string(::getpid());
+  {
+    std::ofstream file{tmp_path, std::ios::binary | std::ios::trunc};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(payload.data(), payload.size());
+    file.close();
+    if (!file) {
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+std::string CodeCache::GetPath(std::string_view source) const {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.vjsc", static_cast<unsigned long long>(Hash(source)));
+  return (std::filesystem::path{dir_} / name).string();
+}
+
+std::uint64_t CodeCache::Hash(std::string_view data) {
+  return utils::detail::wyhash::hash(data.data(), data.size());
+}
+
+}  // namespace voidjs
@@ -0,0 +1,51 @@
+#ifndef VOIDJS_PARSER_CODE_CACHE_H
+#define VOIDJS_PARSER_CODE_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "voidjs/ir/program.h"
+
+namespace voidjs {
+
+// CodeCache keeps serialized Programs in a directory, one file per source,
+// named after a hash of the source text. A file starts with a header
+//   magic "VJSC", VERSION, hash and size of the source, size and hash of the payload
+// followed by the output of ast::Serializer.
+class CodeCache {
+ public:
+  // Must be bumped whenever the AST or its serialized form changes
+  static constexpr std::uint32_t VERSION = 3;
+
+  explicit CodeCache(std::string dir)
+    : dir_(std::move(dir))
+  {}
+
+  // Returns nullptr if there is no valid entry for source
+  ast::Program* Load(std::string_view source) const;
+
+  // Returns false if the entry could not be written
+  bool Store(std::string_view source, const ast::Program* program) const;
+
+  std::string GetPath(std::string_view source) const;
+
+ private:
+  struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t source_hash;
+    std::uint64_t source_size;
+    std::uint64_t payload_hash;
+    std::uint64_t payload_size;
+  };
+
+  static std::uint64_t Hash(std::string_view data);
+
+ private:
+  std::string dir_;
+};
+
+}  // namespace voidjs
+
+#endif  // VOIDJS_PARSER_CODE_CACHE_H
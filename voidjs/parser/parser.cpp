@@ -1,6 +1,10 @@
 #include "voidjs/parser/parser.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <thread>
+#include <unordered_map>
 
 #include "voidjs/lexer/character.h"
 #include "voidjs/lexer/token.h"
@@ -9,6 +13,7 @@
 #include "voidjs/ir/statement.h"
 #include "voidjs/ir/expression.h"
 #include "voidjs/ir/literal.h"
+#include "voidjs/ir/binding_plan.h"
 #include "voidjs/lexer/token_type.h"
 #include "voidjs/utils/error.h"
 #include "voidjs/utils/helper.h"
@@ -40,7 +45,7 @@ Program* Parser::ParseProgram() {
   }
   
   EnterFunctionScope();
-  Statements stmts;
+  Statements stmts{arena_};
   while (lexer_.GetToken().GetType() != TokenType::EOS) {
     try {
       if (lexer_.GetToken().GetType() == TokenType::KEYWORD_FUNCTION) {
@@ -54,8 +59,8 @@ Program* Parser::ParseProgram() {
       return nullptr;
     }
   }
-  auto [var_decls, func_decls] = ExitFunctionScope();
-  return new Program(std::move(stmts), is_strict, std::move(var_decls), std::move(func_decls)); 
+  auto [var_decls, func_decls, uses_arguments, frame_slots] = ExitFunctionScope();
+  return new Program(std::move(own_arena_), std::move(stmts), is_strict, std::move(var_decls), std::move(func_decls)); 
 }
 
 Statement* Parser::ParseStatement() {
@@ -122,7 +127,7 @@ Statement* Parser::ParseBlockStatement() {
   // begin with {
   lexer_.NextToken();
 
-  Statements stmts;
+  Statements stmts{arena_};
 
   while (lexer_.GetToken().GetType() != TokenType::RIGHT_BRACE) {
     stmts.push_back(ParseStatement());
@@ -133,7 +138,7 @@ Statement* Parser::ParseBlockStatement() {
   }
   lexer_.NextToken();
   
-  return new BlockStatement(std::move(stmts));
+  return NewNode<BlockStatement>(std::move(stmts));
 }
 
 // Parse VariableStatment
@@ -144,7 +149,7 @@ Statement* Parser::ParseVariableStatement() {
   // begin with var
   lexer_.NextToken();
 
-  auto var_stmt = new VariableStatement(ParseVariableDeclarationList());
+  auto var_stmt = NewNode<VariableStatement>(ParseVariableDeclarationList());
 
   if (!TryAutomaticInsertSemicolon()) {
     ThrowSyntaxError("expects a ';'");
@@ -158,7 +163,7 @@ Statement* Parser::ParseVariableStatement() {
 // EmptyStatement :
 //   ;
 Statement* Parser::ParseEmptyStatement() {
-  auto empty_stmt = new EmptyStatement();
+  auto empty_stmt = NewNode<EmptyStatement>();
 
   if (lexer_.GetToken().GetType() != TokenType::SEMICOLON) {
     ThrowSyntaxError("expects a ';'");
@@ -185,7 +190,7 @@ Statement* Parser::ParseExpressionStatement() {
     ThrowSyntaxError("expects a ';'");
   }
   
-  return new ExpressionStatement(expr);
+  return NewNode<ExpressionStatement>(expr);
 }
 
 // Parse IfStatement
@@ -217,7 +222,7 @@ Statement* Parser::ParseIfStatement() {
     alt = ParseStatement();
   }
 
-  return new IfStatement(cond, cons, alt); 
+  return NewNode<IfStatement>(cond, cons, alt); 
 }
 
 // ParseDoWhileStatement
@@ -251,7 +256,7 @@ Statement* Parser::ParseDoWhileStatement() {
     ThrowSyntaxError("expects a '('");
   }
 
-  return new DoWhileStatement(cond, body);
+  return NewNode<DoWhileStatement>(cond, body);
 }
 
 // ParseWhileStatement
@@ -276,7 +281,7 @@ Statement* Parser::ParseWhileStatement() {
 
   auto body = ParseStatement();
 
-  return new WhileStatement(cond, body);
+  return NewNode<WhileStatement>(cond, body);
 }
 
 // ParseForStatement
@@ -318,9 +323,9 @@ Statement* Parser::ParseForStatement() {
 
       auto body = ParseStatement();
 
-      return new ForInStatement(left, right, body);
+      return NewNode<ForInStatement>(left, right, body);
     } else {
-      auto init = new VariableStatement(decls);
+      auto init = NewNode<VariableStatement>(decls);
 
       if (lexer_.GetToken().GetType() != TokenType::SEMICOLON) {
         ThrowSyntaxError("expects a ';'");
@@ -349,7 +354,7 @@ Statement* Parser::ParseForStatement() {
 
       auto body = ParseStatement();
 
-      return new ForStatement(init, cond, update, body);
+      return NewNode<ForStatement>(init, cond, update, body);
     }
   } else {
     AstNode* init = nullptr;
@@ -378,7 +383,7 @@ Statement* Parser::ParseForStatement() {
 
         auto body = ParseStatement();
 
-        return new ForInStatement(left, right, body);
+        return NewNode<ForInStatement>(left, right, body);
       } else {
         init = expr;
       }
@@ -411,7 +416,7 @@ Statement* Parser::ParseForStatement() {
 
     auto body = ParseStatement();
 
-    return new ForStatement(init, cond, update, body);
+    return NewNode<ForStatement>(init, cond, update, body);
   }
 }
 
@@ -435,7 +440,7 @@ Statement* Parser::ParseContinueStatement() {
     ThrowSyntaxError("expects a ';'");
   }
 
-  return new ContinueStatement(ident);
+  return NewNode<ContinueStatement>(ident);
 }
 
 // Parse BreakStatement
@@ -458,7 +463,7 @@ Statement* Parser::ParseBreakStatement() {
     ThrowSyntaxError("expects a ';'");
   }
       
-  return new BreakStatement(ident);
+  return NewNode<BreakStatement>(ident);
 }
 
 // Parse ReturnStatement
@@ -481,7 +486,7 @@ Statement* Parser::ParseReturnStatement() {
     ThrowSyntaxError("expects a ';'");
   }
 
-  return new ReturnStatement(expr);
+  return NewNode<ReturnStatement>(expr);
 }
 
 // Parse WithStatemnet
@@ -497,6 +502,9 @@ Statement* Parser::ParseWithStatement() {
   }
   lexer_.NextToken();
 
+  // The object environment of with may shadow any local
+  DisableFrameSlots();
+
   auto ctx = ParseExpression();
 
   if (lexer_.GetToken().GetType() != TokenType::RIGHT_PAREN) {
@@ -506,7 +514,7 @@ Statement* Parser::ParseWithStatement() {
 
   auto body = ParseStatement();
 
-  return new WithStatement(ctx, body);
+  return NewNode<WithStatement>(ctx, body);
 }
 
 // Parse SwitchStatement
@@ -531,7 +539,7 @@ Statement* Parser::ParseSwitchStatement() {
 
   auto cases = ParseCaseBlock();
 
-  return new SwitchStatement(expr, std::move(cases));
+  return NewNode<SwitchStatement>(expr, std::move(cases));
 }
 
 // Parse LabelledStatement
@@ -549,7 +557,7 @@ Statement* Parser::ParseLabelledStatement() {
 
   auto body = ParseStatement();
 
-  return new LabelledStatement(label, body);
+  return NewNode<LabelledStatement>(label, body);
 }
 
 // Parse ThrowStatement
@@ -569,7 +577,7 @@ Statement* Parser::ParseThrowStatement() {
     ThrowSyntaxError("expects a ';'");
   }
 
-  return new ThrowStatement(expr);
+  return NewNode<ThrowStatement>(expr);
 }
 
 // Parse TryStatement
@@ -614,7 +622,18 @@ Statement* Parser::ParseTryStatement() {
     if (lexer_.GetToken().GetType() != TokenType::LEFT_BRACE) {
       ThrowSyntaxError("expects a '{'");
     }
+
+    // The catch parameter gets a slot of its own, which shadows the locals of the same name in Block
+    bool in_function = !function_scode_infos_.empty();
+    if (in_function) {
+      auto& frame_slots = function_scode_infos_.back().frame_slots;
+      frame_slots.catch_scopes.emplace_back(catch_name->AsIdentifier()->GetName(), frame_slots.catch_num++);
+      AddReference(catch_name->AsIdentifier());
+    }
     auto catch_block = ParseBlockStatement();
+    if (in_function) {
+      function_scode_infos_.back().frame_slots.catch_scopes.pop_back();
+    }
 
     if (lexer_.GetToken().GetType() == TokenType::KEYWORD_FINALLY) {
       lexer_.NextToken();
@@ -624,9 +643,9 @@ Statement* Parser::ParseTryStatement() {
       }
       auto finally_block = ParseBlockStatement();
 
-      return new TryStatement(body, catch_name, catch_block, finally_block);
+      return NewNode<TryStatement>(body, catch_name, catch_block, finally_block);
     } else {
-      return new TryStatement(body, catch_name, catch_block, nullptr);
+      return NewNode<TryStatement>(body, catch_name, catch_block, nullptr);
     }
   } else if (lexer_.GetToken().GetType() == TokenType::KEYWORD_FINALLY) {
     lexer_.NextToken();
@@ -636,9 +655,9 @@ Statement* Parser::ParseTryStatement() {
     }
     auto finally_block = ParseBlockStatement();
 
-    return new TryStatement(body, nullptr, nullptr, finally_block);
+    return NewNode<TryStatement>(body, nullptr, nullptr, finally_block);
   } else {
-    return new TryStatement(body, nullptr, nullptr, nullptr);
+    return NewNode<TryStatement>(body, nullptr, nullptr, nullptr);
   }
 }
 
@@ -654,7 +673,7 @@ Statement* Parser::ParseDebuggerStatement() {
     ThrowSyntaxError("expects a ';'");
   }
 
-  return new DebuggerStatement();
+  return NewNode<DebuggerStatement>();
 }
 
 // Parse Expression
@@ -665,7 +684,7 @@ Statement* Parser::ParseDebuggerStatement() {
 Expression* Parser::ParseExpression(bool allow_in) {
   auto expr = ParseAssignmentExpression(allow_in);
   if (lexer_.GetToken().GetType() == TokenType::COMMA) {
-    Expressions exprs;
+    Expressions exprs{arena_};
     exprs.push_back(expr);
 
     while (lexer_.GetToken().GetType() == TokenType::COMMA) {
@@ -674,7 +693,7 @@ Expression* Parser::ParseExpression(bool allow_in) {
       exprs.push_back(ParseAssignmentExpression(allow_in));
     }
 
-    return new SequenceExpression(std::move(exprs));
+    return NewNode<SequenceExpression>(std::move(exprs));
   } else {
     return expr;
   }
@@ -692,32 +711,39 @@ Expression* Parser::ParseExpression(bool allow_in) {
 Expression* Parser::ParsePrimaryExpression() {
   switch (lexer_.GetToken().GetType()) {
     case TokenType::KEYWORD_THIS: {
-      auto expr = new This();
+      auto expr = NewNode<This>();
       lexer_.NextToken();
       return expr;
     }
     case TokenType::IDENTIFIER: {
+      // Direct eval, or code run by it, may refer to arguments
+      auto name = lexer_.GetToken().GetString();
+      if (name == u"arguments" || name == u"eval") {
+        function_scode_infos_.back().uses_arguments = true;
+        DisableFrameSlots();
+      }
       auto ident = ParseIdentifier();
+      AddReference(ident->AsIdentifier());
       return ident;
     }
     case TokenType::NULL_LITERAL: {
-      auto null = new NullLiteral();
+      auto null = NewNode<NullLiteral>();
       lexer_.NextToken();
       return null;
     }
     case TokenType::TRUE:
     case TokenType::FALSE: {
-      auto boolean = new BooleanLiteral(lexer_.GetToken().GetType() == TokenType::TRUE);
+      auto boolean = NewNode<BooleanLiteral>(lexer_.GetToken().GetType() == TokenType::TRUE);
       lexer_.NextToken();
       return boolean;
     }
     case TokenType::NUMBER: {
-      auto num = new NumericLiteral(lexer_.GetToken().GetNumber());
+      auto num = NewNode<NumericLiteral>(lexer_.GetToken().GetNumber());
       lexer_.NextToken();
       return num;
     }
     case TokenType::STRING: {
-      auto str = new StringLiteral(lexer_.GetToken().GetString());
+      auto str = NewNode<StringLiteral>(lexer_.GetToken().GetString());
       lexer_.NextToken();
       return str;
     }
@@ -785,9 +811,9 @@ Expression* Parser::ParseMemberExpression(bool has_new) {
     callee = ParseMemberExpression(true);
     if (lexer_.GetToken().GetType() == TokenType::LEFT_PAREN) {
       auto args = ParseArguments();
-      callee = new NewExpression(callee, std::move(args));
+      callee = NewNode<NewExpression>(callee, std::move(args));
     } else {
-      callee = new NewExpression(callee, {});
+      callee = NewNode<NewExpression>(callee, Expressions{arena_});
     }
   } else {
     if (lexer_.GetToken().GetType() == TokenType::KEYWORD_FUNCTION) {
@@ -806,14 +832,14 @@ Expression* Parser::ParseMemberExpression(bool has_new) {
           ThrowSyntaxError("expects a ']'");
         }
         lexer_.NextToken();
-        callee = new MemberExpression(callee, expr, false);
+        callee = NewNode<MemberExpression>(callee, expr, false);
         break;
       }
       case TokenType::DOT: {
         lexer_.NextToken();
         if (lexer_.GetToken().IsIdentifierName()) {
           auto ident = ParseIdentifier();
-          callee = new MemberExpression(callee, ident, true);
+          callee = NewNode<MemberExpression>(callee, ident, true);
         } else {
           ThrowSyntaxError("expects identifier_name");
         }
@@ -822,7 +848,7 @@ Expression* Parser::ParseMemberExpression(bool has_new) {
       case TokenType::LEFT_PAREN: {
         if (!has_new) {
           auto args = ParseArguments();
-          callee = new CallExpression(callee, args);
+          callee = NewNode<CallExpression>(callee, args);
         } else {
           return callee;
         }
@@ -848,7 +874,7 @@ Expression* Parser::ParsePostfixExpression() {
       (lexer_.GetToken().GetType() == TokenType::INC || lexer_.GetToken().GetType() == TokenType::DEC)) {
     auto type = lexer_.GetToken().GetType();
     lexer_.NextToken();
-    return new PostfixExpression(type, lhs);
+    return NewNode<PostfixExpression>(type, lhs);
   } else {
     return lhs;
   }
@@ -879,7 +905,7 @@ Expression* Parser::ParseUnaryExpression() {
       lexer_.GetToken().GetType() == TokenType::LOGICAL_NOT) {
     auto type = lexer_.GetToken().GetType();
     lexer_.NextToken();
-    return new UnaryExpression(type, ParseUnaryExpression());
+    return NewNode<UnaryExpression>(type, ParseUnaryExpression());
   } else {
     return ParsePostfixExpression();
   }
@@ -952,7 +978,7 @@ Expression* Parser::ParseBinaryExpression(bool allow_in, std::int32_t precedence
     }
     lexer_.NextToken();
     auto right = ParseBinaryExpression(allow_in, token.GetPrecedence());
-    left = new BinaryExpression(token.GetType(), left, right);
+    left = NewNode<BinaryExpression>(token.GetType(), left, right);
   }
   return left;
 }
@@ -976,7 +1002,7 @@ Expression* Parser::ParseConditionalExpression(bool allow_in) {
     
     auto alt = ParseAssignmentExpression(allow_in);
     
-    return new ConditionalExpression(cond, cons, alt);
+    return NewNode<ConditionalExpression>(cond, cons, alt);
   } else {
     return cond;
   }
@@ -1005,7 +1031,7 @@ Expression* Parser::ParseAssignmentExpression(bool allow_in) {
     
       auto right = ParseAssignmentExpression(allow_in);
 
-      return new AssignmentExpression(type, left, right);
+      return NewNode<AssignmentExpression>(type, left, right);
     }
   }
   return nullptr;
@@ -1029,7 +1055,7 @@ Expression* Parser::ParseFunctionExpression() {
   }
   lexer_.NextToken();
 
-  Expressions params;
+  Expressions params{arena_};
   if (lexer_.GetToken().GetType() != TokenType::RIGHT_PAREN) {
     params = ParseFormalParameterList();
   }
@@ -1039,45 +1065,22 @@ Expression* Parser::ParseFunctionExpression() {
   }
   lexer_.NextToken();
 
-  if (lexer_.GetToken().GetType() != TokenType::LEFT_BRACE) {
-    ThrowSyntaxError("expects a '{'");
-  }
-  lexer_.NextToken();
-
-  bool is_strict = false;
-  if (lexer_.GetToken().GetType() == TokenType::STRING &&
-      lexer_.GetToken().GetString() == u"use strict") {
-    is_strict = true;
-    lexer_.NextToken();
-    
-    if (!TryAutomaticInsertSemicolon()) {
-      ThrowSyntaxError("expects a ';'");
-    }
-  }
-
-  EnterFunctionScope();
-  Statements stmts;
-  while (lexer_.GetToken().GetType() != TokenType::RIGHT_BRACE) {
-    if (lexer_.GetToken().GetType() == TokenType::KEYWORD_FUNCTION) {
-      stmts.push_back(ParseFunctionDeclaration());
-    } else {
-      stmts.push_back(ParseStatement());
-    }
-  }
-
-  if (lexer_.GetToken().GetType() != TokenType::RIGHT_BRACE) {
-    ThrowSyntaxError("expects a '}'");
-  }
-  lexer_.NextToken();
-
-  auto [var_decls, func_decls] = ExitFunctionScope();
-  return new FunctionExpression(ident, std::move(params), std::move(stmts), is_strict,
-                                std::move(var_decls), std::move(func_decls));
+  auto body = ParseFunctionBody(params);
+  auto func_expr = NewNode<FunctionExpression>(ident, std::move(params), std::move(body.statements), body.is_strict,
+                                               std::move(body.variable_declarations), std::move(body.function_declarations));
+  func_expr->SetLazyBody(body.lazy_body);
+  func_expr->SetUsesArguments(body.uses_arguments);
+  func_expr->SetFrameSlotNum(body.frame_slot_num);
+  func_expr->SetBindingPlan(body.binding_plan);
+  if (func_expr->IsLazy()) {
+    lazy_functions_.push_back(func_expr);
+  }
+  return func_expr;
 }
 
 // Parse Identifier
 Expression* Parser::ParseIdentifier() {
-  auto ident = new Identifier(lexer_.GetToken().GetString());
+  auto ident = NewNode<Identifier>(lexer_.GetToken().GetString());
   lexer_.NextToken();
   return ident;
 }
@@ -1088,7 +1091,7 @@ Expression* Parser::ParseIdentifier() {
 //   VariableDeclaration
 //   VariableDeclarationList , VariableDeclaration
 VariableDeclarations Parser::ParseVariableDeclarationList(bool allow_in) {
-  VariableDeclarations var_decls;
+  VariableDeclarations var_decls{arena_};
   var_decls.push_back(ParseVariableDeclaration(allow_in));
   while (lexer_.GetToken().GetType() == TokenType::COMMA) {
     lexer_.NextToken();
@@ -1110,9 +1113,10 @@ VariableDeclaration* Parser::ParseVariableDeclaration(bool allow_in) {
     ThrowSyntaxError("expects an identifier");
   }  
   auto ident = ParseIdentifier();
+  AddReference(ident->AsIdentifier());
 
   if (lexer_.GetToken().GetType() != TokenType::ASSIGN) {
-    auto var_decl = new VariableDeclaration(ident, nullptr);
+    auto var_decl = NewNode<VariableDeclaration>(ident, nullptr);
     AddVariableDeclaration(var_decl);
     return var_decl;
   }
@@ -1120,7 +1124,7 @@ VariableDeclaration* Parser::ParseVariableDeclaration(bool allow_in) {
 
   auto init = ParseAssignmentExpression(allow_in);
 
-  auto var_decl = new VariableDeclaration(ident, init);
+  auto var_decl = NewNode<VariableDeclaration>(ident, init);
   AddVariableDeclaration(var_decl);
   return var_decl;
 }
@@ -1141,7 +1145,7 @@ Expression* Parser::ParseArrayLiteral() {
   // begin with [
   lexer_.NextToken();
 
-  Expressions exprs;
+  Expressions exprs{arena_};
   
   while (lexer_.GetToken().GetType() != TokenType::RIGHT_BRACKET) {
     if (lexer_.GetToken().GetType() == TokenType::COMMA) {
@@ -1164,7 +1168,7 @@ Expression* Parser::ParseArrayLiteral() {
   }
   lexer_.NextToken();
 
-  return new ArrayLiteral(std::move(exprs));
+  return NewNode<ArrayLiteral>(std::move(exprs));
 }
 
 // Parse Arguments
@@ -1180,7 +1184,7 @@ Expressions Parser::ParseArguments() {
   // () 
   if (lexer_.GetToken().GetType() == TokenType::RIGHT_PAREN) {
     lexer_.NextToken();
-    return {}; 
+    return Expressions{arena_}; 
   }
 
   auto args = ParseArgumentList(TokenType::RIGHT_PAREN);
@@ -1199,7 +1203,7 @@ Expressions Parser::ParseArguments() {
 //    AssignmentExpression
 //    ArgumentList , AssignmentExpression
 Expressions Parser::ParseArgumentList(TokenType end_token_type) {
-  Expressions args;
+  Expressions args{arena_};
   args.push_back(ParseAssignmentExpression());
   while (lexer_.GetToken().GetType() != end_token_type) {
     if (lexer_.GetToken().GetType() != TokenType::COMMA) {
@@ -1221,7 +1225,7 @@ Expression* Parser::ParseObjectLiteral() {
   // begin with {
   lexer_.NextToken();
 
-  Properties props;
+  Properties props{arena_};
   if (lexer_.GetToken().GetType() != TokenType::RIGHT_BRACE) {
     props = ParsePropertyNameAndValueList();
   }
@@ -1236,7 +1240,7 @@ Expression* Parser::ParseObjectLiteral() {
   }
   lexer_.NextToken();
 
-  return new ObjectLiteral(std::move(props));
+  return NewNode<ObjectLiteral>(std::move(props));
 }
 
 // Parse CaseBlock
@@ -1250,7 +1254,7 @@ CaseClauses Parser::ParseCaseBlock() {
   }
   lexer_.NextToken();
 
-  CaseClauses cases;
+  CaseClauses cases{arena_};
 
   if (lexer_.GetToken().GetType() == TokenType::KEYWORD_CASE ||
       lexer_.GetToken().GetType() == TokenType::KEYWORD_DEFAULT) {
@@ -1271,7 +1275,7 @@ CaseClauses Parser::ParseCaseBlock() {
 //    CaseClause
 //    CaseClauses CaseClause
 CaseClauses Parser::ParseCaseClauses() {
-  CaseClauses cases;
+  CaseClauses cases{arena_};
   while (lexer_.GetToken().GetType() == TokenType::KEYWORD_CASE ||
          lexer_.GetToken().GetType() == TokenType::KEYWORD_DEFAULT) {
     cases.push_back(ParseCaseClause());
@@ -1296,7 +1300,7 @@ CaseClause* Parser::ParseCaseClause() {
     }
     lexer_.NextToken();
 
-    Statements stmts;
+    Statements stmts{arena_};
 
     while (lexer_.GetToken().GetType() != TokenType::KEYWORD_CASE &&
            lexer_.GetToken().GetType() != TokenType::KEYWORD_DEFAULT &&
@@ -1304,7 +1308,7 @@ CaseClause* Parser::ParseCaseClause() {
       stmts.push_back(ParseStatement());
     }
 
-    return new CaseClause(cond, std::move(stmts));
+    return NewNode<CaseClause>(cond, std::move(stmts));
   } else if (lexer_.GetToken().GetType() == TokenType::KEYWORD_DEFAULT) {
     lexer_.NextToken();
 
@@ -1313,7 +1317,7 @@ CaseClause* Parser::ParseCaseClause() {
     }
     lexer_.NextToken();
 
-    Statements stmts;
+    Statements stmts{arena_};
 
     while (lexer_.GetToken().GetType() != TokenType::KEYWORD_CASE &&
            lexer_.GetToken().GetType() != TokenType::KEYWORD_DEFAULT &&
@@ -1321,7 +1325,7 @@ CaseClause* Parser::ParseCaseClause() {
       stmts.push_back(ParseStatement());
     }
 
-    return new CaseClause(nullptr, std::move(stmts));
+    return NewNode<CaseClause>(nullptr, std::move(stmts));
   }
   return nullptr;
 }
@@ -1354,7 +1358,7 @@ Statement* Parser::ParseFunctionDeclaration() {
   }
   lexer_.NextToken();
 
-  Expressions params;
+  Expressions params{arena_};
   if (lexer_.GetToken().GetType() != TokenType::RIGHT_PAREN) {
     params = ParseFormalParameterList();
   }
@@ -1364,9 +1368,53 @@ Statement* Parser::ParseFunctionDeclaration() {
   }
   lexer_.NextToken();
 
+  auto body = ParseFunctionBody(params);
+  auto func_decl = NewNode<FunctionDeclaration>(ident, std::move(params), std::move(body.statements), body.is_strict,
+                                                std::move(body.variable_declarations), std::move(body.function_declarations));
+  func_decl->SetLazyBody(body.lazy_body);
+  func_decl->SetUsesArguments(body.uses_arguments);
+  func_decl->SetFrameSlotNum(body.frame_slot_num);
+  func_decl->SetBindingPlan(body.binding_plan);
+  if (func_decl->IsLazy()) {
+    lazy_functions_.push_back(func_decl);
+  }
+  AddFunctionDeclaration(func_decl);
+  return func_decl;
+}
+
+// Parse FormalParameterList
+// Defined in ECMAScript 5.1 Chapter 13
+//  FormalParameterList :
+//    Identifier
+//    FormalParameterList , Identifier
+Expressions Parser::ParseFormalParameterList() {
+  Expressions idents{arena_};
+  
+  idents.push_back(ParseIdentifier());
+
+  while (lexer_.GetToken().GetType() == TokenType::COMMA) {
+    lexer_.NextToken();
+
+    idents.push_back(ParseIdentifier());
+  }
+
+  return idents;
+}
+
+// Parse FunctionBody, along with the braces around it
+// Defined in ECMAScript 5.1 Chapter 13
+//  FunctionBody :
+//    SourceElements_opt
+// In lazy mode the body is only pre-parsed and its source is kept for ParseLazyFunction.
+Parser::FunctionBody Parser::ParseFunctionBody(const Expressions& params, bool allow_lazy) {
   if (lexer_.GetToken().GetType() != TokenType::LEFT_BRACE) {
     ThrowSyntaxError("expects a '{'");
   }
+
+  // The enclosing function may have its locals captured by this one
+  DisableFrameSlots();
+
+  auto begin = lexer_.GetTokenOffset();
   lexer_.NextToken();
 
   bool is_strict = false;
@@ -1380,8 +1428,17 @@ Statement* Parser::ParseFunctionDeclaration() {
     }
   }
 
+  if (lazy_ && allow_lazy) {
+    SkipFunctionBody();
+    auto end = lexer_.GetTokenOffset() + 1;
+    lexer_.NextToken();
+    return {Statements{arena_}, is_strict, VariableDeclarations{arena_}, FunctionDeclarations{arena_}, false, -1, nullptr,
+            lexer_.GetSource().substr(begin, end - begin)};
+  }
+
   EnterFunctionScope();
-  Statements stmts;
+  function_scode_infos_.back().frame_slots.keeps_locals_in_frame = true;
+  Statements stmts{arena_};
   while (lexer_.GetToken().GetType() != TokenType::RIGHT_BRACE) {
     if (lexer_.GetToken().GetType() == TokenType::KEYWORD_FUNCTION) {
       stmts.push_back(ParseFunctionDeclaration());
@@ -1395,30 +1452,147 @@ Statement* Parser::ParseFunctionDeclaration() {
   }
   lexer_.NextToken();
 
-  auto [var_decls, func_decls] = ExitFunctionScope();
-  auto func_decl = new FunctionDeclaration(ident, std::move(params), std::move(stmts), is_strict,
-                                           std::move(var_decls), std::move(func_decls));
-  AddFunctionDeclaration(func_decl);
-  return func_decl;
+  auto [var_decls, func_decls, uses_arguments, frame_slots] = ExitFunctionScope();
+  auto frame_slot_num = AllocateFrameSlots(params, var_decls, frame_slots);
+  auto binding_plan =
+    frame_slot_num < 0 ? BindingPlan::New(arena_, params, var_decls, func_decls, uses_arguments) : nullptr;
+  return {std::move(stmts), is_strict, std::move(var_decls), std::move(func_decls), uses_arguments, frame_slot_num,
+          binding_plan, {}};
 }
 
-// Parse FormalParameterList
-// Defined in ECMAScript 5.1 Chapter 13
-//  FormalParameterList :
-//    Identifier
-//    FormalParameterList , Identifier
-Expressions Parser::ParseFormalParameterList() {
-  Expressions idents;
-  
-  idents.push_back(ParseIdentifier());
-
-  while (lexer_.GetToken().GetType() == TokenType::COMMA) {
+// Pre-parse the rest of a FunctionBody, stopping at its closing '}'.
+// Only the tokens and the nesting of brackets are checked,
+// other syntax errors are reported when the body is fully parsed.
+void Parser::SkipFunctionBody() {
+  std::vector<TokenType> closers {TokenType::RIGHT_BRACE};
+  while (true) {
+    auto type = lexer_.GetToken().GetType();
+    switch (type) {
+      case TokenType::LEFT_BRACE: {
+        closers.push_back(TokenType::RIGHT_BRACE);
+        break;
+      }
+      case TokenType::LEFT_PAREN: {
+        closers.push_back(TokenType::RIGHT_PAREN);
+        break;
+      }
+      case TokenType::LEFT_BRACKET: {
+        closers.push_back(TokenType::RIGHT_BRACKET);
+        break;
+      }
+      case TokenType::RIGHT_BRACE:
+      case TokenType::RIGHT_PAREN:
+      case TokenType::RIGHT_BRACKET: {
+        if (type != closers.back()) {
+          ThrowSyntaxError("unbalanced brackets");
+        }
+        closers.pop_back();
+        if (closers.empty()) {
+          return;
+        }
+        break;
+      }
+      case TokenType::ILLEGAL: {
+        ThrowSyntaxError("invalid token");
+      }
+      case TokenType::EOS: {
+        ThrowSyntaxError("expects a '}'");
+      }
+      default: {
+        break;
+      }
+    }
     lexer_.NextToken();
+  }
+}
 
-    idents.push_back(ParseIdentifier());
+void Parser::ParseLazyFunction(AstNode* ast_node) {
+  ParseLazyFunction(ast_node, nullptr, nullptr);
+}
+
+// The body is parsed into arena, or into the Arena holding the function if arena is nullptr.
+// Functions nested in it are pre-parsed again, and added to lazy_functions if it is given.
+void Parser::ParseLazyFunction(AstNode* ast_node, utils::Arena* arena, std::vector<AstNode*>* lazy_functions) {
+  if (ast_node->IsFunctionDeclaration()) {
+    ParseLazyFunctionBody(ast_node->AsFunctionDeclaration(), arena, lazy_functions);
+  } else {
+    ParseLazyFunctionBody(ast_node->AsFunctionExpression(), arena, lazy_functions);
   }
+}
 
-  return idents;
+template <typename T>
+void Parser::ParseLazyFunctionBody(T* func, utils::Arena* arena, std::vector<AstNode*>* lazy_functions) {
+  if (!func->IsLazy()) {
+    return;
+  }
+  
+  // The source of the body outlives the function,
+  // functions nested in it are pre-parsed again.
+  Parser parser(func->GetLazyBody(), arena ? arena : func->GetArena());
+  auto body = parser.ParseFunctionBody(func->GetParameters(), false);
+  if (parser.lexer_.GetToken().GetType() != TokenType::EOS) {
+    parser.ThrowSyntaxError("expects the end of function");
+  }
+  
+  func->SetBody(std::move(body.statements), std::move(body.variable_declarations),
+                std::move(body.function_declarations), body.uses_arguments, body.frame_slot_num, body.binding_plan);
+  if (lazy_functions) {
+    lazy_functions->insert(lazy_functions->end(), parser.lazy_functions_.begin(), parser.lazy_functions_.end());
+  }
+}
+
+// Parse the bodies of lazy functions in parallel
+// The functions pre-parsed by ParseProgram are handed out to the threads, largest body first.
+// Each thread parses with a Parser of its own into an Arena of its own, together with the
+// functions nested in the bodies it parses, and the Arenas are then handed over to program.
+// A body with a syntax error is left lazy, so the error is still reported when it is called.
+void Parser::ParseLazyFunctions(Program* program, std::size_t thread_num) {
+  auto funcs = std::move(lazy_functions_);
+  lazy_functions_.clear();
+  auto body_size = [](AstNode* func) {
+    return func->IsFunctionDeclaration() ?
+      func->AsFunctionDeclaration()->GetLazyBody().size() :
+      func->AsFunctionExpression()->GetLazyBody().size();
+  };
+  std::stable_sort(funcs.begin(), funcs.end(), [&](AstNode* lhs, AstNode* rhs) {
+    return body_size(lhs) > body_size(rhs);
+  });
+
+  thread_num = std::max<std::size_t>(1, std::min(thread_num, funcs.size()));
+  std::vector<std::unique_ptr<utils::Arena>> arenas;
+  for (std::size_t idx = 0; idx < thread_num; ++idx) {
+    arenas.push_back(std::make_unique<utils::Arena>());
+  }
+
+  std::atomic<std::size_t> next {0};
+  auto work = [&](utils::Arena* arena) {
+    std::vector<AstNode*> stack;
+    for (auto idx = next++; idx < funcs.size(); idx = next++) {
+      stack.push_back(funcs[idx]);
+      while (!stack.empty()) {
+        auto func = stack.back();
+        stack.pop_back();
+        try {
+          ParseLazyFunction(func, arena, &stack);
+        } catch (const utils::Error&) {
+          // Left lazy
+        }
+      }
+    }
+  };
+  
+  std::vector<std::thread> threads;
+  for (std::size_t idx = 1; idx < thread_num; ++idx) {
+    threads.emplace_back(work, arenas[idx].get());
+  }
+  work(arenas[0].get());
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& arena : arenas) {
+    program->AddArena(std::move(arena));
+  }
 }
 
 // Parse PropertyNameAndValueList
@@ -1427,7 +1601,7 @@ Expressions Parser::ParseFormalParameterList() {
 //    PropertyAssignment
 //    PropertyNameAndValueList , PropertyAssignment
 Properties Parser::ParsePropertyNameAndValueList() {
-  Properties props;
+  Properties props{arena_};
 
   props.push_back(ParsePropertyAssignment());
 
@@ -1471,43 +1645,19 @@ Property* Parser::ParsePropertyAssignment() {
     }
     lexer_.NextToken();
 
-    if (lexer_.GetToken().GetType() != TokenType::LEFT_BRACE) {
-      ThrowSyntaxError("expects a '{'");
-    }
-    lexer_.NextToken();
-
-    bool is_strict = false;
-    if (lexer_.GetToken().GetType() == TokenType::STRING &&
-        lexer_.GetToken().GetString() == u"use strict") {
-      is_strict = true;
-      lexer_.NextToken();
-    
-      if (!TryAutomaticInsertSemicolon()) {
-        ThrowSyntaxError("expects a ';'");
-      }
+    Expressions params{arena_};
+    auto body = ParseFunctionBody(params);
+    auto value = NewNode<FunctionExpression>(nullptr, std::move(params), std::move(body.statements), body.is_strict,
+                                             std::move(body.variable_declarations), std::move(body.function_declarations));
+    value->SetLazyBody(body.lazy_body);
+    value->SetUsesArguments(body.uses_arguments);
+    value->SetFrameSlotNum(body.frame_slot_num);
+    value->SetBindingPlan(body.binding_plan);
+    if (value->IsLazy()) {
+      lazy_functions_.push_back(value);
     }
 
-    EnterFunctionScope();
-    Statements stmts;
-    while (lexer_.GetToken().GetType() != TokenType::RIGHT_BRACE) {
-      if (lexer_.GetToken().GetType() == TokenType::KEYWORD_FUNCTION) {
-        stmts.push_back(ParseFunctionDeclaration());
-      } else {
-        stmts.push_back(ParseStatement());
-      }
-    }
-
-    if (lexer_.GetToken().GetType() != TokenType::RIGHT_BRACE) {
-      ThrowSyntaxError("expects a '}'");
-    }
-    lexer_.NextToken();
-    
-    auto [var_decls, func_decls] = ExitFunctionScope();
-
-    auto value = new FunctionExpression(nullptr, Expressions{}, std::move(stmts), is_strict,
-                                        std::move(var_decls), std::move(func_decls));
-
-    return new Property(type, key, value);
+    return NewNode<Property>(type, key, value);
   } else if (lexer_.GetToken().GetType() == TokenType::IDENTIFIER &&
              lexer_.GetToken().GetString() == u"set"              &&
              lexer_.NextRewindToken().GetType() != TokenType::COLON) {
@@ -1527,7 +1677,7 @@ Property* Parser::ParsePropertyAssignment() {
     if (lexer_.GetToken().GetType() != TokenType::IDENTIFIER) {
       ThrowSyntaxError("expects an identifier");
     }
-    Expressions params;
+    Expressions params{arena_};
     params.push_back(ParseIdentifier());
 
     if (lexer_.GetToken().GetType() != TokenType::RIGHT_PAREN) {
@@ -1535,44 +1685,18 @@ Property* Parser::ParsePropertyAssignment() {
     }
     lexer_.NextToken();
     
-    if (lexer_.GetToken().GetType() != TokenType::LEFT_BRACE) {
-      ThrowSyntaxError("expects a '{'");
-    }
-    lexer_.NextToken();
-
-    bool is_strict = false;
-    if (lexer_.GetToken().GetType() == TokenType::STRING &&
-        lexer_.GetToken().GetString() == u"use strict") {
-      is_strict = true;
-      lexer_.NextToken();
-    
-      if (lexer_.GetToken().GetType() != TokenType::SEMICOLON) {
-        ThrowSyntaxError("expects a ';'");
-      }
-      lexer_.NextToken();
-    }
-
-    EnterFunctionScope();
-    Statements stmts;
-    while (lexer_.GetToken().GetType() != TokenType::RIGHT_BRACE) {
-      if (lexer_.GetToken().GetType() == TokenType::KEYWORD_FUNCTION) {
-        stmts.push_back(ParseFunctionDeclaration());
-      } else {
-        stmts.push_back(ParseStatement());
-      }
-    }
-
-    if (lexer_.GetToken().GetType() != TokenType::RIGHT_BRACE) {
-      ThrowSyntaxError("expects a '}'");
-    }
-    lexer_.NextToken();
-
-    auto [var_decls, func_decls] = ExitFunctionScope();
-      
-    auto value = new FunctionExpression(nullptr, std::move(params), std::move(stmts), is_strict,
-                                        std::move(var_decls), std::move(func_decls));
-
-    return new Property(type, key, value);
+    auto body = ParseFunctionBody(params);
+    auto value = NewNode<FunctionExpression>(nullptr, std::move(params), std::move(body.statements), body.is_strict,
+                                             std::move(body.variable_declarations), std::move(body.function_declarations));
+    value->SetLazyBody(body.lazy_body);
+    value->SetUsesArguments(body.uses_arguments);
+    value->SetFrameSlotNum(body.frame_slot_num);
+    value->SetBindingPlan(body.binding_plan);
+    if (value->IsLazy()) {
+      lazy_functions_.push_back(value);
+    }
+
+    return NewNode<Property>(type, key, value);
   } else {
     auto type = PropertyType::INIT;
 
@@ -1588,7 +1712,7 @@ Property* Parser::ParsePropertyAssignment() {
 
     auto value = ParseAssignmentExpression();
 
-    return new Property(type, key, value);
+    return NewNode<Property>(type, key, value);
   }
 }
 // Parse PropertyName
@@ -1599,13 +1723,13 @@ Property* Parser::ParsePropertyAssignment() {
 Expression* Parser::ParsePropertyName() {
   Expression* key = nullptr;
   if (lexer_.GetToken().IsIdentifierName()) {
-    key = new Identifier(lexer_.GetToken().GetString());
+    key = NewNode<Identifier>(lexer_.GetToken().GetString());
     lexer_.NextToken();
   } else if (lexer_.GetToken().GetType() == TokenType::NUMBER) {
-    key = new NumericLiteral(lexer_.GetToken().GetNumber());
+    key = NewNode<NumericLiteral>(lexer_.GetToken().GetNumber());
     lexer_.NextToken();
   } else if (lexer_.GetToken().GetType() == TokenType::STRING) {
-    key = new StringLiteral(lexer_.GetToken().GetString());
+    key = NewNode<StringLiteral>(lexer_.GetToken().GetString());
     lexer_.NextToken();
   }
   return key;
@@ -1631,7 +1755,7 @@ bool Parser::TryAutomaticInsertSemicolon() {
 }
 
 void Parser::EnterFunctionScope() {
-  function_scode_infos_.emplace_back();
+  function_scode_infos_.push_back({VariableDeclarations{arena_}, FunctionDeclarations{arena_}, false, {}});
 }
 
 void Parser::AddVariableDeclaration(VariableDeclaration* var_decl) {
@@ -1645,9 +1769,73 @@ void Parser::AddFunctionDeclaration(FunctionDeclaration* func_decl) {
 }
 
 Parser::FunctionScopeInfo Parser::ExitFunctionScope() {
-  auto info = function_scode_infos_.back();
+  auto info = std::move(function_scode_infos_.back());
   function_scode_infos_.pop_back();
   return info;
 }
 
+// Records an Identifier of the current function for AllocateFrameSlots,
+// bound to the innermost enclosing catch clause of the same name if there is one.
+void Parser::AddReference(Identifier* ident) {
+  if (function_scode_infos_.empty() || !function_scode_infos_.back().frame_slots.keeps_locals_in_frame) {
+    return;
+  }
+  auto& frame_slots = function_scode_infos_.back().frame_slots;
+  auto catch_idx = NO_CATCH;
+  for (auto iter = frame_slots.catch_scopes.rbegin(); iter != frame_slots.catch_scopes.rend(); ++iter) {
+    if (iter->first == ident->GetName()) {
+      catch_idx = iter->second;
+      break;
+    }
+  }
+  frame_slots.references.emplace_back(ident, catch_idx);
+}
+
+// The locals of the current function may be captured, so they are kept in its environment
+void Parser::DisableFrameSlots() {
+  if (function_scode_infos_.empty()) {
+    return;
+  }
+  auto& frame_slots = function_scode_infos_.back().frame_slots;
+  frame_slots.keeps_locals_in_frame = false;
+  frame_slots.references = {};
+}
+
+// Numbers the locals of a function whose locals can not be captured:
+// first the parameters, then the variables and then the parameter of each catch clause,
+// and binds the Identifiers referring to them to their slots. The others are left to Identifier Resolution.
+// Returns the number of slots, or -1 if the function keeps its locals in an environment.
+std::int32_t Parser::AllocateFrameSlots(
+  const Expressions& params, const VariableDeclarations& var_decls, const FrameSlotInfo& info) {
+  if (!info.keeps_locals_in_frame) {
+    return -1;
+  }
+
+  std::unordered_map<std::u16string_view, std::int32_t> slots;
+  for (auto param : params) {
+    slots.emplace(param->AsIdentifier()->GetName(), slots.size());
+  }
+  for (auto var_decl : var_decls) {
+    slots.emplace(var_decl->GetIdentifier()->AsIdentifier()->GetName(), slots.size());
+  }
+  std::int32_t local_num = slots.size();
+  if (local_num + info.catch_num > MAX_FRAME_SLOT_NUM) {
+    return -1;
+  }
+
+  // Parameters of the same name share a slot, the last one wins when arguments are bound
+  for (auto param : params) {
+    param->AsIdentifier()->SetSlot(slots[param->AsIdentifier()->GetName()]);
+  }
+  for (auto [ident, catch_idx] : info.references) {
+    if (catch_idx != NO_CATCH) {
+      ident->SetSlot(local_num + catch_idx);
+    } else if (auto iter = slots.find(ident->GetName()); iter != slots.end()) {
+      ident->SetSlot(iter->second);
+    }
+  }
+
+  return local_num + info.catch_num;
+}
+
 }  // namespace voidjs
@@ -1,18 +1,38 @@
 #ifndef VOIDJS_PARSER_PARSER_H
 #define VOIDJS_PARSER_PARSER_H
 
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include "voidjs/lexer/lexer.h"
 #include "voidjs/ir/expression.h"
 #include "voidjs/ir/statement.h"
 #include "voidjs/ir/ast.h"
 #include "voidjs/utils/error.h"
+#include "voidjs/utils/arena.h"
+#include "voidjs/utils/unicode.h"
 
 namespace voidjs {
 
 class Parser {
+  friend class StreamingParser;
+  
  public:
-  Parser(std::u16string const& src)
-    : lexer_(src) {
+  // The source is copied once into the Arena, Tokens and AST nodes refer to that copy.
+  // With lazy set, function bodies are only pre-parsed, see ParseLazyFunction.
+  Parser(std::u16string_view src, bool lazy = false)
+    : own_arena_(new utils::Arena), arena_(own_arena_.get()), lazy_(lazy),
+      lexer_(arena_->NewString(src), arena_) {
+    lexer_.NextToken();
+  }
+
+  // UTF-8 source is decoded straight into the Arena
+  Parser(std::string_view utf8_src, bool lazy = false)
+    : own_arena_(new utils::Arena), arena_(own_arena_.get()), lazy_(lazy),
+      lexer_(NewUtf16Source(arena_, utf8_src), arena_) {
     lexer_.NextToken();
   }
   
@@ -23,6 +43,7 @@ class Parser {
   Parser& operator=(const Parser&) = delete;
 
 
+  // The returned Program takes over the Arena of the Parser
   ast::Program* ParseProgram();
 
   ast::Statement* ParseStatement();
@@ -72,25 +93,96 @@ class Parser {
   ast::Property* ParsePropertyAssignment();
   ast::Expression* ParsePropertyName();
   
+  // Nodes parsed outside of ParseProgram are only valid as long as this Arena
+  std::unique_ptr<utils::Arena> ReleaseArena() { return std::move(own_arena_); }
+
+  // Parses the body of a lazily parsed FunctionDeclaration or FunctionExpression
+  // into the Arena holding the function, does nothing if the body is already parsed.
+  // Throws utils::Error if the body turns out to be invalid.
+  static void ParseLazyFunction(ast::AstNode* ast_node);
+
+  // Parses the bodies of the functions pre-parsed by ParseProgram on thread_num threads.
+  // program must be the Program returned by ParseProgram.
+  void ParseLazyFunctions(ast::Program* program, std::size_t thread_num);
+  
  private:
+  // The Identifiers a function body refers to, collected for AllocateFrameSlots
+  // as long as none of its locals may be captured.
+  struct FrameSlotInfo {
+    bool keeps_locals_in_frame {false};
+    // Each Identifier with the index of the catch clause binding it, or NO_CATCH
+    std::vector<std::pair<ast::Identifier*, std::int32_t>> references;
+    // Names and indices of the catch clauses around the current position, innermost last
+    std::vector<std::pair<std::u16string_view, std::int32_t>> catch_scopes;
+    std::int32_t catch_num {0};
+  };
+
   struct FunctionScopeInfo {
     ast::VariableDeclarations variable_declarations;
     ast::FunctionDeclarations function_declarations;
+    bool uses_arguments;
+    FrameSlotInfo frame_slots;
+  };
+
+  struct FunctionBody {
+    ast::Statements statements;
+    bool is_strict;
+    ast::VariableDeclarations variable_declarations;
+    ast::FunctionDeclarations function_declarations;
+    bool uses_arguments;
+    std::int32_t frame_slot_num;  // -1 unless the function keeps its locals in its frame
+    const ast::BindingPlan* binding_plan;  // nullptr if the body is lazy or keeps its locals in its frame
+    std::u16string_view lazy_body;  // empty unless the body was only pre-parsed
   };
 
+  // Functions with more locals than this keep them in an environment
+  static constexpr std::int32_t MAX_FRAME_SLOT_NUM = 1024;
+  static constexpr std::int32_t NO_CATCH = -1;
+
+  // Parses the lazy body of a function, the body is a copy owned by arena
+  Parser(std::u16string_view body, utils::Arena* arena)
+    : arena_(arena), lazy_(true), lexer_(body, arena_) {
+    lexer_.NextToken();
+  }
+
  private:
-  void ThrowSyntaxError(std::string msg);
+  [[noreturn]] void ThrowSyntaxError(std::string msg);
   bool TryAutomaticInsertSemicolon();
   void EnterFunctionScope();
   void AddVariableDeclaration(ast::VariableDeclaration* var_decl);
   void AddFunctionDeclaration(ast::FunctionDeclaration* func_decl);
   FunctionScopeInfo ExitFunctionScope();
+  void AddReference(ast::Identifier* ident);
+  void DisableFrameSlots();
+  static std::int32_t AllocateFrameSlots(
+    const ast::Expressions& params, const ast::VariableDeclarations& var_decls, const FrameSlotInfo& info);
+  FunctionBody ParseFunctionBody(const ast::Expressions& params, bool allow_lazy = true);
+  void SkipFunctionBody();
+
+  static void ParseLazyFunction(ast::AstNode* ast_node, utils::Arena* arena, std::vector<ast::AstNode*>* lazy_functions);
+  template <typename T>
+  static void ParseLazyFunctionBody(T* func, utils::Arena* arena, std::vector<ast::AstNode*>* lazy_functions);
+
+  static std::u16string_view NewUtf16Source(utils::Arena* arena, std::string_view utf8_src) {
+    auto data = static_cast<char16_t*>(arena->Allocate(utf8_src.size() * sizeof(char16_t)));
+    return {data, utils::Utf8ToUtf16(utf8_src, data)};
+  }
+
+  template <typename T, typename... Args>
+  T* NewNode(Args&&... args) { return arena_->New<T>(std::forward<Args>(args)...); }
 
  private:
+  std::unique_ptr<utils::Arena> own_arena_;
+  utils::Arena* arena_;
+  bool lazy_;
+  
   Lexer lexer_;
 
   std::vector<FunctionScopeInfo> function_scode_infos_;
 
+  // Functions whose body has only been pre-parsed, for ParseLazyFunctions
+  std::vector<ast::AstNode*> lazy_functions_;
+
   utils::Error error_;
 };
 
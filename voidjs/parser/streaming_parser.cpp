@@ -0,0 +1,315 @@
+#include "voidjs/parser/streaming_parser.h"
+
+#include <iostream>
+
+#include "voidjs/ir/statement.h"
+#include "voidjs/ir/expression.h"
+
+namespace voidjs {
+
+using namespace ast;
+
+// The scan follows the nesting of brackets and skips function bodies,
+// which is enough to tell apart
+//   var names outside of functions, i.e. the identifiers after var and after each ',' of its list,
+//   FunctionDeclarations, i.e. function at the top level in the position of a statement,
+// as the Lexer never depends on the syntactic context. Where a VariableStatement ends
+// without a ';', Automatic Semicolon Insertion is decided from the tokens around the line break.
+bool StreamingParser::ScanDeclarations() {
+  auto& lexer = parser_.lexer_;
+  auto arena = parser_.own_arena_.get();
+
+  // The Directive Prologue is parsed as in Parser::ParseProgram
+  if (lexer.GetToken().GetType() == TokenType::STRING &&
+      lexer.GetToken().GetString() == u"use strict") {
+    is_strict_ = true;
+    lexer.NextToken();
+
+    if (!parser_.TryAutomaticInsertSemicolon()) {
+      return false;
+    }
+  }
+
+  std::vector<std::u16string_view> var_names;
+  std::vector<std::size_t> decl_offsets;
+
+  Lexer scanner{lexer.GetSource().substr(lexer.GetTokenOffset()), arena};
+  std::size_t base = lexer.GetTokenOffset();
+  scanner.NextToken();
+
+  std::size_t depth = 0;
+  TokenType prev = TokenType::SEMICOLON;
+  TokenType prev_prev = TokenType::SEMICOLON;
+
+  bool in_var = false;
+  bool expects_name = false;
+  bool is_for_in = false;
+  std::size_t var_depth = 0;
+
+  while (true) {
+    auto type = scanner.GetToken().GetType();
+    if (type == TokenType::EOS) {
+      break;
+    }
+    if (type == TokenType::ILLEGAL) {
+      return false;
+    }
+
+    if (in_var) {
+      if (expects_name) {
+        expects_name = false;
+        if (type == TokenType::IDENTIFIER) {
+          var_names.push_back(scanner.GetToken().GetString());
+        }
+      } else if (depth == var_depth) {
+        if (type == TokenType::COMMA) {
+          expects_name = true;
+        } else if (type == TokenType::SEMICOLON ||
+                   (type == TokenType::KEYWORD_IN && is_for_in) ||
+                   (scanner.HasLineTerminator() && EndsExpression(prev) && BeginsStatement(type))) {
+          in_var = false;
+        }
+      }
+    }
+
+    switch (type) {
+      case TokenType::LEFT_BRACE:
+      case TokenType::LEFT_PAREN:
+      case TokenType::LEFT_BRACKET: {
+        ++depth;
+        break;
+      }
+      case TokenType::RIGHT_BRACE:
+      case TokenType::RIGHT_PAREN:
+      case TokenType::RIGHT_BRACKET: {
+        if (depth == 0) {
+          return false;
+        }
+        if (in_var && depth == var_depth) {
+          in_var = false;
+        }
+        --depth;
+        break;
+      }
+      case TokenType::KEYWORD_VAR: {
+        in_var = true;
+        expects_name = true;
+        is_for_in = prev == TokenType::LEFT_PAREN && prev_prev == TokenType::KEYWORD_FOR;
+        var_depth = depth;
+        break;
+      }
+      case TokenType::KEYWORD_FUNCTION: {
+        // A FunctionDeclaration can not follow an expression on the same line
+        bool is_decl =
+          depth == 0 && !in_var &&
+          (prev == TokenType::SEMICOLON || prev == TokenType::RIGHT_BRACE ||
+           (scanner.HasLineTerminator() && EndsExpression(prev)));
+        auto offset = base + scanner.GetTokenOffset();
+        if (is_decl) {
+          decl_offsets.push_back(offset);
+        } else {
+          function_offsets_.push_back(offset);
+        }
+        if (!SkipFunction(&scanner)) {
+          return false;
+        }
+        prev_prev = prev;
+        prev = TokenType::RIGHT_BRACE;
+        continue;
+      }
+      default: {
+        break;
+      }
+    }
+
+    prev_prev = prev;
+    prev = type;
+    scanner.NextToken();
+  }
+  if (depth != 0) {
+    return false;
+  }
+
+  VariableDeclarations var_decls{arena};
+  for (auto name : var_names) {
+    if (var_names_.insert(name).second) {
+      var_decls.push_back(arena->New<VariableDeclaration>(arena->New<Identifier>(name), nullptr));
+    }
+  }
+
+  // Only the header of a FunctionDeclaration is parsed, its body is lazy
+  FunctionDeclarations func_decls{arena};
+  for (auto offset : decl_offsets) {
+    Parser parser{lexer.GetSource().substr(offset), arena};
+    parser.EnterFunctionScope();
+    try {
+      auto func_decl = parser.ParseFunctionDeclaration()->AsFunctionDeclaration();
+      function_names_.insert(func_decl->GetName()->AsIdentifier()->GetName());
+      func_decls.push_back(func_decl);
+    } catch (const utils::Error&) {
+      return false;
+    }
+  }
+
+  declarations_ = std::make_unique<Program>(
+    nullptr, Statements{arena}, is_strict_, std::move(var_decls), std::move(func_decls));
+
+  return true;
+}
+
+ast::Program* StreamingParser::ParseChunk() {
+  auto& lexer = parser_.lexer_;
+  if (has_error_ || lexer.GetToken().GetType() == TokenType::EOS) {
+    chunk_.reset();
+    return nullptr;
+  }
+
+  // Switch to the Arena of the new chunk before releasing the previous one,
+  // the current Token was read while parsing it.
+  auto arena = std::make_unique<utils::Arena>();
+  parser_.arena_ = arena.get();
+  lexer.SetArena(arena.get());
+  chunk_.reset();
+
+  auto begin = lexer.GetTokenOffset();
+  parser_.lazy_functions_.clear();
+  parser_.EnterFunctionScope();
+  Statements stmts{parser_.arena_};
+  try {
+    do {
+      if (lexer.GetToken().GetType() == TokenType::KEYWORD_FUNCTION) {
+        stmts.push_back(parser_.ParseFunctionDeclaration());
+      } else {
+        stmts.push_back(parser_.ParseStatement());
+      }
+    } while (lexer.GetToken().GetType() != TokenType::EOS &&
+             lexer.GetTokenOffset() - begin < chunk_size_);
+  } catch (const utils::Error& e) {
+    parser_.ExitFunctionScope();
+    has_error_ = true;
+    error_ = e;
+    std::cout << e.GetMessage() << std::endl;
+    return nullptr;
+  }
+  auto end = lexer.GetTokenOffset();
+  auto [var_decls, func_decls, uses_arguments, frame_slots] = parser_.ExitFunctionScope();
+
+  // Leave out what has been hoisted already
+  VariableDeclarations missed_var_decls{parser_.arena_};
+  for (auto var_decl : var_decls) {
+    if (!var_names_.count(var_decl->GetIdentifier()->AsIdentifier()->GetName())) {
+      missed_var_decls.push_back(var_decl);
+    }
+  }
+  FunctionDeclarations missed_func_decls{parser_.arena_};
+  for (auto func_decl : func_decls) {
+    if (!function_names_.count(func_decl->GetName()->AsIdentifier()->GetName())) {
+      missed_func_decls.push_back(func_decl);
+    }
+  }
+
+  // Function objects refer to their AST and to the Arena it is in
+  bool has_functions = !missed_func_decls.empty();
+  for (; next_function_ < function_offsets_.size() && function_offsets_[next_function_] < end; ++next_function_) {
+    has_functions = true;
+  }
+
+  auto chunk = std::make_unique<Program>(
+    std::move(arena), std::move(stmts), is_strict_, std::move(missed_var_decls), std::move(missed_func_decls));
+  if (has_functions) {
+    retained_chunks_.push_back(std::move(chunk));
+    return retained_chunks_.back().get();
+  }
+  chunk_ = std::move(chunk);
+  return chunk_.get();
+}
+
+// Skips a FunctionDeclaration or FunctionExpression, stopping after its closing '}'
+bool StreamingParser::SkipFunction(Lexer* lexer) {
+  // begin with function
+  lexer->NextToken();
+  if (lexer->GetToken().GetType() == TokenType::IDENTIFIER) {
+    lexer->NextToken();
+  }
+
+  if (lexer->GetToken().GetType() != TokenType::LEFT_PAREN) {
+    return false;
+  }
+  while (lexer->GetToken().GetType() != TokenType::RIGHT_PAREN) {
+    if (lexer->GetToken().GetType() == TokenType::EOS) {
+      return false;
+    }
+    lexer->NextToken();
+  }
+  lexer->NextToken();
+
+  if (lexer->GetToken().GetType() != TokenType::LEFT_BRACE) {
+    return false;
+  }
+  std::size_t depth = 0;
+  do {
+    auto type = lexer->GetToken().GetType();
+    if (type == TokenType::LEFT_BRACE) {
+      ++depth;
+    } else if (type == TokenType::RIGHT_BRACE) {
+      --depth;
+    } else if (type == TokenType::EOS || type == TokenType::ILLEGAL) {
+      return false;
+    }
+    lexer->NextToken();
+  } while (depth != 0);
+
+  return true;
+}
+
+// Whether an expression may end with a token of type
+bool StreamingParser::EndsExpression(TokenType type) {
+  switch (type) {
+    case TokenType::IDENTIFIER:
+    case TokenType::NUMBER:
+    case TokenType::STRING:
+    case TokenType::NULL_LITERAL:
+    case TokenType::TRUE:
+    case TokenType::FALSE:
+    case TokenType::KEYWORD_THIS:
+    case TokenType::RIGHT_PAREN:
+    case TokenType::RIGHT_BRACKET:
+    case TokenType::RIGHT_BRACE:
+    case TokenType::INC:
+    case TokenType::DEC: {
+      return true;
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+// Whether a token of type can not continue an expression, but can begin a statement.
+// Following an expression on the next line, it is preceded by an inserted ';'.
+bool StreamingParser::BeginsStatement(TokenType type) {
+  switch (type) {
+    case TokenType::IDENTIFIER:
+    case TokenType::NUMBER:
+    case TokenType::STRING:
+    case TokenType::NULL_LITERAL:
+    case TokenType::TRUE:
+    case TokenType::FALSE:
+    case TokenType::LEFT_BRACE:
+    case TokenType::LOGICAL_NOT:
+    case TokenType::BIT_NOT:
+    case TokenType::INC:
+    case TokenType::DEC: {
+      return true;
+    }
+    case TokenType::KEYWORD_IN:
+    case TokenType::KEYWORD_INSTANCEOF: {
+      return false;
+    }
+    default: {
+      return type >= TokenType::KEYWORD_BREAK && type <= TokenType::KEYWORD_TRY;
+    }
+  }
+}
+
+}  // namespace voidjs
@@ -0,0 +1,88 @@
+#ifndef VOIDJS_PARSER_STREAMING_PARSER_H
+#define VOIDJS_PARSER_STREAMING_PARSER_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "voidjs/ir/program.h"
+#include "voidjs/lexer/lexer.h"
+#include "voidjs/parser/parser.h"
+#include "voidjs/utils/arena.h"
+#include "voidjs/utils/error.h"
+
+namespace voidjs {
+
+// StreamingParser hands out the SourceElements of a Program in chunks,
+// so that a large script can be executed while it is parsed,
+// and the AST of a chunk can be released once the chunk has been executed.
+//
+// Hoisting is kept by ScanDeclarations, which lexes the whole source once without building an AST,
+// collecting the top level var names and parsing only the top level FunctionDeclarations.
+// A chunk only declares what the scan missed, which is normally nothing.
+//
+// The source and the declarations live as long as the StreamingParser.
+// A chunk lives until the next call to ParseChunk, unless functions may have been
+// instantiated from it, in which case it is kept for as long as the StreamingParser.
+class StreamingParser {
+ public:
+  // Size of a chunk in UTF-16 code units of source, a chunk ends with the first
+  // SourceElement which reaches it.
+  static constexpr std::size_t CHUNK_SIZE = 1 << 20;
+
+  explicit StreamingParser(std::u16string_view src, std::size_t chunk_size = CHUNK_SIZE)
+    : parser_(src, true), chunk_size_(chunk_size)
+  {}
+
+  explicit StreamingParser(std::string_view utf8_src, std::size_t chunk_size = CHUNK_SIZE)
+    : parser_(utf8_src, true), chunk_size_(chunk_size)
+  {}
+
+  // Non-Copyable
+  StreamingParser(const StreamingParser&) = delete;
+  StreamingParser& operator=(const StreamingParser&) = delete;
+
+  // Must be called before ParseChunk. Returns false if the source can not be scanned,
+  // in that case it is certainly not a valid Program and should be parsed with Parser,
+  // which reports the error.
+  bool ScanDeclarations();
+
+  // A Program without statements, holding the declarations found by ScanDeclarations
+  ast::Program* GetDeclarations() const { return declarations_.get(); }
+
+  // Returns nullptr at the end of source, or on a syntax error
+  ast::Program* ParseChunk();
+
+  bool HasError() const { return has_error_; }
+  const utils::Error& GetError() const { return error_; }
+
+ private:
+  static bool SkipFunction(Lexer* lexer);
+  static bool EndsExpression(TokenType type);
+  static bool BeginsStatement(TokenType type);
+
+ private:
+  Parser parser_;
+  std::size_t chunk_size_;
+
+  std::unique_ptr<ast::Program> declarations_;
+  std::unordered_set<std::u16string_view> var_names_;
+  std::unordered_set<std::u16string_view> function_names_;
+
+  // Offsets of the functions which are not hoisted, in source order
+  std::vector<std::size_t> function_offsets_;
+  std::size_t next_function_ {0};
+
+  std::unique_ptr<ast::Program> chunk_;
+  std::vector<std::unique_ptr<ast::Program>> retained_chunks_;
+
+  bool is_strict_ {false};
+  bool has_error_ {false};
+  utils::Error error_;
+};
+
+}  // namespace voidjs
+
+#endif  // VOIDJS_PARSER_STREAMING_PARSER_H
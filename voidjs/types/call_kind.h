@@ -0,0 +1,37 @@
+#ifndef VOIDJS_TYPES_CALL_KIND_H
+#define VOIDJS_TYPES_CALL_KIND_H
+
+#include <cstdint>
+
+namespace voidjs {
+
+// CallKind tells how [[Call]] and [[Construct]] of a callable object are carried out,
+// Object::Call and Object::Construct dispatch on it through a table of entries.
+enum class CallKind : std::uint8_t {
+  // Not callable, or without a [[Call]] of its own
+  NONE,
+
+  // Function objects created by 13.2
+  JS_FUNCTION,
+
+  // Builtin functions which are not constructors
+  INTERNAL_FUNCTION,
+
+  // Builtin constructors
+  OBJECT_CONSTRUCTOR,
+  FUNCTION_CONSTRUCTOR,
+  ARRAY_CONSTRUCTOR,
+  STRING_CONSTRUCTOR,
+  BOOLEAN_CONSTRUCTOR,
+  NUMBER_CONSTRUCTOR,
+  ERROR_CONSTRUCTOR,
+
+  // Function objects created by Function.prototype.bind
+  BOUND_FUNCTION,
+
+  CALL_KIND_NUM,
+};
+
+}  // namespace voidjs
+
+#endif  // VOIDJS_TYPES_CALL_KIND_H
@@ -1,5 +1,7 @@
 #include "voidjs/types/heap_object.h"
 
+#include <cstdlib>
+
 #include "voidjs/gc/heap.h"
 #include "voidjs/types/internal_types/binding.h"
 #include "voidjs/types/internal_types/hash_map.h"
@@ -19,6 +21,8 @@
 #include "voidjs/builtins/js_number.h"
 #include "voidjs/builtins/js_string.h"
 #include "voidjs/builtins/js_math.h"
+#include "voidjs/builtins/arguments.h"
+#include "voidjs/builtins/bound_function.h"
 #include "voidjs/gc/js_handle.h"
 #include "voidjs/types/spec_types/environment_record.h"
 #include "voidjs/types/spec_types/lexical_environment.h"
@@ -105,7 +109,18 @@ std::size_t HeapObject::GetSize(JSValue value) {
     case JSType::JS_ERROR: {
       return builtins::JSError::SIZE + types::Object::SIZE + HeapObject::SIZE;
     }
+    case JSType::ARGUMENTS: {
+      return builtins::Arguments::SIZE + types::Object::SIZE + HeapObject::SIZE;
+    }
+    case JSType::BOUND_FUNCTION: {
+      return builtins::BoundFunction::SIZE + types::Object::SIZE + HeapObject::SIZE;
+    }
+    case JSType::JS_TYPE_NUM: {
+      break;
+    }
   }
+  // No object has the type JS_TYPE_NUM, only a corrupt type tag gets here
+  std::abort();
 }
   
 std::size_t HeapObject::GetSize(JSHandle<JSValue> handle) {
@@ -131,7 +146,7 @@ std::vector<JSHandle<JSValue>> HeapObject::GetValues(JSValue value) {
       std::size_t length = array->GetLength();
       std::vector<JSHandle<JSValue>> handles;
       for (std::size_t idx = 0; idx < length; ++idx) {
-        handles.emplace_back(value.GetRawData() + types::Array::DATA_OFFSET + idx);
+        handles.emplace_back(value.GetRawData() + types::Array::DATA_OFFSET + idx * sizeof(JSValue));
       }
       return handles;
     }
@@ -148,11 +163,12 @@ std::vector<JSHandle<JSValue>> HeapObject::GetValues(JSValue value) {
       return {};
     }
     case JSType::PROPERTY_MAP: {
-      types::Array* array = value.GetHeapObject()->AsArray();
-      std::size_t length = array->GetLength();
+      // Only the header and entries hold JSValue, control bytes are skipped
+      types::HashMap* hashmap = value.GetHeapObject()->AsHashMap();
+      std::size_t length = hashmap->GetEntriesLength();
       std::vector<JSHandle<JSValue>> handles;
       for (std::size_t idx = 0; idx < length; ++idx) {
-        handles.emplace_back(value.GetRawData() + types::Array::DATA_OFFSET + idx);
+        handles.emplace_back(value.GetRawData() + types::Array::DATA_OFFSET + idx * sizeof(JSValue));
       }
       return handles;
     }
@@ -166,11 +182,12 @@ std::vector<JSHandle<JSValue>> HeapObject::GetValues(JSValue value) {
       };
     }
     case JSType::HASH_MAP: {
-      types::Array* array = value.GetHeapObject()->AsArray();
-      std::size_t length = array->GetLength();
+      // Only the header and entries hold JSValue, control bytes are skipped
+      types::HashMap* hashmap = value.GetHeapObject()->AsHashMap();
+      std::size_t length = hashmap->GetEntriesLength();
       std::vector<JSHandle<JSValue>> handles;
       for (std::size_t idx = 0; idx < length; ++idx) {
-        handles.emplace_back(value.GetRawData() + types::Array::DATA_OFFSET + idx);
+        handles.emplace_back(value.GetRawData() + types::Array::DATA_OFFSET + idx * sizeof(JSValue));
       }
       return handles;
     }
@@ -247,7 +264,29 @@ std::vector<JSHandle<JSValue>> HeapObject::GetValues(JSValue value) {
         JSHandle<JSValue>{value.GetRawData() + types::Object::PROTOTYPE_OFFSET}
       };
     }
+    case JSType::ARGUMENTS: {
+      return {
+        JSHandle<JSValue>{value.GetRawData() + types::Object::PROPERTIES_OFFSET},
+        JSHandle<JSValue>{value.GetRawData() + types::Object::PROTOTYPE_OFFSET},
+        JSHandle<JSValue>{value.GetRawData() + builtins::Arguments::PARAMETER_MAP_OFFSET},
+        JSHandle<JSValue>{value.GetRawData() + builtins::Arguments::ENVIRONMENT_OFFSET}
+      };
+    }
+    case JSType::BOUND_FUNCTION: {
+      return {
+        JSHandle<JSValue>{value.GetRawData() + types::Object::PROPERTIES_OFFSET},
+        JSHandle<JSValue>{value.GetRawData() + types::Object::PROTOTYPE_OFFSET},
+        JSHandle<JSValue>{value.GetRawData() + builtins::BoundFunction::TARGET_FUNCTION_OFFSET},
+        JSHandle<JSValue>{value.GetRawData() + builtins::BoundFunction::BOUND_THIS_OFFSET},
+        JSHandle<JSValue>{value.GetRawData() + builtins::BoundFunction::BOUND_ARGS_OFFSET}
+      };
+    }
+    case JSType::JS_TYPE_NUM: {
+      break;
+    }
   }
+  // No object has the type JS_TYPE_NUM, only a corrupt type tag gets here
+  std::abort();
 }
   
 }  // namespace voidjs
@@ -9,6 +9,7 @@
 #include "voidjs/types/js_type.h"
 #include "voidjs/types/object_class_type.h"
 #include "voidjs/types/error_type.h"
+#include "voidjs/types/call_kind.h"
 
 namespace voidjs {
 namespace types {
@@ -42,6 +43,7 @@ class JSNumber;
 class JSMath; 
 class JSError;
 class Arguments;
+class BoundFunction;
 
 }  // namespace builtins
 
@@ -77,6 +79,11 @@ class HeapObject {
 
   // ObjectEnvironmentRecord properies
   // bool provide_this                 1 bit
+
+  // enum CallKind call_kind           8 bits
+
+  // Whether all internal methods of an Object are the default ones of 8.12
+  // bool ordinary                     1 bit
   
   static constexpr std::size_t META_DATA_OFFSET = 0;
   static constexpr std::size_t META_DATA_SIZE = sizeof(std::uint64_t);
@@ -155,6 +162,14 @@ class HeapObject {
   bool GetProvideThis() const { return ProvideThisBitSet::Get(*GetMetaData()); }
   void SetProvideThis(bool flag) { ProvideThisBitSet::Set(GetMetaData(), flag); }
 
+  using CallKindBitSet = utils::BitSet<CallKind, 39, 47>;
+  CallKind GetCallKind() const { return CallKindBitSet::Get(*GetMetaData()); }
+  void SetCallKind(CallKind kind) { CallKindBitSet::Set(GetMetaData(), kind); }
+
+  using OrdinaryBitSet = utils::BitSet<bool, 47, 48>;
+  bool IsOrdinary() const { return OrdinaryBitSet::Get(*GetMetaData()); }
+  void SetOrdinary(bool flag) { OrdinaryBitSet::Set(GetMetaData(), flag); }
+
   static constexpr std::size_t SIZE = META_DATA_SIZE;
   static constexpr std::size_t END_OFFSET = META_DATA_OFFSET + META_DATA_SIZE;
 
@@ -187,6 +202,7 @@ class HeapObject {
   bool ISJSMath() const { return GetType() == JSType::JS_MATH; } 
   bool IsJSError() const { return GetType() == JSType::JS_ERROR; }
   bool IsArguments() const { return GetType() == JSType::ARGUMENTS; }
+  bool IsBoundFunction() const { return GetType() == JSType::BOUND_FUNCTION; }
 
   // As Cast
   types::String* AsString() { return reinterpret_cast<types::String*>(this); }
@@ -213,6 +229,7 @@ class HeapObject {
   builtins::JSMath* AsJSMath() { return reinterpret_cast<builtins::JSMath*>(this); }
   builtins::JSError* AsJSError() { return reinterpret_cast<builtins::JSError*>(this); }
   builtins::Arguments* AsArguments() { return reinterpret_cast<builtins::Arguments*>(this); } 
+  builtins::BoundFunction* AsBoundFunction() { return reinterpret_cast<builtins::BoundFunction*>(this); }
 
   // As Cast
   const types::String* AsString() const { return reinterpret_cast<const types::String*>(this); }
@@ -239,6 +256,7 @@ class HeapObject {
   const builtins::JSMath* AsJSMath() const { return reinterpret_cast<const builtins::JSMath*>(this); }
   const builtins::JSError* AsJSError() const { return reinterpret_cast<const builtins::JSError*>(this); }
   const builtins::Arguments* AsArguments() const { return reinterpret_cast<const builtins::Arguments*>(this); } 
+  const builtins::BoundFunction* AsBoundFunction() const { return reinterpret_cast<const builtins::BoundFunction*>(this); }
 };
 
 }  // namespace voidjs
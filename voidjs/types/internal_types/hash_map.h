@@ -2,6 +2,12 @@
 #define VOIDJS_TYPES_INTERNAL_TYPE_HASH_MAP_H
 
 #include <functional>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "voidjs/types/heap_object.h"
 #include "voidjs/types/internal_types/array.h"
@@ -12,6 +18,20 @@
 namespace voidjs {
 namespace types {
 
+// HashMap is an open addressing hash table in the style of SwissTable.
+//
+// Layout of the underlying Array:
+// | size | capacity | tombstones | key_0 | value_0 | attributes_0 | ... | control bytes |
+//
+// attributes is a small int stored next to the value,
+// PropertyMap uses it to keep the attributes of a property inline.
+//
+// Every entry owns one control byte, which is CTRL_EMPTY, CTRL_DELETED or
+// the high 7 bits (H2) of the hash of the key stored in it.
+// Control bytes are probed a group of GROUP_WIDTH at a time, so most lookups
+// touch only one String, the one whose H2 matches.
+// The first GROUP_WIDTH - 1 control bytes are cloned after the last one,
+// so that a group can be loaded at any position without wrapping around.
 class HashMap : public Array {
  public:
   static constexpr std::uint32_t BUCKET_SIZE_INDEX = 0;
@@ -19,55 +39,110 @@ class HashMap : public Array {
   void SetBucketSize(std::int32_t size) { Set(BUCKET_SIZE_INDEX, JSValue{size}); }
   void IncreaseBucketSize() { SetBucketSize(GetBucketSize() + 1); }
   void DecreaseBucketSize() { SetBucketSize(GetBucketSize() - 1); }
-  
+
   static constexpr std::uint32_t BUCKET_CAPACITY_INDEX = 1;
   std::int32_t GetBucketCapacity() const { return Get(BUCKET_CAPACITY_INDEX).GetInt(); }
   void SetBucketCapacity(std::int32_t capacity) { return Set(BUCKET_CAPACITY_INDEX, JSValue(capacity)); }
 
+  static constexpr std::uint32_t TOMBSTONE_SIZE_INDEX = 2;
+  std::int32_t GetTombstoneSize() const { return Get(TOMBSTONE_SIZE_INDEX).GetInt(); }
+  void SetTombstoneSize(std::int32_t size) { Set(TOMBSTONE_SIZE_INDEX, JSValue{size}); }
+
   static constexpr std::size_t SIZE = 0;
   static constexpr std::size_t END_OFFSET = Array::END_OFFSET + SIZE;
 
   using Hash = utils::detail::hash<std::u16string_view>;
   static constexpr std::uint32_t MIN_CAPACITY = 2;
 
-  static constexpr std::uint32_t HEADER_SIZE       = 2;
-  static constexpr std::uint32_t ENTRY_SIZE        = 2;
-  static constexpr std::uint32_t ENTRY_KEY_INDEX   = 0;
-  static constexpr std::uint32_t ENTRY_VALUE_INEDX = 1;
+  static constexpr std::uint32_t HEADER_SIZE       = 3;
+  static constexpr std::uint32_t ENTRY_SIZE             = 3;
+  static constexpr std::uint32_t ENTRY_KEY_INDEX        = 0;
+  static constexpr std::uint32_t ENTRY_VALUE_INEDX      = 1;
+  static constexpr std::uint32_t ENTRY_ATTRIBUTES_INDEX = 2;
+
+  static constexpr std::uint32_t GROUP_WIDTH = 16;
+
+  static constexpr std::int8_t CTRL_EMPTY   = -128;
+  static constexpr std::int8_t CTRL_DELETED = -2;
+
+  static constexpr std::uint32_t NOT_FOUND = std::numeric_limits<std::uint32_t>::max();
+
+  // Number of JSValue slots used by the header and the entries for a given capacity,
+  // only these slots hold JSValue, the rest of the Array holds control bytes
+  static constexpr std::uint32_t GetEntriesLength(std::uint32_t capacity) {
+    return HEADER_SIZE + ENTRY_SIZE * capacity;
+  }
+  static constexpr std::uint32_t GetCtrlLength(std::uint32_t capacity) {
+    return (capacity + GROUP_WIDTH + sizeof(JSValue) - 1) / sizeof(JSValue);
+  }
+  static constexpr std::uint32_t GetTotalLength(std::uint32_t capacity) {
+    return GetEntriesLength(capacity) + GetCtrlLength(capacity);
+  }
+  std::uint32_t GetEntriesLength() const { return GetEntriesLength(GetBucketCapacity()); }
+
+  // Smallest capacity which holds size entries without a rehash, see NeedsRehash
+  static constexpr std::uint32_t GetCapacityFor(std::size_t size) {
+    std::uint32_t capacity = MIN_CAPACITY;
+    while (size * 8 > capacity * 7) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  static JSHandle<HashMap> Insert(VM* vm, JSHandle<HashMap> hashmap, JSHandle<String> key, JSHandle<JSValue> value,
+                                  std::int32_t attributes = 0) {
+    auto hash = Hash{}(key->GetString());
+
+    auto entry = hashmap->FindEntry(key.GetObject(), hash);
+    if (entry != NOT_FOUND) {
+      hashmap->SetValue(entry, value.GetJSValue());
+      hashmap->SetAttributes(entry, attributes);
+      return hashmap;
+    }
 
-  static JSHandle<HashMap> Insert(VM* vm, JSHandle<HashMap> hashmap, JSHandle<String> key, JSHandle<JSValue> value) {
     auto new_hashmap = std::invoke([=]() {
-      if (!hashmap->IsFull()) {
+      if (!hashmap->NeedsRehash()) {
         return hashmap;
       }
-      
-      auto new_hashmap = Reserve(vm, hashmap, hashmap->GetBucketCapacity() << 1);
-      return new_hashmap;
+
+      // When enough of the used slots are tombstones,
+      // rehashing at the same capacity is enough to make room.
+      std::uint32_t size = hashmap->GetBucketSize();
+      std::uint32_t capacity = hashmap->GetBucketCapacity();
+      if (capacity > GROUP_WIDTH && size * 32 <= capacity * 25) {
+        return Rehash(vm, hashmap, capacity);
+      }
+      return Rehash(vm, hashmap, capacity << 1);
     });
-    
-    auto entry = new_hashmap->FindEntry(key.GetObject());
 
-    if (new_hashmap->GetKey(entry).IsHole()) {
-      new_hashmap->AddEntry(entry, key.GetObject(), value.GetJSValue());
-    } else {
-      new_hashmap->SetValue(entry, value.GetJSValue());
-    }
+    new_hashmap->AddEntry(new_hashmap->FindInsertPosition(hash), key.GetObject(), hash, value.GetJSValue(), attributes);
 
     return new_hashmap;
   }
 
-  void Erase(VM* vm, JSHandle<String> key) {
-    auto entry = FindEntry(key.GetObject());
+  // Erase may shrink the hashmap when most of it is unused,
+  // so the returned hashmap must replace the old one.
+  static JSHandle<HashMap> Erase(VM* vm, JSHandle<HashMap> hashmap, JSHandle<String> key) {
+    auto entry = hashmap->FindEntry(key.GetObject(), Hash{}(key->GetString()));
+    if (entry == NOT_FOUND) {
+      return hashmap;
+    }
+
+    hashmap->DeleteEntry(entry);
 
-    if (!GetKey(entry).IsHole()) {
-      DeleteEntry(entry);
+    std::uint32_t size = hashmap->GetBucketSize();
+    std::uint32_t capacity = hashmap->GetBucketCapacity();
+    if (capacity > GROUP_WIDTH && size * 4 < capacity) {
+      return Rehash(vm, hashmap, capacity >> 1);
     }
+
+    return hashmap;
   }
 
   JSHandle<JSValue> Find(VM* vm, JSHandle<String> key) const {
-    auto entry = FindEntry(key.GetObject());
+    auto entry = FindEntry(key.GetObject(), Hash{}(key->GetString()));
 
-    if (!GetKey(entry).IsHole()) {
+    if (entry != NOT_FOUND) {
       return JSHandle<JSValue>{vm, GetValue(entry)};
     } else {
       return {};
@@ -78,93 +153,129 @@ class HashMap : public Array {
     std::vector<JSHandle<JSValue>> keys;
     std::uint32_t capacity = GetBucketCapacity();
     for (std::uint32_t idx = 0; idx < capacity; ++idx) {
-      JSValue key = GetKey(idx);
-      if (!GetKey(idx).IsHole() && !GetKey(idx).IsUndefined()) {
-        keys.emplace_back(vm, key);
-      }
-    }
-    return keys;
-  }
-
-  std::vector<JSHandle<JSValue>> GetAllOwnEnumerableKeys(VM* vm) {
-    std::vector<JSHandle<JSValue>> keys;
-    std::uint32_t capacity = GetBucketCapacity();
-    for (std::uint32_t idx = 0; idx < capacity; ++idx) {
-      JSValue key = GetKey(idx);
-      if (!GetKey(idx).IsHole() && !GetKey(idx).IsUndefined() && GetValue(idx).GetHeapObject()->GetEnumerable()) {
-        keys.emplace_back(vm, key);
+      if (IsFull(GetCtrl(idx))) {
+        keys.emplace_back(vm, GetKey(idx));
       }
     }
     return keys;
   }
 
-  // std::vector<JSHandle<JSValue>> GetAllValues(VM* vm) {
-  //   std::vector<JSHandle<JSValue>> keys;
-  //   std::uint32_t capacity = GetBucketCapacity();
-  //   for (std::uint32_t idx = 0; idx < capacity; ++idx) {
-  //     JSValue key = GetKey(idx);
-  //     if (!GetKey(idx).IsHole() && !GetKey(idx).IsUndefined()) {
-  //       keys.emplace_back(vm, GetValue(idx));
-  //     }
-  //   }
-  //   return keys;
-  // }
-
   static JSHandle<HashMap> Reserve(VM* vm, JSHandle<HashMap> hashmap, std::uint32_t capacity) {
-    if (capacity <= hashmap->GetBucketCapacity()) {
+    if (capacity <= static_cast<std::uint32_t>(hashmap->GetBucketCapacity())) {
       return hashmap;
     }
 
-    auto new_hashmap = vm->GetObjectFactory()->NewHashMap(capacity);
-    Rehash(vm, new_hashmap, hashmap);
-    
-    return new_hashmap;
+    return Rehash(vm, hashmap, capacity);
   }
 
-  static void Rehash(VM* vm, JSHandle<HashMap> new_hashmap, JSHandle<HashMap> old_hashmap) {
-    auto old_capacity = old_hashmap->GetBucketCapacity();
+  // Rehash moves all live entries of old_hashmap into a new hashmap with given capacity,
+  // tombstones are dropped on the way.
+  static JSHandle<HashMap> Rehash(VM* vm, JSHandle<HashMap> old_hashmap, std::uint32_t capacity) {
+    auto new_hashmap = vm->GetObjectFactory()->NewHashMap(capacity);
+    new_hashmap->SetType(old_hashmap->GetType());
+
+    std::uint32_t old_capacity = old_hashmap->GetBucketCapacity();
     for (std::uint32_t idx = 0; idx < old_capacity; ++idx) {
-      auto key = old_hashmap->GetKey(idx);
-      if (key.IsHole() || key.IsUndefined()) {
+      if (!IsFull(old_hashmap->GetCtrl(idx))) {
         continue;
       }
 
-      auto value = old_hashmap->GetValue(idx);
-      auto entry = new_hashmap->FindEntry(key.GetHeapObject()->AsString());
-      new_hashmap->AddEntry(entry, key.GetHeapObject()->AsString(), value);
+      auto key = old_hashmap->GetKey(idx).GetHeapObject()->AsString();
+      auto hash = Hash{}(key->GetString());
+      new_hashmap->AddEntry(new_hashmap->FindInsertPosition(hash), key, hash,
+                            old_hashmap->GetValue(idx), old_hashmap->GetAttributes(idx));
     }
+
+    return new_hashmap;
   }
 
- private:
-  std::uint32_t FindEntry(String* key) const {
-    auto hash = Hash{}(key->GetString());
-    for (std::uint32_t entry = GetFirstPosition(hash), cnt = 0; ; entry = GetNextPosition(entry, ++cnt)) {
-      auto key_val = GetKey(entry);
-      if (key_val.IsHole()) {
-        return entry;
-      }
-      if (key_val.IsUndefined()) {
-        // Undefined means it was deleted;
-        continue;
+  void InitializeCtrl() {
+    std::memset(GetCtrl(), CTRL_EMPTY, GetCtrlLength(GetBucketCapacity()) * sizeof(JSValue));
+  }
+
+ protected:
+  // Group is a view of GROUP_WIDTH consecutive control bytes,
+  // each Match returns a bit mask whose i-th bit is set when the i-th byte matches.
+  class Group {
+   public:
+#if defined(__SSE2__)
+    explicit Group(const std::int8_t* pos)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    std::uint32_t Match(std::int8_t h2) const {
+      return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+    }
+
+    std::uint32_t MatchEmpty() const {
+      return Match(CTRL_EMPTY);
+    }
+
+    // Both CTRL_EMPTY and CTRL_DELETED have their sign bit set
+    std::uint32_t MatchEmptyOrDeleted() const {
+      return _mm_movemask_epi8(ctrl_);
+    }
+
+   private:
+    __m128i ctrl_;
+#else
+    explicit Group(const std::int8_t* pos) {
+      std::memcpy(ctrl_, pos, GROUP_WIDTH);
+    }
+
+    std::uint32_t Match(std::int8_t h2) const {
+      std::uint32_t mask = 0;
+      for (std::uint32_t idx = 0; idx < GROUP_WIDTH; ++idx) {
+        mask |= static_cast<std::uint32_t>(ctrl_[idx] == h2) << idx;
       }
-      // Else key must be String*
-      if (key_val.GetHeapObject()->AsString()->Equal(key)) {
-        return entry;
+      return mask;
+    }
+
+    std::uint32_t MatchEmpty() const {
+      return Match(CTRL_EMPTY);
+    }
+
+    std::uint32_t MatchEmptyOrDeleted() const {
+      std::uint32_t mask = 0;
+      for (std::uint32_t idx = 0; idx < GROUP_WIDTH; ++idx) {
+        mask |= static_cast<std::uint32_t>(ctrl_[idx] < 0) << idx;
       }
+      return mask;
     }
 
-    // unreached branch
-    // todo
+   private:
+    std::int8_t ctrl_[GROUP_WIDTH];
+#endif
+  };
+
+  std::uint32_t FindEntry(String* key) const {
+    return FindEntry(key, Hash{}(key->GetString()));
   }
 
-  std::uint32_t GetFirstPosition(std::uint64_t hash) const {
-    return hash & GetBucketCapacity() - 1;
+  std::uint32_t FindEntry(String* key, std::uint64_t hash) const {
+    std::uint32_t mask = GetBucketCapacity() - 1;
+    auto h2 = H2(hash);
+    for (std::uint32_t pos = H1(hash) & mask, stride = 0; ; ) {
+      Group group {GetCtrl() + pos};
+      for (auto bits = group.Match(h2); bits; bits &= bits - 1) {
+        auto entry = (pos + __builtin_ctz(bits)) & mask;
+        if (GetKey(entry).GetHeapObject()->AsString()->Equal(key)) {
+          return entry;
+        }
+      }
+      if (group.MatchEmpty()) {
+        return NOT_FOUND;
+      }
+      stride += GROUP_WIDTH;
+      pos = (pos + stride) & mask;
+    }
   }
 
-  std::uint32_t GetNextPosition(std::uint32_t last_pos, std::uint32_t cnt) const {
-    return (last_pos + cnt * (cnt + 1) / 2) & GetBucketCapacity() - 1;
+  static bool IsFull(std::int8_t ctrl) { return ctrl >= 0; }
+
+  std::int8_t GetCtrl(std::uint32_t entry) const {
+    return GetCtrl()[entry];
   }
-  
+
   JSValue GetKey(std::uint32_t entry) const {
     return Get(HEADER_SIZE + entry * ENTRY_SIZE + ENTRY_KEY_INDEX);
   }
@@ -177,21 +288,86 @@ class HashMap : public Array {
   void SetValue(std::uint32_t entry, JSValue value) {
     Set(HEADER_SIZE + entry * ENTRY_SIZE + ENTRY_VALUE_INEDX, value);
   }
+  std::int32_t GetAttributes(std::uint32_t entry) const {
+    return Get(HEADER_SIZE + entry * ENTRY_SIZE + ENTRY_ATTRIBUTES_INDEX).GetInt();
+  }
+  void SetAttributes(std::uint32_t entry, std::int32_t attributes) {
+    Set(HEADER_SIZE + entry * ENTRY_SIZE + ENTRY_ATTRIBUTES_INDEX, JSValue{attributes});
+  }
+
+ private:
+  static std::uint32_t H1(std::uint64_t hash) { return static_cast<std::uint32_t>(hash); }
+  static std::int8_t H2(std::uint64_t hash) { return static_cast<std::int8_t>(hash >> 57); }
+
+  // Returns the first empty or deleted entry in the probe sequence of hash,
+  // there is always one since the hashmap is never full.
+  std::uint32_t FindInsertPosition(std::uint64_t hash) const {
+    std::uint32_t mask = GetBucketCapacity() - 1;
+    for (std::uint32_t pos = H1(hash) & mask, stride = 0; ; ) {
+      Group group {GetCtrl() + pos};
+      if (auto bits = group.MatchEmptyOrDeleted()) {
+        return (pos + __builtin_ctz(bits)) & mask;
+      }
+      stride += GROUP_WIDTH;
+      pos = (pos + stride) & mask;
+    }
+  }
+
+  std::int8_t* GetCtrl() const {
+    return reinterpret_cast<std::int8_t*>(GetData() + GetEntriesLength());
+  }
+  void SetCtrl(std::uint32_t entry, std::int8_t ctrl) {
+    std::uint32_t capacity = GetBucketCapacity();
+    auto data = GetCtrl();
+    data[entry] = ctrl;
+    // Keep the cloned bytes in sync,
+    // a small hashmap is cloned more than once to fill a whole group.
+    for (std::uint32_t idx = entry + capacity; idx < capacity + GROUP_WIDTH - 1; idx += capacity) {
+      data[idx] = ctrl;
+    }
+  }
 
-  void AddEntry(std::uint32_t entry, String* key, JSValue value) {
+  void AddEntry(std::uint32_t entry, String* key, std::uint64_t hash, JSValue value, std::int32_t attributes) {
+    if (GetCtrl(entry) == CTRL_DELETED) {
+      SetTombstoneSize(GetTombstoneSize() - 1);
+    }
+    SetCtrl(entry, H2(hash));
     SetKey(entry, JSValue{key});
     SetValue(entry, value);
+    SetAttributes(entry, attributes);
     IncreaseBucketSize();
   }
 
   void DeleteEntry(std::uint32_t entry) {
-    SetKey(entry, JSValue::Undefined());
+    SetKey(entry, JSValue{});
     SetValue(entry, JSValue{});
+    SetAttributes(entry, 0);
     DecreaseBucketSize();
+
+    // The entry can go back to empty if no probe sequence has ever passed over it,
+    // which is the case when it was never inside a group without empty bytes.
+    std::uint32_t capacity = GetBucketCapacity();
+    if (capacity <= GROUP_WIDTH) {
+      SetCtrl(entry, CTRL_EMPTY);
+      return ;
+    }
+
+    std::uint32_t mask = capacity - 1;
+    auto empty_before = Group{GetCtrl() + ((entry - GROUP_WIDTH) & mask)}.MatchEmpty();
+    auto empty_after = Group{GetCtrl() + entry}.MatchEmpty();
+    if (empty_before && empty_after &&
+        __builtin_ctz(empty_after) + (__builtin_clz(empty_before) - (32 - GROUP_WIDTH)) < GROUP_WIDTH) {
+      SetCtrl(entry, CTRL_EMPTY);
+    } else {
+      SetCtrl(entry, CTRL_DELETED);
+      SetTombstoneSize(GetTombstoneSize() + 1);
+    }
   }
 
-  bool IsFull() {
-    return 1.0 * GetBucketSize() / GetBucketCapacity() >= 0.7;
+  // Keep load factor (including tombstones) under 7/8,
+  // so that every probe sequence ends with an empty entry.
+  bool NeedsRehash() const {
+    return (GetBucketSize() + GetTombstoneSize() + 1) * 8 > GetBucketCapacity() * 7;
   }
 };
 
@@ -0,0 +1,22 @@
+#include "voidjs/types/internal_types/property_map.h"
+
+#include "voidjs/builtins/builtin.h"
+#include "voidjs/builtins/js_function.h"
+#include "voidjs/builtins/js_object.h"
+#include "voidjs/types/internal_types/internal_function.h"
+
+namespace voidjs {
+namespace types {
+
+JSValue PropertyMap::MaterializeLazyProperty(VM* vm, JSHandle<PropertyMap> prop_map, std::uint32_t entry) {
+  auto lazy_value = prop_map->GetValue(entry);
+  auto value = lazy_value.IsInt() ?
+    builtins::Builtin::NewLazyMethod(vm, lazy_value.GetInt()).As<JSValue>() :
+    builtins::Builtin::NewFunctionPrototype(vm, JSHandle<builtins::JSFunction>{vm, lazy_value}).As<JSValue>();
+  prop_map->SetValue(entry, value.GetJSValue());
+  prop_map->SetAttributes(entry, prop_map->GetAttributes(entry) & ~LAZY);
+  return value.GetJSValue();
+}
+
+}  // namespace types
+}  // namespace voidjs
@@ -21,33 +21,108 @@ class PropertyMap : public HashMap {
   static constexpr std::size_t END_OFFSET = HashMap::END_OFFSET + SIZE;
   
   static constexpr std::uint32_t DEFAULT_PROPERTY_NUMS = 4;
-  
-  JSHandle<JSValue> GetProperty(VM* vm, JSHandle<String> key) {
-    return Find(vm, key);
+
+  // Attributes of a property are packed into the attributes slot of its entry.
+  // The value slot holds [[Value]] of a data property,
+  // or an AccessorPropertyDescriptor holding [[Get]] and [[Set]] of an accessor property.
+  static constexpr std::int32_t WRITABLE     = 1 << 0;
+  static constexpr std::int32_t ENUMERABLE   = 1 << 1;
+  static constexpr std::int32_t CONFIGURABLE = 1 << 2;
+  static constexpr std::int32_t ACCESSOR     = 1 << 3;
+
+  // A lazy property is a value which has not been created yet, its value slot holds either
+  //   the index of a builtin method in the method table of Builtin, whose function is yet to be created,
+  //   or a function object, whose prototype property it is, see 13.2.
+  // The value is created the first time it is read.
+  static constexpr std::int32_t LAZY         = 1 << 4;
+
+  static bool IsWritable(std::int32_t attributes) { return attributes & WRITABLE; }
+  static bool IsEnumerable(std::int32_t attributes) { return attributes & ENUMERABLE; }
+  static bool IsConfigurable(std::int32_t attributes) { return attributes & CONFIGURABLE; }
+  static bool IsAccessor(std::int32_t attributes) { return attributes & ACCESSOR; }
+  static bool IsLazy(std::int32_t attributes) { return attributes & LAZY; }
+
+  // Returns the entry of property key, or NOT_FOUND
+  std::uint32_t FindProperty(JSHandle<String> key) const {
+    return FindEntry(key.GetObject());
   }
 
-  bool HasProperty(VM* vm, JSHandle<String> key) {
-    return !Find(vm, key).IsEmpty();
+  // Creating the function of a lazy property may allocate,
+  // so the PropertyMap must not be used through a raw pointer afterwards.
+  JSValue GetPropertyValue(VM* vm, std::uint32_t entry) {
+    auto attributes = GetAttributes(entry);
+    if (IsLazy(attributes)) {
+      return MaterializeLazyProperty(vm, JSHandle<PropertyMap>{vm, this}, entry);
+    }
+    return GetValue(entry);
+  }
+  void SetPropertyValue(std::uint32_t entry, JSValue value) {
+    SetValue(entry, value);
+    if (auto attributes = GetAttributes(entry); IsLazy(attributes)) {
+      SetAttributes(entry, attributes & ~LAZY);
+    }
+  }
+  std::int32_t GetPropertyAttributes(std::uint32_t entry) const { return GetAttributes(entry); }
+
+  bool HasProperty(VM* /*vm*/, JSHandle<String> key) const {
+    return FindProperty(key) != NOT_FOUND;
   }
 
   static JSHandle<PropertyMap> SetProperty(VM* vm, JSHandle<PropertyMap> prop_map, JSHandle<String> key, const PropertyDescriptor& desc) {
-    auto factory = vm->GetObjectFactory();
+    std::int32_t attributes = 0;
+    if (desc.GetEnumerable()) {
+      attributes |= ENUMERABLE;
+    }
+    if (desc.GetConfigurable()) {
+      attributes |= CONFIGURABLE;
+    }
     
-    JSHandle<JSValue> prop;
-    if (desc.IsDataDescriptor()) {
-      prop = factory->NewDataPropertyDescriptor(desc).As<JSValue>();
-    } else if (desc.IsAccessorDescriptor()) {
-      prop = factory->NewAccessorPropertyDescriptor(desc).As<JSValue>();
+    JSHandle<JSValue> value;
+    if (desc.IsAccessorDescriptor()) {
+      attributes |= ACCESSOR;
+      value = vm->GetObjectFactory()->NewAccessorPropertyDescriptor(desc).As<JSValue>();
     } else {
-      prop = factory->NewGenericPropertyDescriptor(desc).As<JSValue>();
+      if (desc.GetWritable()) {
+        attributes |= WRITABLE;
+      }
+      value = desc.GetValue();
+    }
+
+    return Insert(vm, prop_map, key, value, attributes).As<PropertyMap>();
+  }
+
+  static JSHandle<PropertyMap> SetLazyProperty(VM* vm, JSHandle<PropertyMap> prop_map, JSHandle<String> key, JSHandle<JSValue> lazy_value,
+                                               bool writable, bool enumerable, bool configurable) {
+    std::int32_t attributes = LAZY;
+    if (writable) {
+      attributes |= WRITABLE;
     }
+    if (enumerable) {
+      attributes |= ENUMERABLE;
+    }
+    if (configurable) {
+      attributes |= CONFIGURABLE;
+    }
+    return Insert(vm, prop_map, key, lazy_value, attributes).As<PropertyMap>();
+  }
 
-    return Insert(vm, prop_map, key, prop).As<PropertyMap>();
+  static JSHandle<PropertyMap> DeleteProperty(VM* vm, JSHandle<PropertyMap> prop_map, JSHandle<String> key) {
+    return Erase(vm, prop_map, key).As<PropertyMap>();
   }
 
-  void DeleteProperty(VM* vm, JSHandle<String> key) {
-    Erase(vm, key);
+  std::vector<JSHandle<JSValue>> GetAllOwnEnumerableKeys(VM* vm) {
+    std::vector<JSHandle<JSValue>> keys;
+    std::uint32_t capacity = GetBucketCapacity();
+    for (std::uint32_t idx = 0; idx < capacity; ++idx) {
+      if (IsFull(GetCtrl(idx)) && IsEnumerable(GetAttributes(idx))) {
+        keys.emplace_back(vm, GetKey(idx));
+      }
+    }
+    return keys;
   }
+
+ private:
+  static JSValue MaterializeLazyProperty(VM* vm, JSHandle<PropertyMap> prop_map, std::uint32_t entry);
 };
 
 }  // namespace types
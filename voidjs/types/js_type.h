@@ -35,6 +35,9 @@ enum class JSType : std::uint8_t {
   JS_MATH,
   JS_ERROR,
   ARGUMENTS,
+  BOUND_FUNCTION,
+
+  JS_TYPE_NUM,
 };
 
 }  // namespace voidjs
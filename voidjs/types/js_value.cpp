@@ -420,6 +420,11 @@ JSHandle<types::String> JSValue::NumberToString(VM* vm, double num) {
     return vm->GetGlobalConstants()->HandledZeroString();
   }
 
+  if (utils::CanDoubleConvertToInt32(num) &&
+      GlobalConstants::HasSmallIntegerString(static_cast<std::int32_t>(num))) {
+    return vm->GetGlobalConstants()->HandledSmallIntegerString(static_cast<std::int32_t>(num));
+  }
+
   if (std::isinf(num)) {
     return std::signbit(num) ?
       vm->GetGlobalConstants()->HandledNegativeInfinityString() : 
@@ -1,8 +1,11 @@
 #include "voidjs/types/lang_types/object.h"
 
+#include <array>
+#include <iterator>
+#include <utility>
+
 #include "voidjs/builtins/js_boolean.h"
 #include "voidjs/gc/js_handle_scope.h"
-#include "voidjs/interpreter/execution_context.h"
 #include "voidjs/interpreter/vm.h"
 #include "voidjs/types/heap_object.h"
 #include "voidjs/types/js_value.h"
@@ -17,22 +20,117 @@
 #include "voidjs/builtins/js_boolean.h"
 #include "voidjs/builtins/js_number.h"
 #include "voidjs/builtins/js_error.h"
+#include "voidjs/builtins/arguments.h"
+#include "voidjs/builtins/bound_function.h"
 #include "voidjs/interpreter/runtime_call_info.h"
 #include "voidjs/interpreter/interpreter.h"
 #include "voidjs/interpreter/global_constants.h"
+#include "voidjs/parser/parser.h"
 #include "voidjs/utils/macros.h"
 
 
 namespace voidjs {
 namespace types {
 
+namespace {
+
+// The internal methods an Object may replace, those of objects of a JSType
+// are the default ones of 8.12 unless InternalMethods is specialized for it.
+struct InternalMethodTable {
+  PropertyDescriptor (*get_own_property)(VM* vm, JSHandle<Object> O, JSHandle<String> P);
+  JSHandle<JSValue> (*get)(VM* vm, JSHandle<Object> O, JSHandle<String> P);
+  bool (*define_own_property)(VM* vm, JSHandle<Object> O, JSHandle<String> P, const PropertyDescriptor& Desc, bool Throw);
+  bool (*delete_)(VM* vm, JSHandle<Object> O, JSHandle<String> P, bool Throw);
+};
+
+struct DefaultInternalMethods {
+  static PropertyDescriptor GetOwnProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
+    return Object::GetOwnPropertyDefault(vm, O, P);
+  }
+  static JSHandle<JSValue> Get(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
+    return Object::GetDefault(vm, O, P);
+  }
+  static bool DefineOwnProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P, const PropertyDescriptor& Desc, bool Throw) {
+    return Object::DefineOwnPropertyDefault(vm, O, P, Desc, Throw);
+  }
+  static bool Delete(VM* vm, JSHandle<Object> O, JSHandle<String> P, bool Throw) {
+    return Object::DeleteDefault(vm, O, P, Throw);
+  }
+};
+
+template <JSType type>
+struct InternalMethods : DefaultInternalMethods {};
+
+// Defined in ECMAScript 5.1 Chapter 15.3.5.4
+template <>
+struct InternalMethods<JSType::JS_FUNCTION> : DefaultInternalMethods {
+  static JSHandle<JSValue> Get(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
+    return builtins::JSFunction::Get(vm, O.As<builtins::JSFunction>(), P);
+  }
+};
+
+// Defined in ECMAScript 5.1 Chapter 15.4.5.1
+template <>
+struct InternalMethods<JSType::JS_ARRAY> : DefaultInternalMethods {
+  static bool DefineOwnProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P, const PropertyDescriptor& Desc, bool Throw) {
+    return builtins::JSArray::DefineOwnProperty(vm, O, P, Desc, Throw);
+  }
+};
+
+// Defined in ECMAScript 5.1 Chapter 15.5.5.2
+template <>
+struct InternalMethods<JSType::JS_STRING> : DefaultInternalMethods {
+  static PropertyDescriptor GetOwnProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
+    return builtins::JSString::GetOwnProperty(vm, O.As<builtins::JSString>(), P);
+  }
+};
+
+// Defined in ECMAScript 5.1 Chapter 10.6,
+// only reached by Arguments which have a [[ParameterMap]], the others are ordinary.
+template <>
+struct InternalMethods<JSType::ARGUMENTS> {
+  static PropertyDescriptor GetOwnProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
+    return builtins::Arguments::GetOwnProperty(vm, O.As<builtins::Arguments>(), P);
+  }
+  static JSHandle<JSValue> Get(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
+    return builtins::Arguments::Get(vm, O.As<builtins::Arguments>(), P);
+  }
+  static bool DefineOwnProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P, const PropertyDescriptor& Desc, bool Throw) {
+    return builtins::Arguments::DefineOwnProperty(vm, O.As<builtins::Arguments>(), P, Desc, Throw);
+  }
+  static bool Delete(VM* vm, JSHandle<Object> O, JSHandle<String> P, bool Throw) {
+    return builtins::Arguments::Delete(vm, O.As<builtins::Arguments>(), P, Throw);
+  }
+};
+
+template <std::size_t... I>
+constexpr std::array<InternalMethodTable, sizeof...(I)> MakeInternalMethodTables(std::index_sequence<I...>) {
+  return {
+    InternalMethodTable{
+      InternalMethods<static_cast<JSType>(I)>::GetOwnProperty,
+      InternalMethods<static_cast<JSType>(I)>::Get,
+      InternalMethods<static_cast<JSType>(I)>::DefineOwnProperty,
+      InternalMethods<static_cast<JSType>(I)>::Delete,
+    }...
+  };
+}
+
+// Indexed by JSType
+constexpr auto INTERNAL_METHODS =
+  MakeInternalMethodTables(std::make_index_sequence<static_cast<std::size_t>(JSType::JS_TYPE_NUM)>{});
+
+const InternalMethodTable& GetInternalMethods(const Object* O) {
+  return INTERNAL_METHODS[static_cast<std::size_t>(O->GetType())];
+}
+
+}  // namespace
+
 // only used for forwarding
 PropertyDescriptor Object::GetOwnProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
-  if (O->IsJSString()) {
-    return builtins::JSString::GetOwnProperty(vm, O.As<builtins::JSString>(), P);
-  } else {
+  if (O->IsOrdinary()) {
     return GetOwnPropertyDefault(vm, O, P);
   }
+  return GetInternalMethods(O.GetObject()).get_own_property(vm, O, P);
 }
 
 // GetOwnProperty
@@ -41,8 +139,8 @@ PropertyDescriptor Object::GetOwnPropertyDefault(VM* vm, JSHandle<Object> O, JSH
   auto props = O->GetProperties().GetHeapObject()->AsPropertyMap();
   
   // 1. If O doesn’t have an own property with name P, return undefined.
-  auto prop = props->GetProperty(vm, P);
-  if (prop.IsEmpty()) {
+  auto entry = props->FindProperty(P);
+  if (entry == PropertyMap::NOT_FOUND) {
     return PropertyDescriptor{vm};
   }
 
@@ -50,42 +148,33 @@ PropertyDescriptor Object::GetOwnPropertyDefault(VM* vm, JSHandle<Object> O, JSH
   PropertyDescriptor D{vm};
 
   // 3. Let X be O’s own property named P.
-  auto X = prop->GetHeapObject();
+  auto attributes = props->GetPropertyAttributes(entry);
+  auto X = props->GetPropertyValue(vm, entry);
   
   // 4. If X is a data property, then
-  if (X->IsDataPropertyDescriptor()) {
+  if (!PropertyMap::IsAccessor(attributes)) {
     // 1. Set D.[[Value]] to the value of X’s [[Value]] attribute.
-    if (X->HasValue()) {
-      D.SetValue(X->AsDataPropertyDescriptor()->GetValue());
-    }
+    D.SetValue(X);
     
     // 2. Set D.[[Writable]] to the value of X’s [[Writable]] attribute
-    if (X->HasWritable()) {
-      D.SetWritable(X->GetWritable());
-    }
+    D.SetWritable(PropertyMap::IsWritable(attributes));
   }
   // 5. Else X is an accessor property, so
-  else if (X->IsAccessorPropertyDescriptor()) {
+  else {
+    auto accessor = X.GetHeapObject()->AsAccessorPropertyDescriptor();
+    
     // 1. Set D.[[Get]] to the value of X’s [[Get]] attribute.
-    if (X->HasGetter()) {
-      D.SetGetter(X->AsAccessorPropertyDescriptor()->GetGetter());
-    }
+    D.SetGetter(accessor->GetGetter());
 
     // 2. Set D.[[Set]] to the value of X’s [[Set]] attribute.
-    if (X->HasSetter()) {
-      D.SetSetter(X->AsAccessorPropertyDescriptor()->GetSetter());
-    }
+    D.SetSetter(accessor->GetSetter());
   }
 
   // 6. Set D.[[Enumerable]] to the value of X’s [[Enumerable]] attribute.
-  if (X->HasEnumerable()) {
-    D.SetEnumerable(X->GetEnumerable());
-  }
+  D.SetEnumerable(PropertyMap::IsEnumerable(attributes));
 
   // 7. Set D.[[Configurable]] to the value of X’s [[Configurable]] attribute.
-  if (X->HasConfigurable()) {
-    D.SetConfigurable(X->GetConfigurable());
-  }
+  D.SetConfigurable(PropertyMap::IsConfigurable(attributes));
 
   // 8. Return D.
   return D;
@@ -116,11 +205,14 @@ PropertyDescriptor Object::GetProperty(VM* vm, JSHandle<Object> O, JSHandle<Stri
 
 // only used for forwarding
 JSHandle<JSValue> Object::Get(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
-  if (O->IsJSFunction()) {
-    return builtins::JSFunction::Get(vm, O.As<builtins::JSFunction>(), P);
-  } else {
+  if (auto value = GetFast(vm, O, P); !value.IsEmpty()) {
+    return value;
+  }
+  
+  if (O->IsOrdinary()) {
     return GetDefault(vm, O, P);
   }
+  return GetInternalMethods(O.GetObject()).get(vm, O, P);
 }
 
 // Get
@@ -208,6 +300,10 @@ bool Object::CanPut(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
 // Put
 // Defined in ECMAScript 5.1 Chapter 8.12.5
 void Object::Put(VM* vm, JSHandle<Object> O, JSHandle<String> P, JSHandle<JSValue> V, bool Throw) {
+  if (PutFast(vm, O, P, V)) {
+    return ;
+  }
+  
   // 1. If the result of calling the [[CanPut]] internal method of O with argument P is false, then
   if (!CanPut(vm, O, P)) {
     // a. If Throw is true, then throw a TypeError exception.
@@ -273,9 +369,17 @@ bool Object::HasProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
   return !desc.IsEmpty();
 }
 
+// only used for forwarding
+bool Object::Delete(VM* vm, JSHandle<Object> O, JSHandle<String> P, bool Throw) {
+  if (O->IsOrdinary()) {
+    return DeleteDefault(vm, O, P, Throw);
+  }
+  return GetInternalMethods(O.GetObject()).delete_(vm, O, P, Throw);
+}
+
 // Delete
 // Defined in ECMAScript 5.1 Chapter 8.12.7
-bool Object::Delete(VM* vm, JSHandle<Object> O, JSHandle<String> P, bool Throw) {
+bool Object::DeleteDefault(VM* vm, JSHandle<Object> O, JSHandle<String> P, bool Throw) {
   // 1. Let desc be the result of calling the [[GetOwnProperty]] internal method of O with property name P.
   auto desc = GetOwnProperty(vm, O, P);
 
@@ -287,7 +391,8 @@ bool Object::Delete(VM* vm, JSHandle<Object> O, JSHandle<String> P, bool Throw)
   // 3. If desc.[[Configurable]] is true, then
   if (desc.GetConfigurable()) {
     // a. Remove the own property with name P from O.
-    O->GetProperties().GetHeapObject()->AsPropertyMap()->DeleteProperty(vm, P);
+    auto prop_map = JSHandle<PropertyMap>{vm, O->GetProperties()};
+    O->SetProperties(PropertyMap::DeleteProperty(vm, prop_map, P).As<JSValue>());
 
     // b. Return true.
     return true;
@@ -380,11 +485,10 @@ JSHandle<JSValue> Object::DefaultValue(VM* vm, JSHandle<Object> O, PreferredType
 
 // only used to forward
 bool Object::DefineOwnProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P, const PropertyDescriptor& Desc, bool Throw) {
-  if (O->IsJSArray()) {
-    return builtins::JSArray::DefineOwnProperty(vm, O, P, Desc, Throw);
-  } else {
+  if (O->IsOrdinary()) {
     return DefineOwnPropertyDefault(vm, O, P, Desc, Throw);
   }
+  return GetInternalMethods(O.GetObject()).define_own_property(vm, O, P, Desc, Throw);
 }
 
 // DefineOwnProperty
@@ -620,133 +724,242 @@ bool Object::DefineOwnPropertyDefault(VM* vm, JSHandle<Object> O, JSHandle<Strin
   return true;
 }
 
-// Construct
-// Only used for forwarding to concrete [[Construct]]
-JSHandle<JSValue> Object::Construct(VM* vm, JSHandle<Object> O, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args) {
-  RuntimeCallInfo* info = RuntimeCallInfo::New(vm, this_arg, args);
+namespace {
 
-  JSValue ret;
+using CallEntry = JSHandle<JSValue> (*)(
+  VM* vm, JSHandle<Object> O, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args);
+
+JSHandle<JSValue> CallNothing(
+  VM* vm, JSHandle<Object> /*O*/, JSHandle<JSValue> /*this_arg*/, const std::vector<JSHandle<JSValue>>& /*args*/) {
+  return JSHandle<JSValue>{vm, JSValue{}};
+}
+
+// Define in ECMAScript 5.1 Chapter 13.2.1
+JSHandle<JSValue> CallJSFunction(
+  VM* vm, JSHandle<Object> O, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args) {
+  // JSHandleScope handle_scope{vm};
   
-  if (O.GetJSValue() == vm->GetObjectConstructor().GetJSValue()) {
-    ret = builtins::JSObject::ObjectConstructorConstruct(info);
-  } else if (O.GetJSValue() == vm->GetFunctionConstructor().GetJSValue()) {
-    ret = builtins::JSFunction::FunctionConstructorConstruct(info);
-  } else if (O.GetJSValue() == vm->GetArrayConstructor().GetJSValue()) {
-    ret = builtins::JSArray::ArrayConstructorConstruct(info);
-  } else if (O.GetJSValue() == vm->GetStringConstructor().GetJSValue()) {
-    ret = builtins::JSString::StringConstructorConstruct(info);
-  } else if (O.GetJSValue() == vm->GetBooleanConstructor().GetJSValue()) {
-    ret = builtins::JSBoolean::BooleanConstructorConstruct(info);
-  } else if (O.GetJSValue() == vm->GetNumberConstructor().GetJSValue()) {
-    ret = builtins::JSNumber::NumberConstructorConstruct(info);
-  } else if (O.GetJSValue() == vm->GetErrorConstructor().GetJSValue()) {
-    ret = builtins::JSError::ErrorConstructorConstruct(info);
-  }
-  // Define in ECMAScript 5.1 Chapter 13.2.2
-  else if (O->IsJSFunction()) {
-    // JSHandleScope handle_scope{vm};
-    auto F = O.As<builtins::JSFunction>();
-    ObjectFactory* factory = vm->GetObjectFactory();
-    
-    // 1. Let obj be a newly created native ECMAScript object.
-    // 2. Set all the internal methods of obj as specified in 8.12.
-    // 3. Set the [[Class]] internal property of obj to "Object".
-    // 4. Set the [[Extensible]] internal property of obj to true.
-    // 5. Let proto be the value of calling the [[Get]] internal property of F with argument "prototype".
-    // 6. If Type(proto) is Object, set the [[Prototype]] internal property of obj to proto.
-    // 7. If Type(proto) is not Object, set the [[Prototype]] internal property of obj to the standard built-in Object prototype object as described in 15.2.4.
-    JSHandle<JSValue> proto = Get(vm, F, vm->GetGlobalConstants()->HandledPrototypeString());
-    JSHandle<builtins::JSObject> obj = factory->NewObject(
-      builtins::JSObject::SIZE, JSType::JS_OBJECT, ObjectClassType::OBJECT,
-      proto->IsObject() ? proto : vm->GetObjectPrototype().As<JSValue>(), true, false, false).As<builtins::JSObject>();
-    
-    // 8. Let result be the result of calling the [[Call]] internal property of F,
-    //    providing obj as the this value and providing the argument list passed into [[Construct]] as args.
-    JSHandle<JSValue> result = Call(vm, F, obj.As<JSValue>(), args);
-    
-    // 9. If Type(result) is Object then return result.
-    if (result->IsObject()) {
-      return result;
-    }
-    
-    // 10. Return obj.
-    return obj.As<JSValue>();
+  auto F = O.As<builtins::JSFunction>();
+  auto code = F->GetCode();
+
+  // The body of a lazily parsed function is parsed on its first call
+  try {
+    Parser::ParseLazyFunction(code);
+  } catch (const utils::Error& error) {
+    THROW_SYNTAX_ERROR_AND_RETURN_HANDLE(vm, u"Invalid function body", JSValue);
   }
+  
+  // 1. - 6. are shared with the calls through a CallSiteCache or a PreparedCall
+  if (code->IsFunctionDeclaration()) {
+    auto func = code->AsFunctionDeclaration();
+    return vm->GetInterpreter()->CallFunctionCode(
+      F, code, func->GetStatements(), func->IsStrict(), func->GetFrameSlotNum(), this_arg, args);
+  } else {
+    // code must be FunctionExpression
+    auto func = code->AsFunctionExpression();
+    return vm->GetInterpreter()->CallFunctionCode(
+      F, code, func->GetStatements(), func->IsStrict(), func->GetFrameSlotNum(), this_arg, args);
+  }
+}
 
+// Define in ECMAScript 5.1 Chapter 13.2.2
+JSHandle<JSValue> ConstructJSFunction(
+  VM* vm, JSHandle<Object> O, JSHandle<JSValue> /*this_arg*/, const std::vector<JSHandle<JSValue>>& args) {
+  // JSHandleScope handle_scope{vm};
+  auto F = O.As<builtins::JSFunction>();
+  ObjectFactory* factory = vm->GetObjectFactory();
+  
+  // 1. Let obj be a newly created native ECMAScript object.
+  // 2. Set all the internal methods of obj as specified in 8.12.
+  // 3. Set the [[Class]] internal property of obj to "Object".
+  // 4. Set the [[Extensible]] internal property of obj to true.
+  // 5. Let proto be the value of calling the [[Get]] internal property of F with argument "prototype".
+  // 6. If Type(proto) is Object, set the [[Prototype]] internal property of obj to proto.
+  // 7. If Type(proto) is not Object, set the [[Prototype]] internal property of obj to the standard built-in Object prototype object as described in 15.2.4.
+  JSHandle<JSValue> proto = Object::Get(vm, F, vm->GetGlobalConstants()->HandledPrototypeString());
+  JSHandle<builtins::JSObject> obj = factory->NewObject(
+    builtins::JSObject::SIZE, JSType::JS_OBJECT, ObjectClassType::OBJECT,
+    proto->IsObject() ? proto : vm->GetObjectPrototype().As<JSValue>(), true, false, false).As<builtins::JSObject>();
+  
+  // 8. Let result be the result of calling the [[Call]] internal property of F,
+  //    providing obj as the this value and providing the argument list passed into [[Construct]] as args.
+  JSHandle<JSValue> result = CallJSFunction(vm, F, obj.As<JSValue>(), args);
+  
+  // 9. If Type(result) is Object then return result.
+  if (result->IsObject()) {
+    return result;
+  }
+  
+  // 10. Return obj.
+  return obj.As<JSValue>();
+}
+
+JSHandle<JSValue> CallInternalFunction(
+  VM* vm, JSHandle<Object> O, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args) {
+  RuntimeCallInfo* info = RuntimeCallInfo::New(vm, this_arg, args);
+  JSValue ret = O->AsInternalFunction()->GetFunction()(info);
   RuntimeCallInfo::Delete(info);
+  return JSHandle<JSValue>{vm, ret};
+}
 
+// The [[Call]] or [[Construct]] of a builtin constructor
+template <JSValue (*Native)(RuntimeCallInfo*)>
+JSHandle<JSValue> CallNative(
+  VM* vm, JSHandle<Object> /*O*/, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args) {
+  RuntimeCallInfo* info = RuntimeCallInfo::New(vm, this_arg, args);
+  JSValue ret = Native(info);
+  RuntimeCallInfo::Delete(info);
   return JSHandle<JSValue>{vm, ret};
 }
 
+// Defined in ECMAScript 5.1 Chapter 15.3.4.5.1, the this value passed in is replaced by boundThis
+JSHandle<JSValue> CallBoundFunction(
+  VM* vm, JSHandle<Object> O, JSHandle<JSValue> /*this_arg*/, const std::vector<JSHandle<JSValue>>& args) {
+  return builtins::BoundFunction::Call(vm, O.As<builtins::BoundFunction>(), args);
+}
+
+// Defined in ECMAScript 5.1 Chapter 15.3.4.5.2
+JSHandle<JSValue> ConstructBoundFunction(
+  VM* vm, JSHandle<Object> O, JSHandle<JSValue> /*this_arg*/, const std::vector<JSHandle<JSValue>>& args) {
+  return builtins::BoundFunction::Construct(vm, O.As<builtins::BoundFunction>(), args);
+}
+
+// Indexed by CallKind
+constexpr CallEntry CALL_ENTRIES[] = {
+  CallNothing,
+  CallJSFunction,
+  CallInternalFunction,
+  CallNative<builtins::JSObject::ObjectConstructorCall>,
+  CallNative<builtins::JSFunction::FunctionConstructorCall>,
+  CallNative<builtins::JSArray::ArrayConstructorCall>,
+  CallNative<builtins::JSString::StringConstructorCall>,
+  CallNative<builtins::JSBoolean::BooleanConstructorCall>,
+  CallNative<builtins::JSNumber::NumberConstructorCall>,
+  CallNative<builtins::JSError::ErrorConstructorCall>,
+  CallBoundFunction,
+};
+
+constexpr CallEntry CONSTRUCT_ENTRIES[] = {
+  CallNothing,
+  ConstructJSFunction,
+  CallNothing,
+  CallNative<builtins::JSObject::ObjectConstructorConstruct>,
+  CallNative<builtins::JSFunction::FunctionConstructorConstruct>,
+  CallNative<builtins::JSArray::ArrayConstructorConstruct>,
+  CallNative<builtins::JSString::StringConstructorConstruct>,
+  CallNative<builtins::JSBoolean::BooleanConstructorConstruct>,
+  CallNative<builtins::JSNumber::NumberConstructorConstruct>,
+  CallNative<builtins::JSError::ErrorConstructorConstruct>,
+  ConstructBoundFunction,
+};
+
+static_assert(std::size(CALL_ENTRIES) == static_cast<std::size_t>(CallKind::CALL_KIND_NUM));
+static_assert(std::size(CONSTRUCT_ENTRIES) == static_cast<std::size_t>(CallKind::CALL_KIND_NUM));
+
+}  // namespace
+
+// Construct
+// Only used for forwarding to concrete [[Construct]], selected by the CallKind of O
+JSHandle<JSValue> Object::Construct(VM* vm, JSHandle<Object> O, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args) {
+  return CONSTRUCT_ENTRIES[static_cast<std::size_t>(O->GetCallKind())](vm, O, this_arg, args);
+}
+
 // Call
-// Only used for forwarding to concrete [[Call]]
+// Only used for forwarding to concrete [[Call]], selected by the CallKind of O
 JSHandle<JSValue> Object::Call(VM* vm, JSHandle<Object> O, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args) {
-  RuntimeCallInfo* info = RuntimeCallInfo::New(vm, this_arg, args);
+  return CALL_ENTRIES[static_cast<std::size_t>(O->GetCallKind())](vm, O, this_arg, args);
+}
 
-  JSValue ret;
+// GetFast
+// Equivalent to [[Get]] when P resolves to a data property,
+// each object on the prototype chain costs a single probe of its PropertyMap.
+// Returns an empty handle for accessors and exotic objects.
+JSHandle<JSValue> Object::GetFast(VM* vm, JSHandle<Object> O, JSHandle<String> P) {
+  // JSFunction has its own [[Get]]
+  if (!O->IsOrdinary() && O->IsJSFunction()) {
+    return {};
+  }
   
-  if (O.GetJSValue() == vm->GetObjectConstructor().GetJSValue()) {
-    ret = builtins::JSObject::ObjectConstructorCall(info);
-  } else if (O.GetJSValue() == vm->GetFunctionConstructor().GetJSValue()) {
-    ret = builtins::JSFunction::FunctionConstructorCall(info);
-  } else if (O.GetJSValue() == vm->GetArrayConstructor().GetJSValue()) {
-    ret = builtins::JSArray::ArrayConstructorCall(info);
-  } else if (O.GetJSValue() == vm->GetStringConstructor().GetJSValue()) {
-    ret = builtins::JSString::StringConstructorCall(info);
-  } else if (O.GetJSValue() == vm->GetBooleanConstructor().GetJSValue()) {
-    ret = builtins::JSBoolean::BooleanConstructorCall(info);
-  } else if (O.GetJSValue() == vm->GetNumberConstructor().GetJSValue()) {
-    ret = builtins::JSNumber::NumberConstructorCall(info);
-  } else if (O.GetJSValue() == vm->GetErrorConstructor().GetJSValue()) {
-    ret = builtins::JSError::ErrorConstructorCall(info);
-  }
-  // Define in ECMAScript 5.1 Chapter 13.2.1
-  else if (O->IsJSFunction()) {
-    // JSHandleScope handle_scope{vm};
-    
-    auto F = O.As<builtins::JSFunction>();
-    // 1. Let funcCtx be the result of establishing a new execution context for function code
-    //    using the value of F's [[FormalParameters]] internal property,
-    //    the passed arguments List args, and the this value as described in 10.4.3.
-    ExecutionContext::EnterFunctionCode(vm, F->GetCode(), F, this_arg, args);
-    RETURN_HANDLE_IF_HAS_EXCEPTION(vm, JSValue);
-    
-    // 2. Let result be the result of evaluating the FunctionBody that is the value of F's [[Code]] internal property.
-    //    If F does not have a [[Code]] internal property or if its value is an empty FunctionBody,
-    //    then result is (normal, undefined, empty).
-    const auto& stmts = std::invoke([=]() {
-      auto ast_node = F->GetCode();
-      if (ast_node->AsFunctionDeclaration()) {
-        return ast_node->AsFunctionDeclaration()->GetStatements();
-      } else {
-        // ast_node must be FunctionExpression
-        return ast_node->AsFunctionExpression()->GetStatements();
+  for (auto obj = O.GetObject(); ; ) {
+    // JSString and mapped Arguments have their own [[GetOwnProperty]]
+    if (!obj->IsOrdinary() && (obj->IsJSString() || obj->IsArguments())) {
+      return {};
+    }
+
+    auto props = obj->GetProperties().GetHeapObject()->AsPropertyMap();
+    auto entry = props->FindProperty(P);
+    if (entry != PropertyMap::NOT_FOUND) {
+      if (PropertyMap::IsAccessor(props->GetPropertyAttributes(entry))) {
+        return {};
       }
-    });
-    auto result = stmts.empty() ? Completion{} : vm->GetInterpreter()->EvalSourceElements(stmts);
-    
-    // 3. Exit the execution context funcCtx, restoring the previous execution context.
-    vm->PopExecutionContext();
-    
-    // 4. If result.type is throw then throw result.value.
-    RETURN_HANDLE_IF_HAS_EXCEPTION(vm, JSValue);
-    
-    // 5. If result.type is return then return result.value.
-    if (result.GetType() == CompletionType::RETURN) {
-      return result.GetValue();
+      return JSHandle<JSValue>{vm, props->GetPropertyValue(vm, entry)};
     }
-    // 6. Otherwise result.type must be normal. Return undefined.
-    else {
+
+    auto proto = obj->GetPrototype();
+    if (proto.IsNull()) {
       return JSHandle<JSValue>{vm, JSValue::Undefined()};
     }
-  } else if (O->IsInternalFunction()) {
-    auto func = O->AsInternalFunction()->GetFunction();
-    ret = func(info);
+    obj = proto.GetHeapObject()->AsObject();
   }
+}
 
-  RuntimeCallInfo::Delete(info);
+// PutFast
+// Equivalent to [[Put]] when P is an own writable data property of O,
+// or when P is absent from O and the prototype chain doesn't forbid creating it.
+// Returns false for accessors, non-writable properties and exotic objects.
+bool Object::PutFast(VM* vm, JSHandle<Object> O, JSHandle<String> P, JSHandle<JSValue> V) {
+  // JSString and mapped Arguments have their own [[GetOwnProperty]]
+  if (!O->IsOrdinary() && (O->IsJSString() || O->IsArguments())) {
+    return false;
+  }
+  
+  auto props = O->GetProperties().GetHeapObject()->AsPropertyMap();
+  auto entry = props->FindProperty(P);
 
-  return JSHandle<JSValue>{vm, ret};
+  // The value of an own writable data property is replaced in place,
+  // except for length of JSArray, whose [[DefineOwnProperty]] may delete elements.
+  if (entry != PropertyMap::NOT_FOUND) {
+    auto attributes = props->GetPropertyAttributes(entry);
+    if (PropertyMap::IsAccessor(attributes) || !PropertyMap::IsWritable(attributes)) {
+      return false;
+    }
+    if (O->IsJSArray() && P->Equal(vm->GetGlobalConstants()->HandledLengthString())) {
+      return false;
+    }
+    props->SetPropertyValue(entry, V.GetJSValue());
+    return true;
+  }
+
+  // Adding an element to JSArray may update its length
+  if (O->IsJSArray() || !O->GetExtensible()) {
+    return false;
+  }
+
+  // An inherited accessor or non-writable property takes precedence over creating an own property
+  for (auto proto = O->GetPrototype(); !proto.IsNull(); ) {
+    auto obj = proto.GetHeapObject()->AsObject();
+    if (!obj->IsOrdinary() && (obj->IsJSString() || obj->IsArguments())) {
+      return false;
+    }
+    
+    auto proto_props = obj->GetProperties().GetHeapObject()->AsPropertyMap();
+    auto proto_entry = proto_props->FindProperty(P);
+    if (proto_entry != PropertyMap::NOT_FOUND) {
+      auto attributes = proto_props->GetPropertyAttributes(proto_entry);
+      if (PropertyMap::IsAccessor(attributes) || !PropertyMap::IsWritable(attributes)) {
+        return false;
+      }
+      break;
+    }
+    
+    proto = obj->GetPrototype();
+  }
+
+  auto prop_map = JSHandle<PropertyMap>{vm, O->GetProperties()};
+  O->SetProperties(PropertyMap::Insert(
+    vm, prop_map, P, V, PropertyMap::WRITABLE | PropertyMap::ENUMERABLE | PropertyMap::CONFIGURABLE).As<JSValue>());
+  
+  return true;
 }
 
 std::vector<JSHandle<JSValue>> Object::GetAllEnumerableKeys(VM* vm, JSHandle<Object> O) {
@@ -43,6 +43,7 @@ class Object : public HeapObject {
   static void Put(VM* vm, JSHandle<Object> O, JSHandle<String> P, JSHandle<JSValue> V, bool Throw);
   static bool HasProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P);
   static bool Delete(VM* vm, JSHandle<Object> O, JSHandle<String> P, bool Throw);
+  static bool DeleteDefault(VM* vm, JSHandle<Object> O, JSHandle<String> P, bool Throw);
   static JSHandle<JSValue> DefaultValue(VM* vm, JSHandle<Object> O, PreferredType hint);
   static bool DefineOwnProperty(VM* vm, JSHandle<Object> O, JSHandle<String> P, const PropertyDescriptor& Desc, bool Throw);
   static bool DefineOwnPropertyDefault(VM* vm, JSHandle<Object> O, JSHandle<String> P, const PropertyDescriptor& Desc, bool Throw);
@@ -53,6 +54,19 @@ class Object : public HeapObject {
   static JSHandle<JSValue> Call(VM* vm, JSHandle<Object> O, JSHandle<JSValue> this_arg, const std::vector<JSHandle<JSValue>>& args);
 
   static std::vector<JSHandle<JSValue>> GetAllEnumerableKeys(VM* vm, JSHandle<Object> O);
+
+  // Whether objects of type only have the default internal methods of 8.12,
+  // which is what their ordinary bit starts with.
+  // Arguments become exotic once their [[ParameterMap]] is set (10.6).
+  static constexpr bool HasOrdinaryMethods(JSType type) {
+    return type != JSType::JS_FUNCTION && type != JSType::JS_ARRAY && type != JSType::JS_STRING;
+  }
+
+ private:
+  // Fast paths of [[Get]] and [[Put]] which read and write PropertyMap entries directly,
+  // they give up (return an empty handle or false) whenever the spec steps are needed.
+  static JSHandle<JSValue> GetFast(VM* vm, JSHandle<Object> O, JSHandle<String> P);
+  static bool PutFast(VM* vm, JSHandle<Object> O, JSHandle<String> P, JSHandle<JSValue> V);
 };
 
 }  // namespace types
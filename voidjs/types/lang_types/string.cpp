@@ -1,23 +1,24 @@
 #include "voidjs/types/lang_types/string.h"
 
 #include "voidjs/types/object_factory.h"
+#include "voidjs/types/lang_types/string_builder.h"
 
 namespace voidjs {
 namespace types {
 
 JSHandle<String> String::Concat(VM* vm, JSHandle<String> str1, JSHandle<String> str2) {
-  std::u16string str;
-  str += str1->GetString();
-  str += str2->GetString();
-  return vm->GetObjectFactory()->NewString(str);
+  StringBuilder builder{vm, str1->GetLength() + str2->GetLength()};
+  builder.Append(str1);
+  builder.Append(str2);
+  return builder.Build();
 }
 
 JSHandle<String> String::Concat(VM* vm, JSHandle<String> str1, JSHandle<String> str2, JSHandle<String> str3) {
-  std::u16string str;
-  str += str1->GetString();
-  str += str2->GetString();
-  str += str3->GetString();
-  return vm->GetObjectFactory()->NewString(str);
+  StringBuilder builder{vm, str1->GetLength() + str2->GetLength() + str3->GetLength()};
+  builder.Append(str1);
+  builder.Append(str2);
+  builder.Append(str3);
+  return builder.Build();
 }
 
 JSHandle<String> String::Substring(VM* vm, JSHandle<String> string, std::size_t start, std::size_t length) {
@@ -25,7 +26,7 @@ JSHandle<String> String::Substring(VM* vm, JSHandle<String> string, std::size_t
 }
 
 JSHandle<String> String::CharAt(VM* vm, JSHandle<String> string, std::size_t pos) {
-  return vm->GetObjectFactory()->NewString(string->GetString().substr(pos, 1));
+  return vm->GetObjectFactory()->NewStringFromChar(string->Get(pos));
 }
 
 
@@ -0,0 +1,58 @@
+#include "voidjs/types/lang_types/string_builder.h"
+
+#include <algorithm>
+
+#include "voidjs/types/object_factory.h"
+#include "voidjs/interpreter/global_constants.h"
+
+namespace voidjs {
+namespace types {
+
+StringBuilder::StringBuilder(VM* vm, std::size_t capacity)
+  : vm_(vm) {
+  Reserve(capacity);
+}
+
+void StringBuilder::Reserve(std::size_t capacity) {
+  if (capacity <= capacity_) {
+    return ;
+  }
+
+  auto buffer = vm_->GetObjectFactory()->NewRawString(capacity);
+  if (length_ > 0) {
+    std::copy_n(buffer_->GetData(), length_, buffer->GetData());
+  }
+  buffer_ = buffer;
+  capacity_ = capacity;
+}
+
+void StringBuilder::Append(JSHandle<String> str) {
+  // Growing the buffer may move str, so its characters are only read afterwards
+  std::size_t len = str->GetLength();
+  if (length_ + len > capacity_) {
+    Reserve(std::max(length_ + len, capacity_ << 1));
+  }
+  Append(str->GetString());
+}
+
+void StringBuilder::Append(std::u16string_view str) {
+  if (length_ + str.size() > capacity_) {
+    Reserve(std::max(length_ + str.size(), capacity_ << 1));
+  }
+  std::copy(str.begin(), str.end(), buffer_->GetData() + length_);
+  length_ += str.size();
+}
+
+JSHandle<String> StringBuilder::Build() {
+  if (length_ == 0) {
+    return vm_->GetGlobalConstants()->HandledEmptyString();
+  }
+  
+  // The unused tail of the buffer is simply dropped,
+  // since the size of a String is computed from its length.
+  buffer_->SetLength(length_);
+  return buffer_;
+}
+
+}  // namespace types
+}  // namespace voidjs
@@ -0,0 +1,43 @@
+#ifndef VOIDJS_TYPES_LANG_TYPES_STRING_BUILDER_H
+#define VOIDJS_TYPES_LANG_TYPES_STRING_BUILDER_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "voidjs/types/lang_types/string.h"
+#include "voidjs/gc/js_handle.h"
+#include "voidjs/interpreter/vm.h"
+
+namespace voidjs {
+namespace types {
+
+// StringBuilder writes characters directly into a heap String.
+// When the total length is known in advance, Reserve it
+// and the result is built with a single allocation,
+// otherwise the buffer grows geometrically.
+class StringBuilder {
+ public:
+  explicit StringBuilder(VM* vm, std::size_t capacity = 0);
+
+  void Reserve(std::size_t capacity);
+  
+  void Append(JSHandle<String> str);
+  void Append(std::u16string_view str);
+  void Append(char16_t ch) { Append(std::u16string_view{&ch, 1}); }
+
+  std::size_t GetLength() const { return length_; }
+
+  // The builder must not be used after Build
+  JSHandle<String> Build();
+
+ private:
+  VM* vm_;
+  JSHandle<String> buffer_;
+  std::size_t length_ {0};
+  std::size_t capacity_ {0};
+};
+
+}  // namespace types
+}  // namespace voidjs
+
+#endif  // VOIDJS_TYPES_LANG_TYPES_STRING_BUILDER_H
@@ -21,6 +21,7 @@
 #include "voidjs/gc/js_handle.h"
 #include "voidjs/interpreter/runtime_call_info.h"
 #include "voidjs/interpreter/string_table.h"
+#include "voidjs/interpreter/global_constants.h"
 
 namespace voidjs {
 
@@ -37,10 +38,27 @@ JSHandle<types::Object> ObjectFactory::NewEmptyObject(
 }
 
 
+JSHandle<types::String> ObjectFactory::NewRawString(std::size_t len) {
+  auto str = NewHeapObject(sizeof(std::size_t) + len * sizeof(char16_t)).As<types::String>();
+  str->SetType(JSType::STRING);
+  str->SetLength(len);
+  return str;
+}
+
 JSHandle<types::String> ObjectFactory::NewStringFromInt(std::int32_t i) {
+  if (GlobalConstants::HasSmallIntegerString(i)) {
+    return vm_->GetGlobalConstants()->HandledSmallIntegerString(i);
+  }
   return JSValue::NumberToString(vm_, i);
 }
 
+JSHandle<types::String> ObjectFactory::NewStringFromChar(char16_t ch) {
+  if (GlobalConstants::HasSingleCharacterString(ch)) {
+    return vm_->GetGlobalConstants()->HandledSingleCharacterString(ch);
+  }
+  return NewString(std::u16string_view{&ch, 1});
+}
+
 JSHandle<types::Array> ObjectFactory::NewArray(std::size_t len) {
   auto arr = NewHeapObject(sizeof(std::size_t) + len * sizeof(JSValue)).As<types::Array>();
   arr->SetType(JSType::ARRAY);
@@ -112,23 +130,30 @@ JSHandle<types::Binding> ObjectFactory::NewBinding(JSHandle<JSValue> value, bool
 JSHandle<types::InternalFunction> ObjectFactory::NewInternalFunction(InternalFunctionType func) {
   auto internal_func = NewObject(types::InternalFunction::SIZE, JSType::INTERNAL_FUNCTION, ObjectClassType::FUNCTION,
                                  vm_->GetFunctionPrototype().As<JSValue>(), true, true, false).As<types::InternalFunction>();
+  internal_func->SetCallKind(CallKind::INTERNAL_FUNCTION);
   internal_func->SetFunction(func);
   return internal_func;
 }
 
 
 JSHandle<types::HashMap> ObjectFactory::NewHashMap(std::uint32_t capacity) {
-  auto hashmap = NewArray(types::HashMap::HEADER_SIZE + types::HashMap::ENTRY_SIZE * capacity).As<types::HashMap>();
+  auto hashmap = NewArray(types::HashMap::GetTotalLength(capacity)).As<types::HashMap>();
   hashmap->SetType(JSType::HASH_MAP);
   hashmap->SetBucketCapacity(capacity);
   hashmap->SetBucketSize(0);
+  hashmap->SetTombstoneSize(0);
+  hashmap->InitializeCtrl();
   return hashmap;
 }
 
 JSHandle<types::DeclarativeEnvironmentRecord> ObjectFactory::NewDeclarativeEnvironmentRecord() {
+  return NewDeclarativeEnvironmentRecord(types::HashMap::MIN_CAPACITY);
+}
+
+JSHandle<types::DeclarativeEnvironmentRecord> ObjectFactory::NewDeclarativeEnvironmentRecord(std::uint32_t binding_capacity) {
   auto env_rec = NewHeapObject(types::DeclarativeEnvironmentRecord::SIZE).As<types::DeclarativeEnvironmentRecord>();
   env_rec->SetType(JSType::DECLARATIVE_ENVIRONMENT_RECORD);
-  env_rec->SetBindingMap(NewHashMap(types::HashMap::MIN_CAPACITY).As<JSValue>());
+  env_rec->SetBindingMap(NewHashMap(binding_capacity).As<JSValue>());
   return env_rec;
 }
 
@@ -27,6 +27,8 @@ class ObjectFactory {
   {}
 
   ~ObjectFactory();
+
+  Heap* GetHeap() const { return heap_; }
   
   template <GCFlag flag = GCFlag::NORMAL> 
   std::uintptr_t Allocate(std::size_t size) {
@@ -37,7 +39,7 @@ class ObjectFactory {
 
   template <GCFlag flag = GCFlag::NORMAL>
   JSHandle<HeapObject> NewHeapObject(std::size_t size) {
-    auto obj = reinterpret_cast<HeapObject*>(Allocate(HeapObject::SIZE + size));
+    auto obj = reinterpret_cast<HeapObject*>(Allocate<flag>(HeapObject::SIZE + size));
     obj->SetMetaData(0);
     return JSHandle<HeapObject>(vm_, obj);
   }
@@ -50,13 +52,16 @@ class ObjectFactory {
   template <GCFlag flag = GCFlag::NORMAL>
   JSHandle<types::String> NewString(std::u16string_view source) {
     auto len = source.size();
-    auto str = NewHeapObject(sizeof(std::size_t) + len * sizeof(char16_t)).As<types::String>();
+    auto str = NewHeapObject<flag>(sizeof(std::size_t) + len * sizeof(char16_t)).template As<types::String>();
     str->SetType(JSType::STRING);
     str->SetLength(len);
     std::copy(source.begin(), source.end(), str->GetData());
     return str;
   }
+  // Allocate a String of given length whose characters are left to the caller
+  JSHandle<types::String> NewRawString(std::size_t len);
   JSHandle<types::String> NewStringFromInt(std::int32_t i);
+  JSHandle<types::String> NewStringFromChar(char16_t ch);
 
   template <GCFlag flag = GCFlag::NORMAL>
   JSHandle<types::Object> NewObject(
@@ -71,6 +76,7 @@ class ObjectFactory {
     obj->SetExtensible(extensible);
     obj->SetCallable(callable);
     obj->SetIsConstructor(is_counstructor);
+    obj->SetOrdinary(types::Object::HasOrdinaryMethods(type));
   
     return obj;
   }
@@ -84,6 +90,7 @@ class ObjectFactory {
   JSHandle<types::HashMap> NewHashMap(std::uint32_t capacity);
   JSHandle<types::EnvironmentRecord> NewEnvironmentRecord();
   JSHandle<types::DeclarativeEnvironmentRecord> NewDeclarativeEnvironmentRecord();
+  JSHandle<types::DeclarativeEnvironmentRecord> NewDeclarativeEnvironmentRecord(std::uint32_t binding_capacity);
   JSHandle<types::ObjectEnvironmentRecord> NewObjectEnvironmentRecord(JSHandle<types::Object> obj);
   JSHandle<types::LexicalEnvironment> NewLexicalEnvironment(
     JSHandle<types::LexicalEnvironment> outer, JSHandle<types::EnvironmentRecord> env_rec);
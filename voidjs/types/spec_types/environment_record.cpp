@@ -1,6 +1,9 @@
 #include "voidjs/types/spec_types/environment_record.h"
 
+#include <array>
+#include <cstddef>
 #include <iostream>
+#include <utility>
 
 #include "voidjs/types/heap_object.h"
 #include "voidjs/types/js_value.h"
@@ -13,71 +16,103 @@
 namespace voidjs {
 namespace types {
 
+namespace {
+
+// The concrete methods of an EnvironmentRecord
+struct EnvironmentRecordMethodTable {
+  bool (*has_binding)(VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N);
+  void (*create_mutable_binding)(VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N, bool D);
+  void (*set_mutable_binding)(VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N, JSHandle<JSValue> V, bool S);
+  JSHandle<JSValue> (*get_binding_value)(VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N, bool S);
+  bool (*delete_binding)(VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N);
+  JSHandle<JSValue> (*implicit_this_value)(VM* vm, JSHandle<EnvironmentRecord> env);
+};
+
+template <typename T>
+constexpr EnvironmentRecordMethodTable MakeEnvironmentRecordMethodTable() {
+  return {
+    [](VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N) {
+      return T::HasBinding(vm, env.As<T>(), N);
+    },
+    [](VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N, bool D) {
+      T::CreateMutableBinding(vm, env.As<T>(), N, D);
+    },
+    [](VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N, JSHandle<JSValue> V, bool S) {
+      T::SetMutableBinding(vm, env.As<T>(), N, V, S);
+    },
+    [](VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N, bool S) {
+      return T::GetBindingValue(vm, env.As<T>(), N, S);
+    },
+    [](VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N) {
+      return T::DeleteBinding(vm, env.As<T>(), N);
+    },
+    [](VM* vm, JSHandle<EnvironmentRecord> env) {
+      return T::ImplicitThisValue(vm, env.As<T>());
+    },
+  };
+}
+
+// Only the entries of both kinds of EnvironmentRecord are ever used
+template <JSType type>
+constexpr EnvironmentRecordMethodTable GetEnvironmentRecordMethodTable() {
+  if constexpr (type == JSType::DECLARATIVE_ENVIRONMENT_RECORD) {
+    return MakeEnvironmentRecordMethodTable<DeclarativeEnvironmentRecord>();
+  } else if constexpr (type == JSType::OBJECT_ENVIRONMENT_RECORD) {
+    return MakeEnvironmentRecordMethodTable<ObjectEnvironmentRecord>();
+  } else {
+    return {};
+  }
+}
+
+template <std::size_t... I>
+constexpr std::array<EnvironmentRecordMethodTable, sizeof...(I)> MakeEnvironmentRecordMethodTables(std::index_sequence<I...>) {
+  return {GetEnvironmentRecordMethodTable<static_cast<JSType>(I)>()...};
+}
+
+// Indexed by JSType
+constexpr auto ENVIRONMENT_RECORD_METHODS =
+  MakeEnvironmentRecordMethodTables(std::make_index_sequence<static_cast<std::size_t>(JSType::JS_TYPE_NUM)>{});
+
+const EnvironmentRecordMethodTable& GetMethods(const EnvironmentRecord* env) {
+  return ENVIRONMENT_RECORD_METHODS[static_cast<std::size_t>(env->GetType())];
+}
+
+}  // namespace
+
 // HasBinding
 // Only used to forward to concrete method
 bool EnvironmentRecord::HasBinding(VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N) {
-  if (env->IsDeclarativeEnvironmentRecord()) {
-    return DeclarativeEnvironmentRecord::HasBinding(vm, env.As<DeclarativeEnvironmentRecord>(), N);
-  } else {
-    // env must be ObjectEnvironmentRecord
-    return ObjectEnvironmentRecord::HasBinding(vm, env.As<ObjectEnvironmentRecord>(), N);
-  }
+  return GetMethods(env.GetObject()).has_binding(vm, env, N);
 }
 
 // CreateMutableBinding
 // Only used to forward to concrete method
 void EnvironmentRecord::CreateMutableBinding(VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N, bool D) {
-  if (env->IsDeclarativeEnvironmentRecord()) {
-    DeclarativeEnvironmentRecord::CreateMutableBinding(vm, env.As<DeclarativeEnvironmentRecord>(), N, D);
-  } else {
-    // env must be ObjectEnvironmentRecord
-    ObjectEnvironmentRecord::CreateMutableBinding(vm, env.As<ObjectEnvironmentRecord>(), N, D);
-  }
+  GetMethods(env.GetObject()).create_mutable_binding(vm, env, N, D);
 }
 
 // SetMutableBinding
 // Only used to forward to concrete method
 void EnvironmentRecord::SetMutableBinding(VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N, JSHandle<JSValue> V, bool S) {
-  if (env->IsDeclarativeEnvironmentRecord()) {
-    DeclarativeEnvironmentRecord::SetMutableBinding(vm, env.As<DeclarativeEnvironmentRecord>(), N, V, S);
-    RETURN_VOID_IF_HAS_EXCEPTION(vm);
-  } else {
-    // env must be ObjectEnvironmentRecord
-    ObjectEnvironmentRecord::SetMutableBinding(vm, env.As<ObjectEnvironmentRecord>(), N, V, S);
-  }
+  GetMethods(env.GetObject()).set_mutable_binding(vm, env, N, V, S);
 }
 
 // GetBindingValue
 // Only used to forward to concrete method
 JSHandle<JSValue> EnvironmentRecord::GetBindingValue(VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N, bool S) {
-  if (env->IsDeclarativeEnvironmentRecord()) {
-    return DeclarativeEnvironmentRecord::GetBindingValue(vm, env.As<DeclarativeEnvironmentRecord>(), N, S);
-  } else {
-    // env must be ObjectEnvironmentRecord
-    return ObjectEnvironmentRecord::GetBindingValue(vm, env.As<ObjectEnvironmentRecord>(), N, S);
-  }
+  return GetMethods(env.GetObject()).get_binding_value(vm, env, N, S);
 }
 
 // DeleteBinding
 // Only used to forward to concrete method
 bool EnvironmentRecord::DeleteBinding(VM* vm, JSHandle<EnvironmentRecord> env, JSHandle<String> N) {
-  if (env->IsDeclarativeEnvironmentRecord()) {
-    return DeclarativeEnvironmentRecord::DeleteBinding(vm, env.As<DeclarativeEnvironmentRecord>(), N);
-  } else {
-    // env must be ObjectEnvironmentRecord
-    return ObjectEnvironmentRecord::DeleteBinding(vm, env.As<ObjectEnvironmentRecord>(), N);
-  }
+  return GetMethods(env.GetObject()).delete_binding(vm, env, N);
 }
 
 // ImplicitThisValue
 // Only used to forward to concrete method
 JSHandle<JSValue> EnvironmentRecord::ImplicitThisValue(VM* vm, JSHandle<EnvironmentRecord> env) {
-  if (env->IsDeclarativeEnvironmentRecord()) {
-    return DeclarativeEnvironmentRecord::ImplicitThisValue(vm, env.As<DeclarativeEnvironmentRecord>());
-  } else {
-    // env must be ObjectEnvironmentRecord
-    return ObjectEnvironmentRecord::ImplicitThisValue(vm, env.As<ObjectEnvironmentRecord>());
-  }
+  return GetMethods(env.GetObject()).implicit_this_value(vm, env);
 }
 
 // HasBinding
@@ -147,14 +182,14 @@ bool DeclarativeEnvironmentRecord::DeleteBinding(VM* vm, JSHandle<DeclarativeEnv
   // 3. If the binding for N in envRec is cannot be deleted, return false.
   // 4. Remove the binding for N from envRec.
   // 5. Return true.
-  auto binding_map = env->GetBindingMap().GetHeapObject()->AsHashMap();
+  auto binding_map = JSHandle<HashMap>{vm, env->GetBindingMap()};
   auto binding = binding_map->Find(vm, N).As<Binding>();
   
   if (!binding->GetDeletable()) {
     return false;
   }
 
-  binding_map->Erase(vm, N);
+  env->SetBindingMap(HashMap::Erase(vm, binding_map, N).As<JSValue>());
 
   return true;
 }
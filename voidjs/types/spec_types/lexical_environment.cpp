@@ -52,6 +52,13 @@ JSHandle<LexicalEnvironment> LexicalEnvironment::NewDeclarativeEnvironmentRecord
   return factory->NewLexicalEnvironment(E, env_rec);
 }
 
+JSHandle<LexicalEnvironment> LexicalEnvironment::NewDeclarativeEnvironmentRecord(
+  VM* vm, JSHandle<LexicalEnvironment> E, std::uint32_t binding_capacity) {
+  auto factory = vm->GetObjectFactory();
+  auto env_rec = factory->NewDeclarativeEnvironmentRecord(binding_capacity);
+  return factory->NewLexicalEnvironment(E, env_rec);
+}
+
 JSHandle<LexicalEnvironment> LexicalEnvironment::NewObjectEnvironmentRecord(VM* vm, JSHandle<JSValue> O, JSHandle<LexicalEnvironment> E) {
   auto factory = vm->GetObjectFactory();
   
@@ -25,6 +25,8 @@ class LexicalEnvironment : public HeapObject {
   
   static Reference GetIdentifierReference(VM* vm, JSHandle<LexicalEnvironment> lex, JSHandle<String> name, bool strict);
   static JSHandle<LexicalEnvironment> NewDeclarativeEnvironmentRecord(VM* vm, JSHandle<LexicalEnvironment> E);
+  // The binding map of envRec is allocated with binding_capacity, for code whose bindings are known up front
+  static JSHandle<LexicalEnvironment> NewDeclarativeEnvironmentRecord(VM* vm, JSHandle<LexicalEnvironment> E, std::uint32_t binding_capacity);
   static JSHandle<LexicalEnvironment> NewObjectEnvironmentRecord(VM* vm, JSHandle<JSValue> O, JSHandle<LexicalEnvironment> E);
 
   static constexpr std::size_t SIZE = sizeof(std::uintptr_t) + sizeof(std::uintptr_t);
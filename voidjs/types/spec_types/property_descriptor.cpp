@@ -55,20 +55,20 @@ JSHandle<JSValue> PropertyDescriptor::FromPropertyDescriptor() const {
       //    [[Configurable]]: true}, and false.
       Object::DefineOwnProperty(vm_, obj, vm_->GetGlobalConstants()->HandledSetString(),
                                 PropertyDescriptor{vm_, GetSetter(), true, true, true}, false);
-      
-      // 5. Call the [[DefineOwnProperty]] internal method of obj with arguments "enumerable",
-      //    Property Descriptor {[[Value]]: Desc.[[Enumerable]], [[Writable]]: true, [[Enumerable]]: true,
-      //    [[Configurable]]: true}, and false.
-      Object::DefineOwnProperty(vm_, obj, vm_->GetGlobalConstants()->HandledEnumerableString(),
-                                PropertyDescriptor{vm_, JSHandle<JSValue>{vm_, JSValue{GetEnumerable()}}, true, true, true}, false);
-      
-      // 6. Call the [[DefineOwnProperty]] internal method of obj with arguments "configurable",
-      //    Property Descriptor {[[Value]]: Desc.[[Configurable]], [[Writable]]: true, [[Enumerable]]: true,
-      //    [[Configurable]]: true}, and false.
-      Object::DefineOwnProperty(vm_, obj, vm_->GetGlobalConstants()->HandledConfigurableString(),
-                                PropertyDescriptor{vm_, JSHandle<JSValue>{vm_, JSValue{GetConfigurable()}}, true, true, true}, false);
     }
     
+    // 5. Call the [[DefineOwnProperty]] internal method of obj with arguments "enumerable",
+    //    Property Descriptor {[[Value]]: Desc.[[Enumerable]], [[Writable]]: true, [[Enumerable]]: true,
+    //    [[Configurable]]: true}, and false.
+    Object::DefineOwnProperty(vm_, obj, vm_->GetGlobalConstants()->HandledEnumerableString(),
+                              PropertyDescriptor{vm_, JSHandle<JSValue>{vm_, JSValue{GetEnumerable()}}, true, true, true}, false);
+    
+    // 6. Call the [[DefineOwnProperty]] internal method of obj with arguments "configurable",
+    //    Property Descriptor {[[Value]]: Desc.[[Configurable]], [[Writable]]: true, [[Enumerable]]: true,
+    //    [[Configurable]]: true}, and false.
+    Object::DefineOwnProperty(vm_, obj, vm_->GetGlobalConstants()->HandledConfigurableString(),
+                              PropertyDescriptor{vm_, JSHandle<JSValue>{vm_, JSValue{GetConfigurable()}}, true, true, true}, false);
+    
     // 7. Return obj.
     return obj.As<JSValue>();
 }
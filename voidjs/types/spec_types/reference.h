@@ -1,6 +1,7 @@
 #ifndef VOIDJS_TYPES_SPEC_TYPES_REFERENCE_H
 #define VOIDJS_TYPES_SPEC_TYPES_REFERENCE_H
 
+#include <cstdint>
 #include <string_view>
 #include <variant>
 
@@ -15,6 +16,13 @@ class Reference {
   Reference(JSHandle<JSValue>base, JSHandle<String> name, bool is_strict)
     : base_(base), name_(name), is_strict_(is_strict)
   {}
+
+  // A Reference to a local kept in a slot of the running frame, see ast::Identifier::GetSlot.
+  // It stands for a binding of the function's own Declarative Environment Record,
+  // which is never created. Its base is the slot and it has no name.
+  Reference(JSValue* slot, bool is_strict)
+    : base_(reinterpret_cast<std::uintptr_t>(slot)), is_strict_(is_strict), is_slot_(true)
+  {}
   
   // GetBase
   // Returns the base value component of the reference V.
@@ -28,6 +36,8 @@ class Reference {
   // Returns the strict reference component of the reference V.
   bool IsStrictReference() const { return is_strict_; }
 
+  bool IsSlotReference() const { return is_slot_; }
+
   // HasPrimitiveBase
   // Returns true if the base value is a Boolean, String, or Number.
   bool HasPrimitiveBase() const {
@@ -38,19 +48,20 @@ class Reference {
   // Returns true if either the base value is an object
   // or HasPrimitiveBase(V) is true; otherwise returns false.
   bool IsPropertyReference() const {
-    return base_->IsObject() && !base_->GetHeapObject()->IsEnvironmentRecord() || HasPrimitiveBase();
+    return !is_slot_ && (base_->IsObject() && !base_->GetHeapObject()->IsEnvironmentRecord() || HasPrimitiveBase());
   }
 
   // IsUnresolvableReference
   // Returns true if the base value is undefined and false otherwise.
   bool IsUnresolvableReference() const {
-    return base_->IsUndefined();
+    return !is_slot_ && base_->IsUndefined();
   }
 
  private:
   JSHandle<JSValue> base_;
   JSHandle<String> name_;
   bool is_strict_ {};
+  bool is_slot_ {};
 };
 
 }  // namespace types
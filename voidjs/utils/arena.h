@@ -0,0 +1,112 @@
+#ifndef VOIDJS_UTILS_ARENA_H
+#define VOIDJS_UTILS_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace voidjs {
+namespace utils {
+
+// Arena is a bump allocator made of a list of chunks.
+// Objects allocated in it are never destructed one by one,
+// all of the memory is released at once when the Arena is destroyed,
+// so only objects which own nothing outside the Arena should live here.
+class Arena {
+ public:
+  static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+  static constexpr std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+  Arena() = default;
+  ~Arena() = default;
+
+  // Non-Copyable
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  void* Allocate(std::size_t size) {
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (size > static_cast<std::size_t>(end_ - ptr_)) {
+      // Large allocations get a chunk of their own,
+      // so that the rest of the current chunk is not wasted.
+      if (size > CHUNK_SIZE / 4) {
+        return NewChunk(size);
+      }
+      ptr_ = NewChunk(CHUNK_SIZE);
+      end_ = ptr_ + CHUNK_SIZE;
+    }
+    auto ret = ptr_;
+    ptr_ += size;
+    return ret;
+  }
+
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    return new (Allocate(sizeof(T))) T(std::forward<Args>(args)...);
+  }
+
+  std::u16string_view NewString(std::u16string_view str) {
+    if (str.empty()) {
+      return {};
+    }
+    auto data = static_cast<char16_t*>(Allocate(str.size() * sizeof(char16_t)));
+    std::memcpy(data, str.data(), str.size() * sizeof(char16_t));
+    return {data, str.size()};
+  }
+
+  std::size_t GetAllocatedSize() const { return allocated_size_; }
+
+ private:
+  std::byte* NewChunk(std::size_t size) {
+    chunks_.emplace_back(new std::byte[size]);
+    allocated_size_ += size;
+    return chunks_.back().get();
+  }
+
+ private:
+  std::vector<std::unique_ptr<std::byte[]>> chunks_;
+  std::byte* ptr_ {nullptr};
+  std::byte* end_ {nullptr};
+  std::size_t allocated_size_ {0};
+};
+
+// ArenaAllocator lets standard containers take their storage from an Arena,
+// deallocate does nothing since the storage goes away with the Arena.
+// A container moved into another one keeps its storage and its Arena.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+
+  ArenaAllocator(Arena* arena) : arena_(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.GetArena()) {}
+
+  T* allocate(std::size_t n) { return static_cast<T*>(arena_->Allocate(n * sizeof(T))); }
+  void deallocate(T*, std::size_t) {}
+
+  Arena* GetArena() const { return arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const { return arena_ == other.GetArena(); }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const { return arena_ != other.GetArena(); }
+
+ private:
+  Arena* arena_;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}  // namespace utils
+}  // namespace voidjs
+
+#endif  // VOIDJS_UTILS_ARENA_H
@@ -4,30 +4,31 @@
 #include <cstdint>
 #include <limits>
 #include <string>
-#include <codecvt>
-#include <locale>
+#include <string_view>
 #include <cmath>
 #include <type_traits>
 #include <vector>
 #include <cstring>
 #include <iostream>
 #include <bitset>
+#include <array>
 
 #include "voidjs/lexer/character.h"
+#include "voidjs/utils/unicode.h"
 
 namespace voidjs {
 namespace utils {
 
-// This code comes from https://github.com/zhuzilin/es/blob/main/es/utils/helper.h
-inline std::u16string U8StrToU16Str(std::string u8str) {
-  static std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
-  return convert.from_bytes(u8str);
+inline std::u16string U8StrToU16Str(std::string_view u8str) {
+  std::u16string u16str(u8str.size(), u'\0');
+  u16str.resize(Utf8ToUtf16(u8str, u16str.data()));
+  return u16str;
 }
 
-// This code comes from https://github.com/zhuzilin/es/blob/main/es.cc
-inline std::string U16StrToU8Str(std::u16string u16str) {
-  static std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
-  return convert.to_bytes(u16str);
+inline std::string U16StrToU8Str(std::u16string_view u16str) {
+  std::string u8str(3 * u16str.size(), '\0');
+  u8str.resize(Utf16ToUtf8(u16str, u8str.data()));
+  return u8str;
 }
 
 
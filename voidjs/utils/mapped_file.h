@@ -0,0 +1,62 @@
+#ifndef VOIDJS_UTILS_MAPPED_FILE_H
+#define VOIDJS_UTILS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace voidjs {
+namespace utils {
+
+// MappedFile maps a whole file read-only into memory,
+// the mapping is released when the MappedFile is destroyed.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        data_ = static_cast<const std::uint8_t*>(data);
+        size_ = st.st_size;
+      }
+    }
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+  }
+
+  ~MappedFile() {
+    if (data_) {
+      ::munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+  }
+
+  // Non-Copyable
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Missing or empty files are not mapped
+  bool IsMapped() const { return data_ != nullptr; }
+
+  const std::uint8_t* GetData() const { return data_; }
+  std::size_t GetSize() const { return size_; }
+
+ private:
+  const std::uint8_t* data_ {nullptr};
+  std::size_t size_ {0};
+};
+
+}  // namespace utils
+}  // namespace voidjs
+
+#endif  // VOIDJS_UTILS_MAPPED_FILE_H
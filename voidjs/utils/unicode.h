@@ -0,0 +1,188 @@
+#ifndef VOIDJS_UTILS_UNICODE_H
+#define VOIDJS_UTILS_UNICODE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace voidjs {
+namespace utils {
+
+// Transcoding between UTF-8 and UTF-16
+// Runs of ASCII are converted 16 bytes (or 8 code units) at a time with SSE2,
+// everything else goes through the scalar decoder and encoder below.
+// Ill-formed input is never rejected: each maximal ill-formed subpart of UTF-8
+// and each lone surrogate of UTF-16 becomes U+FFFD.
+
+constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+namespace detail {
+
+// Decodes the sequence starting at src[pos], returns the number of bytes it takes.
+// The bounds of the second byte follow Table 3-7 of The Unicode Standard,
+// which rules out overlong forms, surrogates and code points above U+10FFFF.
+inline std::size_t DecodeUtf8(const unsigned char* src, std::size_t size, std::size_t pos, char32_t* code_point) {
+  unsigned char ch = src[pos];
+  std::size_t len = 0;
+  char32_t cp = 0;
+  unsigned char lo = 0x80;
+  unsigned char hi = 0xBF;
+  if (ch < 0x80) {
+    *code_point = ch;
+    return 1;
+  } else if (ch >= 0xC2 && ch <= 0xDF) {
+    len = 2;
+    cp = ch & 0x1F;
+  } else if (ch >= 0xE0 && ch <= 0xEF) {
+    len = 3;
+    cp = ch & 0x0F;
+    if (ch == 0xE0) {
+      lo = 0xA0;
+    } else if (ch == 0xED) {
+      hi = 0x9F;
+    }
+  } else if (ch >= 0xF0 && ch <= 0xF4) {
+    len = 4;
+    cp = ch & 0x07;
+    if (ch == 0xF0) {
+      lo = 0x90;
+    } else if (ch == 0xF4) {
+      hi = 0x8F;
+    }
+  } else {
+    *code_point = REPLACEMENT_CHARACTER;
+    return 1;
+  }
+
+  for (std::size_t idx = 1; idx < len; ++idx) {
+    if (pos + idx >= size || src[pos + idx] < lo || src[pos + idx] > hi) {
+      *code_point = REPLACEMENT_CHARACTER;
+      return idx;
+    }
+    cp = (cp << 6) | (src[pos + idx] & 0x3F);
+    lo = 0x80;
+    hi = 0xBF;
+  }
+  *code_point = cp;
+  return len;
+}
+
+inline std::size_t EncodeUtf16(char32_t code_point, char16_t* dst) {
+  if (code_point < 0x10000) {
+    dst[0] = static_cast<char16_t>(code_point);
+    return 1;
+  }
+  code_point -= 0x10000;
+  dst[0] = static_cast<char16_t>(0xD800 + (code_point >> 10));
+  dst[1] = static_cast<char16_t>(0xDC00 + (code_point & 0x3FF));
+  return 2;
+}
+
+inline std::size_t EncodeUtf8(char32_t code_point, char* dst) {
+  if (code_point < 0x80) {
+    dst[0] = static_cast<char>(code_point);
+    return 1;
+  } else if (code_point < 0x800) {
+    dst[0] = static_cast<char>(0xC0 | (code_point >> 6));
+    dst[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return 2;
+  } else if (code_point < 0x10000) {
+    dst[0] = static_cast<char>(0xE0 | (code_point >> 12));
+    dst[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    dst[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return 3;
+  } else {
+    dst[0] = static_cast<char>(0xF0 | (code_point >> 18));
+    dst[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    dst[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    dst[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return 4;
+  }
+}
+
+}  // namespace detail
+
+// dst must have room for src.size() code units,
+// returns the number of code units written.
+inline std::size_t Utf8ToUtf16(std::string_view src, char16_t* dst) {
+  auto bytes = reinterpret_cast<const unsigned char*>(src.data());
+  std::size_t size = src.size();
+  std::size_t pos = 0;
+  std::size_t len = 0;
+  while (pos < size) {
+#if defined(__SSE2__)
+    if (pos + 16 <= size) {
+      auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + pos));
+      std::uint32_t mask = _mm_movemask_epi8(chunk);
+      if (!mask) {
+        auto zero = _mm_setzero_si128();
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + len), _mm_unpacklo_epi8(chunk, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + len + 8), _mm_unpackhi_epi8(chunk, zero));
+        pos += 16;
+        len += 16;
+        continue;
+      }
+      // Copy the ASCII before the first non-ASCII byte
+      for (std::size_t end = pos + __builtin_ctz(mask); pos < end; ++pos) {
+        dst[len++] = bytes[pos];
+      }
+    }
+#endif
+    // Stay on the scalar path for the whole run of non-ASCII characters
+    do {
+      char32_t code_point;
+      pos += detail::DecodeUtf8(bytes, size, pos, &code_point);
+      len += detail::EncodeUtf16(code_point, dst + len);
+    } while (pos < size && bytes[pos] >= 0x80);
+  }
+  return len;
+}
+
+// dst must have room for 3 * src.size() bytes,
+// returns the number of bytes written.
+inline std::size_t Utf16ToUtf8(std::u16string_view src, char* dst) {
+  std::size_t size = src.size();
+  std::size_t pos = 0;
+  std::size_t len = 0;
+  while (pos < size) {
+#if defined(__SSE2__)
+    if (pos + 8 <= size) {
+      auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data() + pos));
+      auto non_ascii = _mm_and_si128(chunk, _mm_set1_epi16(static_cast<short>(0xFF80)));
+      std::uint32_t mask = ~_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, _mm_setzero_si128())) & 0xFFFF;
+      if (!mask) {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + len), _mm_packus_epi16(chunk, chunk));
+        pos += 8;
+        len += 8;
+        continue;
+      }
+      // Copy the ASCII before the first non-ASCII code unit
+      for (std::size_t end = pos + (__builtin_ctz(mask) >> 1); pos < end; ++pos) {
+        dst[len++] = static_cast<char>(src[pos]);
+      }
+    }
+#endif
+    // Stay on the scalar path for the whole run of non-ASCII characters
+    do {
+      char32_t code_point = src[pos++];
+      if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+        if (code_point <= 0xDBFF && pos < size && src[pos] >= 0xDC00 && src[pos] <= 0xDFFF) {
+          code_point = 0x10000 + ((code_point - 0xD800) << 10) + (src[pos++] - 0xDC00);
+        } else {
+          code_point = REPLACEMENT_CHARACTER;
+        }
+      }
+      len += detail::EncodeUtf8(code_point, dst + len);
+    } while (pos < size && src[pos] >= 0x80);
+  }
+  return len;
+}
+
+}  // namespace utils
+}  // namespace voidjs
+
+#endif  // VOIDJS_UTILS_UNICODE_H
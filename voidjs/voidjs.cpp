@@ -1,13 +1,16 @@
+#include <cstdlib>
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <functional>
 #include <map>
+#include <memory>
+#include <string_view>
 
 #include "voidjs/ir/ast.h"
 #include "voidjs/ir/program.h"
 #include "voidjs/ir/dumper.h"
 #include "voidjs/parser/parser.h"
+#include "voidjs/parser/code_cache.h"
+#include "voidjs/parser/streaming_parser.h"
 #include "voidjs/types/heap_object.h"
 #include "voidjs/types/js_value.h"
 #include "voidjs/types/object_factory.h"
@@ -15,50 +18,113 @@
 #include "voidjs/gc/js_handle.h"
 #include "voidjs/gc/js_handle_scope.h"
 #include "voidjs/interpreter/interpreter.h"
+#include "voidjs/interpreter/snapshot.h"
 #include "voidjs/interpreter/vm.h"
 #include "voidjs/utils/helper.h"
+#include "voidjs/utils/mapped_file.h"
 
-std::string ReadFile(char* filename) {
-  std::ifstream file{filename};
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-  std::string file_content = buffer.str();
-  return file_content;
+// The mapping is read in place, a missing or empty file reads as an empty source
+std::string_view GetSource(const voidjs::utils::MappedFile& file) {
+  if (!file.IsMapped()) {
+    return {};
+  }
+  return {reinterpret_cast<const char*>(file.GetData()), file.GetSize()};
+}
+
+// With a snapshot file, the builtin objects are restored from there,
+// or the file is written for the next run if it is missing or stale.
+std::unique_ptr<voidjs::Interpreter> NewInterpreter(const std::string& snapshot_path) {
+  using namespace voidjs;
+
+  if (snapshot_path.empty()) {
+    return std::make_unique<Interpreter>();
+  }
+  if (auto snapshot = Snapshot::Load(snapshot_path)) {
+    return std::make_unique<Interpreter>(*snapshot);
+  }
+  auto snapshot = Snapshot::Create();
+  snapshot.Store(snapshot_path);
+  return std::make_unique<Interpreter>(snapshot);
+}
+
+void PrintException(voidjs::VM* vm) {
+  using namespace voidjs;
+
+  if (vm->HasException()) {
+    JSHandle<types::String> msg = types::Object::Call(vm, vm->GetObjectFactory()->NewInternalFunction(voidjs::builtins::JSError::ToString),
+                                                      vm->GetException().As<voidjs::JSValue>(), {}).As<types::String>();
+    std::cout << utils::U16StrToU8Str(msg->GetString()) << std::endl;
+  }
 }
 
-void ExecuteFile(char* filename) {
+// With streaming, top level statements are executed chunk by chunk as they are parsed,
+// which keeps only the AST of the current chunk in memory.
+// Otherwise, with a code cache directory, the parsed Program is loaded from there when the
+// source has been seen before, and stored there otherwise.
+void ExecuteFile(char* filename, const std::string& code_cache_dir, const std::string& snapshot_path, bool stream,
+                 std::size_t parse_threads) {
   using namespace voidjs;
   
-  std::u16string source = voidjs::utils::U8StrToU16Str(ReadFile(filename));
+  utils::MappedFile file{filename};
+  std::string_view source = GetSource(file);
+
+  if (stream) {
+    StreamingParser parser{source};
+    // An invalid Program is left to Parser below, which reports the error
+    if (parser.ScanDeclarations()) {
+      auto interpreter = NewInterpreter(snapshot_path);
+      VM* vm = interpreter->GetVM();
+      JSHandleScope top_handle_scope{vm};
+
+      interpreter->ExecuteStreaming(&parser);
+      PrintException(vm);
+      return ;
+    }
+  }
 
-  Parser parser{source};
-  ast::Program* program = parser.ParseProgram();
+  std::unique_ptr<ast::Program> program;
+  if (!code_cache_dir.empty()) {
+    CodeCache code_cache{code_cache_dir};
+    program.reset(code_cache.Load(source));
+    if (!program) {
+      // Parsed eagerly so that a cached Program never needs the Parser again
+      Parser parser{source};
+      program.reset(parser.ParseProgram());
+      if (program) {
+        code_cache.Store(source, program.get());
+      }
+    }
+  } else {
+    // Functions are only parsed when they are called,
+    // unless they are parsed ahead on several threads
+    Parser parser{source, true};
+    program.reset(parser.ParseProgram());
+    if (program && parse_threads > 1) {
+      parser.ParseLazyFunctions(program.get(), parse_threads);
+    }
+  }
   if (!program) {
     return ;
   }
   
-  Interpreter interpreter;
-  VM* vm = interpreter.GetVM();
+  auto interpreter = NewInterpreter(snapshot_path);
+  VM* vm = interpreter->GetVM();
   JSHandleScope top_handle_scope{vm};
 
-  types::Completion comp = interpreter.Execute(program);
-  if (vm->HasException()) {
-    JSHandle<types::String> msg = types::Object::Call(vm, vm->GetObjectFactory()->NewInternalFunction(voidjs::builtins::JSError::ToString),
-                                                      vm->GetException().As<voidjs::JSValue>(), {}).As<types::String>();
-    std::cout << utils::U16StrToU8Str(std::u16string{msg->GetString()}) << std::endl;
-  }
+  interpreter->Execute(program.get());
+  PrintException(vm);
 }
 
 void DumpAst(char* filename) {
-  std::u16string source = voidjs::utils::U8StrToU16Str(ReadFile(filename));
+  voidjs::utils::MappedFile file{filename};
 
-  voidjs::Parser parser{source};
-  voidjs::ast::Program* program = parser.ParseProgram();
+  voidjs::Parser parser{GetSource(file)};
+  std::unique_ptr<voidjs::ast::Program> program {parser.ParseProgram()};
   if (!program) {
     return ;
   }
 
-  voidjs::ast::Dumper dumper{program};
+  voidjs::ast::Dumper dumper{program.get()};
   std::cout << dumper.GetString() << std::endl;
 }
 
@@ -73,6 +139,10 @@ void ParseCommandAndExecute(int argc, char* argv[]) {
   };
 
   char* filename = argv[argc - 1];
+  std::string code_cache_dir;
+  std::string snapshot_path;
+  bool stream = false;
+  std::size_t parse_threads = 0;
 
   for (int i = 1; i + 1 < argc; ++i) {
     std::size_t len = std::strlen(argv[i]);
@@ -80,6 +150,33 @@ void ParseCommandAndExecute(int argc, char* argv[]) {
       continue;
     }
 
+    // --code-cache=<dir>
+    constexpr std::string_view code_cache_option = "--code-cache=";
+    if (std::string_view{argv[i]}.substr(0, code_cache_option.size()) == code_cache_option) {
+      code_cache_dir = argv[i] + code_cache_option.size();
+      continue;
+    }
+
+    // --snapshot=<file>
+    constexpr std::string_view snapshot_option = "--snapshot=";
+    if (std::string_view{argv[i]}.substr(0, snapshot_option.size()) == snapshot_option) {
+      snapshot_path = argv[i] + snapshot_option.size();
+      continue;
+    }
+
+    // --parse-threads=<n>
+    constexpr std::string_view parse_threads_option = "--parse-threads=";
+    if (std::string_view{argv[i]}.substr(0, parse_threads_option.size()) == parse_threads_option) {
+      parse_threads = std::strtoul(argv[i] + parse_threads_option.size(), nullptr, 10);
+      continue;
+    }
+
+    // --stream
+    if (std::string_view{argv[i]} == "--stream") {
+      stream = true;
+      continue;
+    }
+
     if (auto iter = commands.find(std::string{argv[i] + 2, len - 2});
         iter != commands.end()) {
       (iter->second)(filename);
@@ -87,7 +184,7 @@ void ParseCommandAndExecute(int argc, char* argv[]) {
     }
   }
 
-  ExecuteFile(filename);
+  ExecuteFile(filename, code_cache_dir, snapshot_path, stream, parse_threads);
 }
 
 int main(int argc, char* argv[]) {